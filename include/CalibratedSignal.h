@@ -0,0 +1,80 @@
+#pragma once
+#include <functional>
+#include <utility>
+
+#include "Signal.h"
+
+namespace dsp
+{
+	/// @brief Linear calibration y = gain * x + offset (e.g., to convert ADC counts or normalized samples to Pascal)
+	/// @tparam T Data type of the samples
+	template<class T>
+	struct LinearCalibration
+	{
+		T gain{ 1 };  //!< Factor applied to every sample
+		T offset{ 0 };  //!< Value added after scaling
+
+		T operator()(const T& x) const { return gain * x + offset; }
+	};
+
+	/// @brief Read-only adaptor that applies a calibration to the samples of a Signal on access.
+	///
+	/// Signal has no virtual functions, so that element access stays fast for the common, uncalibrated case. Code that
+	/// needs calibrated values wraps the signal in this adaptor instead of deriving from Signal. The adaptor only refers
+	/// to the signal, which must outlive it.
+	/// @tparam T Data type of the samples
+	/// @tparam Calibration Callable mapping a raw sample to the calibrated value. A concrete functor type (such as
+	/// LinearCalibration) is inlined; the default std::function accepts any callable at the cost of an indirect call.
+	template<class T, class Calibration = std::function<T(const T&)>>
+	class CalibratedSignal
+	{
+	public:
+		using value_type = T;
+		using size_type = typename Signal<T>::size_type;
+
+		CalibratedSignal(const Signal<T>& signal, Calibration calibration)
+			: signal_(&signal), calibration_(std::move(calibration)) {}
+
+		/// @brief Returns the calibrated sample at position pos
+		value_type getValue(size_type pos) const { return calibration_((*signal_)[pos]); }
+
+		/// @brief Returns the calibrated sample at position pos
+		value_type operator[](size_type pos) const { return getValue(pos); }
+
+		/// @brief Returns the calibrated sample at position pos with bounds checking
+		value_type at(size_type pos) const { return calibration_(signal_->at(pos)); }
+
+		size_type size() const { return signal_->size(); }
+		bool empty() const { return signal_->empty(); }
+		unsigned getSamplingRate_Hz() const { return signal_->getSamplingRate_Hz(); }
+
+		/// @brief Returns the underlying, uncalibrated signal
+		const Signal<T>& getSignal() const { return *signal_; }
+
+		/// @brief Returns the calibration
+		const Calibration& getCalibration() const { return calibration_; }
+
+		/// @brief Returns a new signal holding all calibrated samples
+		Signal<T> calibrated() const
+		{
+			Signal<T> result(signal_->getSamplingRate_Hz());
+			result.reserve(signal_->size());
+			for (const auto& x : *signal_)
+			{
+				result.push_back(calibration_(x));
+			}
+			return result;
+		}
+
+	private:
+		const Signal<T>* signal_;
+		Calibration calibration_;
+	};
+
+	/// @brief Wraps a signal in a CalibratedSignal with the given calibration
+	template<class T, class Calibration>
+	CalibratedSignal<T, Calibration> calibrate(const Signal<T>& signal, Calibration calibration)
+	{
+		return CalibratedSignal<T, Calibration>(signal, std::move(calibration));
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "allocators.h"
+#include "Signal.h"
+#include "SignalView.h"
+#include "threadpool.h"
+
+namespace dsp
+{
+	/// @brief Memory layout of the samples of a MultiSignal
+	enum class ChannelLayout
+	{
+		planar,  //!< All samples of channel 0, then all samples of channel 1, ...
+		interleaved  //!< All channels of frame 0, then all channels of frame 1, ... (as in most audio files and devices)
+	};
+
+	/// @brief Signal with several channels of equal length in one contiguous, aligned buffer.
+	///
+	/// Unlike a vector of Signals, all channels share a single allocation, and the samples of one frame (one sample
+	/// per channel) can be processed together. Channels and frames are accessed through cheap, non-owning views. The
+	/// FFT, filter, and stats modules accept a MultiSignal and process its channels in parallel (see mapChannels()).
+	///
+	///		dsp::MultiSignal<float> array(48000, 32, 4800);  // 32 channels of 100 ms each
+	///		auto spectra = dsp::fft::rfft(array);  // One spectrum per channel
+	/// @tparam T Data type of the samples
+	template<class T>
+	class MultiSignal
+	{
+	public:
+		using value_type = T;
+		using size_type = size_t;
+
+		MultiSignal() = default;
+
+		/// @brief Creates numChannels channels of numFrames zeros each
+		MultiSignal(unsigned samplingRate_Hz, unsigned numChannels, size_t numFrames,
+			ChannelLayout layout = ChannelLayout::planar);
+
+		/// @brief Copies the samples of several channels of equal length
+		MultiSignal(unsigned samplingRate_Hz, const std::vector<std::vector<T>>& channels,
+			ChannelLayout layout = ChannelLayout::planar);
+
+		unsigned getSamplingRate_Hz() const { return samplingRate_Hz_; }
+		void setSamplingRate_Hz(unsigned newSamplingRate_Hz) { samplingRate_Hz_ = newSamplingRate_Hz; }
+
+		unsigned numChannels() const { return numChannels_; }
+		size_t numFrames() const { return numFrames_; }
+
+		/// @brief Returns the total number of samples (numChannels() * numFrames())
+		size_t size() const { return samples_.size(); }
+		bool empty() const { return samples_.empty(); }
+
+		ChannelLayout layout() const { return layout_; }
+
+		/// @brief Rearranges the samples into the new layout (vectorized for float and double)
+		void setLayout(ChannelLayout newLayout);
+
+		/// @brief Overwrites all samples with numChannels() * numFrames() samples in the given layout, converting them if necessary
+		void assign(const T* samples, ChannelLayout samplesLayout);
+
+		T* data() { return samples_.data(); }
+		const T* data() const { return samples_.data(); }
+
+		/// @brief Distance between two consecutive samples of one channel
+		std::ptrdiff_t sampleStride() const { return layout_ == ChannelLayout::planar ? 1 : static_cast<std::ptrdiff_t>(numChannels_); }
+
+		/// @brief Distance between the same sample of two neighboring channels
+		std::ptrdiff_t channelStride() const { return layout_ == ChannelLayout::planar ? static_cast<std::ptrdiff_t>(numFrames_) : 1; }
+
+		T& operator()(unsigned channel, size_t frame) { return samples_[index(channel, frame)]; }
+		const T& operator()(unsigned channel, size_t frame) const { return samples_[index(channel, frame)]; }
+
+		/// @brief Returns a view of one channel (contiguous in the planar layout)
+		SignalView<T> channel(unsigned channel) const
+		{
+			return { samples_.data() + channel * channelStride(), numFrames_, sampleStride(), samplingRate_Hz_ };
+		}
+
+		/// @brief Returns a view of the samples of all channels at one point in time (contiguous in the interleaved layout)
+		SignalView<T> frame(size_t frame) const
+		{
+			return { samples_.data() + frame * sampleStride(), numChannels_, channelStride(), 0 };
+		}
+
+		/// @brief Returns a copy of one channel
+		Signal<T> getChannel(unsigned channel) const;
+
+		/// @brief Overwrites one channel with numFrames() samples
+		void setChannel(unsigned channel, SignalView<T> samples);
+
+		/// @brief Applies a function to the view of each channel in parallel and returns the results in channel order.
+		///
+		/// This is the single place where channel-parallel processing is implemented; the FFT, filter, and stats
+		/// overloads for MultiSignal are built on it. f must be safe to call concurrently.
+		/// @param pool Pool that processes the channels
+		template<class Function>
+		auto mapChannels(Function f, ThreadPool& pool = ThreadPool::global()) const
+		{
+			using Result = std::decay_t<std::invoke_result_t<Function&, SignalView<T>>>;
+			std::vector<Result> results(numChannels_);
+			pool.parallelFor(numChannels_, [&](size_t c) { results[c] = f(channel(static_cast<unsigned>(c))); });
+			return results;
+		}
+
+	private:
+		size_t index(unsigned channel, size_t frame) const
+		{
+			return channel * channelStride() + frame * sampleStride();
+		}
+
+		unsigned samplingRate_Hz_{ 0 };
+		unsigned numChannels_{ 0 };
+		size_t numFrames_{ 0 };
+		ChannelLayout layout_{ ChannelLayout::planar };
+		AlignedVector<T> samples_;
+	};
+}
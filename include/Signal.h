@@ -2,41 +2,72 @@
 #include <algorithm>
 #include <complex>
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
 
+#include "execution.h"
+
 namespace dsp
 {
+	namespace expr
+	{
+		template<class E>
+		struct Expression;
+	}
+
 	/// @brief This class represents a scalar signal.
 	///
 	/// It is implemented as a facade design pattern wrapped around an STL vector.
 
 	/// Fun fact: It is not derived from std::vector because that class does not have a virtual destructor, potentially producing memory leaks.
+	/// For the same reason, Signal itself is final and has no virtual functions: element access is inlined and indexed
+	/// loops vectorize like loops over raw pointers. Calibrated access is provided by the CalibratedSignal adaptor instead.
 	/// @tparam T Data type of the samples in the signal. Can be any numeric type, but mind that the arithmetic is at the same precision (which might lead to unexpected results with integer types).
-	template <class T>
-	class Signal
+	/// @tparam Allocator Allocator of the sample storage (e.g., AlignedAllocator or PoolAllocator from allocators.h)
+	template <class T, class Allocator = std::allocator<T>>
+	class Signal final
 	{
 	public:
+		/// @brief Type of the underlying sample storage
+		using container_type = std::vector<T, Allocator>;
+
 		Signal() = default;
 		Signal(const Signal& other);
 		Signal(Signal&& other) noexcept;
 		explicit Signal(unsigned samplingRate_Hz);
-		explicit Signal(const std::vector<T>& samples);
-		explicit Signal(unsigned samplingRate_Hz, const std::vector<T>& samples);
-		virtual ~Signal() = default;
+		explicit Signal(unsigned samplingRate_Hz, const Allocator& allocator);
+		explicit Signal(const container_type& samples);
+		explicit Signal(unsigned samplingRate_Hz, const container_type& samples);
+		/// @brief Takes over the samples without copying them
+		explicit Signal(container_type&& samples) noexcept;
+		/// @brief Takes over the samples without copying them
+		explicit Signal(unsigned samplingRate_Hz, container_type&& samples) noexcept;
+		/// @brief Copies samples that are stored with a different allocator
+		template<class OtherAllocator, std::enable_if_t<!std::is_same_v<OtherAllocator, Allocator>, int> = 0>
+		explicit Signal(unsigned samplingRate_Hz, const std::vector<T, OtherAllocator>& samples)
+			: samplingRate_Hz_(samplingRate_Hz), samples_(samples.begin(), samples.end()) {}
+		/// @brief Evaluates a lazy expression (see expression.h) in a single pass
+		template<class E>
+		Signal(const expr::Expression<E>& expression);
+		~Signal() = default;
 
 		// Getter
-		const std::vector<T>& getSamples() const;
-		std::vector<T>& getSamples();
+		const container_type& getSamples() const&;
+		container_type& getSamples() &;
+		/// @brief Moves the samples out of a temporary signal (e.g., dsp::signals::sin<double>(...).getSamples())
+		container_type getSamples() &&;
 		auto real() const;
 		auto imag() const;
 		unsigned getSamplingRate_Hz() const;
 		unsigned& getSamplingRate_Hz();
 
 		// Setter
-		void setSamples(const std::vector<T>& samples);
+		void setSamples(const container_type& samples);
+		/// @brief Takes over the samples without copying them
+		void setSamples(container_type&& samples);
 		void setSamplingRate_Hz(unsigned newSamplingRate_Hz);
 
 		// Stream output		
@@ -53,37 +84,37 @@ namespace dsp
 		/*
 		 * Facade types
 		*/
-		using value_type = typename std::vector<T>::value_type;
-		using allocator_type = typename std::vector<T>::allocator_type;
-		using size_type = typename std::vector<T>::size_type;
-		using difference_type = typename std::vector<T>::difference_type;
-		using reference = typename std::vector<T>::reference;
-		using const_reference = typename std::vector<T>::const_reference;
-		using pointer = typename std::vector<T>::pointer;
-		using const_pointer = typename std::vector<T>::const_pointer;
-		using iterator = typename std::vector<T>::iterator;
-		using const_iterator = typename std::vector<T>::const_iterator;
-		using reverse_iterator = typename std::vector<T>::reverse_iterator;
-		using const_reverse_iterator = typename std::vector<T>::const_reverse_iterator;
+		using value_type = typename container_type::value_type;
+		using allocator_type = typename container_type::allocator_type;
+		using size_type = typename container_type::size_type;
+		using difference_type = typename container_type::difference_type;
+		using reference = typename container_type::reference;
+		using const_reference = typename container_type::const_reference;
+		using pointer = typename container_type::pointer;
+		using const_pointer = typename container_type::const_pointer;
+		using iterator = typename container_type::iterator;
+		using const_iterator = typename container_type::const_iterator;
+		using reverse_iterator = typename container_type::reverse_iterator;
+		using const_reverse_iterator = typename container_type::const_reverse_iterator;
 
 		/*
 		 * Arithmetic operations
 		 */
-		Signal<T>& operator+=(const Signal<T>& rhs);
-		Signal<T>& operator+=(const std::vector<T>& vec);
-		Signal<T>& operator+=(const_reference value);
+		Signal& operator+=(const Signal& rhs);
+		Signal& operator+=(const container_type& vec);
+		Signal& operator+=(const_reference value);
 
-		Signal<T>& operator-=(const Signal<T>& rhs);
-		Signal<T>& operator-=(const std::vector<T>& vec);
-		Signal<T>& operator-=(const_reference value);
+		Signal& operator-=(const Signal& rhs);
+		Signal& operator-=(const container_type& vec);
+		Signal& operator-=(const_reference value);
 
-		Signal<T>& operator*=(const Signal<T>& rhs);
-		Signal<T>& operator*=(const std::vector<T>& vec);
-		Signal<T>& operator*=(const_reference value);
+		Signal& operator*=(const Signal& rhs);
+		Signal& operator*=(const container_type& vec);
+		Signal& operator*=(const_reference value);
 
-		Signal<T>& operator/=(const Signal<T>& rhs);
-		Signal<T>& operator/=(const std::vector<T>& vec);
-		Signal<T>& operator/=(const_reference value);
+		Signal& operator/=(const Signal& rhs);
+		Signal& operator/=(const container_type& vec);
+		Signal& operator/=(const_reference value);
 	private:
 		// Overloaded helper functions to allow both scalar types and vector types
 		template <class U>
@@ -125,36 +156,35 @@ namespace dsp
 		template< class InputIt >
 		void assign(InputIt first, InputIt last){ samples_.assign(first, last); }
 
-		// Element access
-		reference at(size_type pos);
-		const T& at(size_type pos) const;
+		// Element access (defined inline, so that indexed loops compile to plain pointer arithmetic)
+		reference at(size_type pos) { return samples_.at(pos); }
+		const T& at(size_type pos) const { return samples_.at(pos); }
 
-		// This method is provided to allow manipulations of the sample value before
-		// returning it (e.g. calibrating it) in derived classes
-		virtual value_type getValue(size_type pos) const;		
+		// Returns the sample value. Use CalibratedSignal to manipulate the value (e.g. calibrate it) before returning it.
+		value_type getValue(size_type pos) const { return samples_[pos]; }
 
-		reference front();
-		const T& front() const;
+		reference front() { return samples_.front(); }
+		const T& front() const { return samples_.front(); }
 
-		reference back();
-		const T& back() const;
+		reference back() { return samples_.back(); }
+		const T& back() const { return samples_.back(); }
 
-		T* data();
-		const T* data() const;
+		T* data() { return samples_.data(); }
+		const T* data() const { return samples_.data(); }
 
 		// Iterators
-		iterator begin();
-		const_iterator begin() const;
+		iterator begin() { return samples_.begin(); }
+		const_iterator begin() const { return samples_.begin(); }
 
-		iterator end();
-		const_iterator end() const;
+		iterator end() { return samples_.end(); }
+		const_iterator end() const { return samples_.end(); }
 
 		reverse_iterator rbegin();
 		const_reverse_iterator rbegin() const;
 
 		// Capacity
-		bool empty() const;
-		size_type size() const;
+		bool empty() const { return samples_.empty(); }
+		size_type size() const { return samples_.size(); }
 		size_type max_size() const;
 		void reserve(size_type new_cap);
 		size_type capacity() const;
@@ -192,13 +222,16 @@ namespace dsp
 		// Operators
 		Signal& operator=(const Signal& other);
 		Signal& operator=(Signal&& other) noexcept;
-		virtual reference operator[](size_type pos);
-		virtual const_reference operator[](size_type pos) const;
+		/// @brief Evaluates a lazy expression (see expression.h) in a single pass, reusing the current storage
+		template<class E>
+		Signal& operator=(const expr::Expression<E>& expression);
+		reference operator[](size_type pos) { return samples_[pos]; }
+		const_reference operator[](size_type pos) const { return samples_[pos]; }
 		// More operators are defined as non-member functions below		
 
-	protected:
+	private:
 		unsigned samplingRate_Hz_{ 0 };
-		std::vector<T> samples_;  //!< A vector holding the actual samples
+		container_type samples_;  //!< A vector holding the actual samples
 
 	private:
 		template <class U>
@@ -226,27 +259,31 @@ namespace dsp
 		static auto imag(const T& c);
 	};
 
-	template< class T>
-	bool operator==(const Signal<T>& lhs, const Signal<T>& rhs)
+	/// @brief Signal with samples of type U whose storage uses Allocator rebound to U
+	template<class U, class Allocator>
+	using rebind_signal = Signal<U, typename std::allocator_traits<Allocator>::template rebind_alloc<U>>;
+
+	template<class T, class Allocator>
+	bool operator==(const Signal<T, Allocator>& lhs, const Signal<T, Allocator>& rhs)
 	{
 		return (lhs.getSamplingRate_Hz() == rhs.getSamplingRate_Hz() && lhs.getSamples() == rhs.getSamples());
 	}
 
-	template< class T>
-	bool operator!=(const Signal<T>& lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	bool operator!=(const Signal<T, Allocator>& lhs, const Signal<T, Allocator>& rhs)
 	{
 		return !(lhs == rhs);
 	}
 
-	template< class T>
-	bool operator<(const Signal<T>& lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	bool operator<(const Signal<T, Allocator>& lhs, const Signal<T, Allocator>& rhs)
 	{
 		if (lhs.getSamplingRate_Hz() != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 		return lhs.getSamples() < rhs.getSamples();
 	}
 
-	template <class T>
-	bool operator<(const Signal<T>& lhs, const T& value)
+	template<class T, class Allocator>
+	bool operator<(const Signal<T, Allocator>& lhs, const T& value)
 	{
 		// Look for the first element that is greater than or equal to value
 		auto lb = std::lower_bound(lhs.begin(), lhs.end(), value);
@@ -254,15 +291,15 @@ namespace dsp
 		return lb == lhs.end();
 	}
 
-	template< class T>
-	bool operator<=(const Signal<T>& lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	bool operator<=(const Signal<T, Allocator>& lhs, const Signal<T, Allocator>& rhs)
 	{
 		if (lhs.getSamplingRate_Hz() != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 		return lhs.getSamples() <= rhs.getSamples();
 	}
 
-	template <class T>
-	bool operator<=(const Signal<T>& lhs, const T& value)
+	template<class T, class Allocator>
+	bool operator<=(const Signal<T, Allocator>& lhs, const T& value)
 	{
 		// Look for an element that is greater than value
 		auto it = std::upper_bound(lhs.begin(), lhs.end(), value);
@@ -270,15 +307,15 @@ namespace dsp
 		return it == lhs.end();
 	}
 
-	template< class T>
-	bool operator>(const Signal<T>& lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	bool operator>(const Signal<T, Allocator>& lhs, const Signal<T, Allocator>& rhs)
 	{
 		if (lhs.getSamplingRate_Hz() != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 		return lhs.getSamples() > rhs.getSamples();
 	}
 
-	template <class T>
-	bool operator>(const Signal<T>& lhs, const T& value)
+	template<class T, class Allocator>
+	bool operator>(const Signal<T, Allocator>& lhs, const T& value)
 	{
 		// Look for an element that is smaller than or equal to value
 		auto it = std::find_if(lhs.begin(), lhs.end(), [value](T x) {x <= value; });
@@ -286,15 +323,15 @@ namespace dsp
 		return it == lhs.end();
 	}
 
-	template< class T>
-	bool operator>=(const Signal<T>& lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	bool operator>=(const Signal<T, Allocator>& lhs, const Signal<T, Allocator>& rhs)
 	{
 		if (lhs.getSamplingRate_Hz() != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 		return lhs.getSamples() >= rhs.getSamples();
 	}
 
-	template <class T>
-	bool operator>=(const Signal<T>& lhs, const T& value)
+	template<class T, class Allocator>
+	bool operator>=(const Signal<T, Allocator>& lhs, const T& value)
 	{
 		// Look for an element that is smaller than value
 		auto it = std::find_if(lhs.begin(), lhs.end(), [value](T x) {x < value; });
@@ -302,88 +339,88 @@ namespace dsp
 		return it == lhs.end();
 	}
 
-	template< class T>
-	void swap(Signal<T>& lhs, Signal<T>& rhs) noexcept
+	template<class T, class Allocator>
+	void swap(Signal<T, Allocator>& lhs, Signal<T, Allocator>& rhs) noexcept
 	{
 		if (lhs.getSamplingRate_Hz() != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 		std::vector<T>::swap(lhs.samples_, rhs.samples);
 	}
 
 	// Symmetric arithmetic operators
-	template<class T>
-	Signal<T> operator+(Signal<T> lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator+(Signal<T, Allocator> lhs, const Signal<T, Allocator>& rhs)
 	{
 		lhs += rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator+(Signal<T> lhs, const std::vector<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator+(Signal<T, Allocator> lhs, const typename Signal<T, Allocator>::container_type& rhs)
 	{
 		lhs += rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator+(const std::vector<T>& lhs, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator+(const typename Signal<T, Allocator>::container_type& lhs, Signal<T, Allocator> rhs)
 	{
 		rhs += lhs;
 
 		return rhs;
 	}
 
-	template<class T>
-	Signal<T> operator+(Signal<T> lhs, typename Signal<T>::value_type value)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator+(Signal<T, Allocator> lhs, typename Signal<T, Allocator>::value_type value)
 	{
 		lhs += value;
 
 		return lhs;
 	}
 	
-	template<class T>
-	Signal<T> operator+(typename Signal<T>::value_type value, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator+(typename Signal<T, Allocator>::value_type value, Signal<T, Allocator> rhs)
 	{
 		rhs += value;
 
 		return rhs;
 	}
 
-	template<class T>
-	Signal<T> operator-(Signal<T> lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator-(Signal<T, Allocator> lhs, const Signal<T, Allocator>& rhs)
 	{
 		lhs -= rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator-(Signal<T> lhs, const std::vector<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator-(Signal<T, Allocator> lhs, const typename Signal<T, Allocator>::container_type& rhs)
 	{
 		lhs -= rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator-(const std::vector<T>& lhs, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator-(const typename Signal<T, Allocator>::container_type& lhs, Signal<T, Allocator> rhs)
 	{
 		std::transform(rhs.begin(), rhs.end(), lhs.begin(), rhs.begin(), std::minus<T>());
 
 		return rhs;
 	}
 
-	template<class T>
-	Signal<T> operator-(Signal<T> lhs, typename Signal<T>::value_type value)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator-(Signal<T, Allocator> lhs, typename Signal<T, Allocator>::value_type value)
 	{
 		lhs -= value;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator-(typename Signal<T>::value_type value, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator-(typename Signal<T, Allocator>::value_type value, Signal<T, Allocator> rhs)
 	{
 		std::transform(rhs.begin(), rhs.end(), rhs.begin(), 
 			[value](auto x)
@@ -394,80 +431,80 @@ namespace dsp
 		return rhs;
 	}
 
-	template<class T>
-	Signal<T> operator*(Signal<T> lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator*(Signal<T, Allocator> lhs, const Signal<T, Allocator>& rhs)
 	{
 		lhs *= rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator*(Signal<T> lhs, const std::vector<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator*(Signal<T, Allocator> lhs, const typename Signal<T, Allocator>::container_type& rhs)
 	{
 		lhs *= rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator*(const std::vector<T>& lhs, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator*(const typename Signal<T, Allocator>::container_type& lhs, Signal<T, Allocator> rhs)
 	{
 		rhs *= lhs;
 
 		return rhs;
 	}
 
-	template<class T>
-	Signal<T> operator*(Signal<T> lhs, typename Signal<T>::value_type value)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator*(Signal<T, Allocator> lhs, typename Signal<T, Allocator>::value_type value)
 	{
 		lhs *= value;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator*(typename Signal<T>::value_type value, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator*(typename Signal<T, Allocator>::value_type value, Signal<T, Allocator> rhs)
 	{
 		rhs *= value;
 
 		return rhs;
 	}
 
-	template<class T>
-	Signal<T> operator/(Signal<T> lhs, const Signal<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator/(Signal<T, Allocator> lhs, const Signal<T, Allocator>& rhs)
 	{
 		lhs /= rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator/(Signal<T> lhs, const std::vector<T>& rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator/(Signal<T, Allocator> lhs, const typename Signal<T, Allocator>::container_type& rhs)
 	{
 		lhs /= rhs;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator/(const std::vector<T>& lhs, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator/(const typename Signal<T, Allocator>::container_type& lhs, Signal<T, Allocator> rhs)
 	{
 		std::transform(rhs.begin(), rhs.end(), lhs.begin(), rhs.begin(), std::divides<T>());
 
 		return rhs;
 	}
 
-	template<class T>
-	Signal<T> operator/(Signal<T> lhs, typename Signal<T>::value_type value)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator/(Signal<T, Allocator> lhs, typename Signal<T, Allocator>::value_type value)
 	{
 		lhs /= value;
 
 		return lhs;
 	}
 
-	template<class T>
-	Signal<T> operator/(typename Signal<T>::value_type value, Signal<T> rhs)
+	template<class T, class Allocator>
+	Signal<T, Allocator> operator/(typename Signal<T, Allocator>::value_type value, Signal<T, Allocator> rhs)
 	{
 		std::transform(rhs.begin(), rhs.end(), rhs.begin(),
 			[value](auto x)
@@ -479,93 +516,88 @@ namespace dsp
 	}
 	
 	
-	template<class T>
-	auto pow(const Signal<T>& signal, int exponent)
+	template<class T, class Allocator>
+	auto pow(const Signal<T, Allocator>& signal, int exponent, const ExecutionContext& context = {})
 	{
-		Signal<T> powSignal(signal.getSamplingRate_Hz());
-		powSignal.reserve(signal.size());
-		
-		std::transform(signal.begin(), signal.end(), std::back_inserter(powSignal),
-			[exponent](auto s) {return std::pow(s, exponent); });
+		typename Signal<T, Allocator>::container_type powSamples(signal.size());
+		detail::transform(signal.begin(), signal.size(), powSamples.begin(),
+			[exponent](auto s) {return std::pow(s, exponent); }, context);
 
-		return powSignal;
+		return Signal<T, Allocator>(signal.getSamplingRate_Hz(), std::move(powSamples));
 	}
 	
 	template<class T>
-	auto pow(const std::vector<T>& vec, int exponent)
+	auto pow(const std::vector<T>& vec, int exponent, const ExecutionContext& context = {})
 	{
-		std::vector<T> powVec;
-		powVec.reserve(vec.size());
-
-		std::transform(vec.begin(), vec.end(), std::back_inserter(powVec),
-			[exponent](auto x) {return std::pow(x, exponent); });
+		std::vector<T> powVec(vec.size());
+		detail::transform(vec.begin(), vec.size(), powVec.begin(),
+			[exponent](auto x) {return std::pow(x, exponent); }, context);
 
 		return powVec;
 	}
 
 	
-	template<class T>
-	auto abs(const Signal<T>& signal)
+	template<class T, class Allocator>
+	auto abs(const Signal<T, Allocator>& signal, const ExecutionContext& context = {})
 	{
 		// The returned signal should have the return type of the std::abs() function applied to the signal's sample
 		using U = decltype(std::abs(std::declval<T>()));
-		Signal<U> absoluteSignal(signal.getSamplingRate_Hz());
-		absoluteSignal.reserve(signal.size());
-		
-		std::transform(signal.begin(), signal.end(), std::back_inserter(absoluteSignal), [](auto x) {return std::abs(x); });
+		typename rebind_signal<U, Allocator>::container_type absoluteSamples(signal.size());
+		detail::transform(signal.begin(), signal.size(), absoluteSamples.begin(), [](auto x) {return std::abs(x); }, context);
 
-		return absoluteSignal;
+		return rebind_signal<U, Allocator>(signal.getSamplingRate_Hz(), std::move(absoluteSamples));
 	}
 
 	template<class T>
-	auto abs(const std::vector<T>& vec)
+	auto abs(const std::vector<T>& vec, const ExecutionContext& context = {})
 	{
 		// The returned signal should have the return type of the std::abs() function applied to the vector's elements
 		using U = decltype(std::abs(std::declval<T>()));
-		std::vector<U> absVec;
-		absVec.reserve(vec.size());
-
-		std::transform(vec.begin(), vec.end(), std::back_inserter(absVec), [](auto x) {return std::abs(x); });
+		std::vector<U> absVec(vec.size());
+		detail::transform(vec.begin(), vec.size(), absVec.begin(), [](auto x) {return std::abs(x); }, context);
 
 		return absVec;
 	}
 
 
 	template<class T>
-	auto real(const std::vector<std::complex<T>>& v)
+	auto real(const std::vector<std::complex<T>>& v, const ExecutionContext& context = {})
 	{
-		std::vector<T> v_real;
-		v_real.reserve(v.size());
-
-		std::transform(v.begin(), v.end(), std::back_inserter(v_real), [](auto z) {return std::real(z); });
+		std::vector<T> v_real(v.size());
+		detail::transform(v.begin(), v.size(), v_real.begin(), [](auto z) {return std::real(z); }, context);
 
 		return v_real;
 	}
-	
+
 	template<class T>
-	auto real(const Signal<T>& signal)
+	auto imag(const std::vector<std::complex<T>>& v, const ExecutionContext& context = {})
+	{
+		std::vector<T> v_imag(v.size());
+		detail::transform(v.begin(), v.size(), v_imag.begin(), [](auto z) {return std::imag(z); }, context);
+
+		return v_imag;
+	}
+	
+	template<class T, class Allocator>
+	auto real(const Signal<T, Allocator>& signal, const ExecutionContext& context = {})
 	{
 		// The returned signal should have the return type of the std::real() function applied to the signal's sample
 		using U = decltype(std::real(std::declval<T>()));
-		Signal<U> realPart(signal.getSamplingRate_Hz());
-		realPart.reserve(signal.size());
-
-		std::transform(signal.begin(), signal.end(), std::back_inserter(realPart), [](auto x) {return std::real(x); });
+		typename rebind_signal<U, Allocator>::container_type realSamples(signal.size());
+		detail::transform(signal.begin(), signal.size(), realSamples.begin(), [](auto x) {return std::real(x); }, context);
 
-		return realPart;
+		return rebind_signal<U, Allocator>(signal.getSamplingRate_Hz(), std::move(realSamples));
 	}
 
-	template<class T>
-	auto imag(const Signal<T>& signal)
+	template<class T, class Allocator>
+	auto imag(const Signal<T, Allocator>& signal, const ExecutionContext& context = {})
 	{
 		// The returned signal should have the return type of the std::imag() function applied to the signal's sample
 		using U = decltype(std::imag(std::declval<T>()));
-		Signal<U> imaginaryPart(signal.getSamplingRate_Hz());
-		imaginaryPart.reserve(signal.size());
+		typename rebind_signal<U, Allocator>::container_type imaginarySamples(signal.size());
+		detail::transform(signal.begin(), signal.size(), imaginarySamples.begin(), [](auto x) {return std::imag(x); }, context);
 
-		std::transform(signal.begin(), signal.end(), std::back_inserter(imaginaryPart), [](auto x) {return std::imag(x); });
-
-		return imaginaryPart;
+		return rebind_signal<U, Allocator>(signal.getSamplingRate_Hz(), std::move(imaginarySamples));
 	}
 
 	template<class T>
@@ -579,12 +611,12 @@ namespace dsp
 		return z_conj;
 	}
 	
-	template<class T>
-	Signal<T> conj(const Signal<T>& signal)
+	template<class T, class Allocator>
+	Signal<T, Allocator> conj(const Signal<T, Allocator>& signal)
 	{
 		// The returned signal should have the return type of the std::conj() function applied to the signal's sample
 		using U = decltype(std::conj(std::declval<T>()));
-		Signal<U> conjugatedSignal(signal.getSamplingRate_Hz());
+		rebind_signal<U, Allocator> conjugatedSignal(signal.getSamplingRate_Hz());
 		conjugatedSignal.reserve(signal.size());
 
 		std::transform(signal.begin(), signal.end(), std::back_inserter(conjugatedSignal), [](auto x) {return std::conj(x); });
@@ -597,12 +629,12 @@ namespace dsp
 	inline std::vector<double> conj(const std::vector<double>& z) { return z; }
 	inline std::vector<long double> conj(const std::vector<long double>& z) { return z; }
 	
-	template<class T>
-	auto arg(const Signal<T>& signal)
+	template<class T, class Allocator>
+	auto arg(const Signal<T, Allocator>& signal)
 	{
 		// The returned signal should have the return type of the std::arg() function applied to the signal's sample
 		using U = decltype(std::arg(std::declval<T>()));
-		Signal<U> phaseSignal(signal.getSamplingRate_Hz());
+		rebind_signal<U, Allocator> phaseSignal(signal.getSamplingRate_Hz());
 		phaseSignal.reserve(signal.size());
 
 		std::transform(signal.begin(), signal.end(), std::back_inserter(phaseSignal), [](auto x) {return std::arg(x); });
@@ -610,16 +642,14 @@ namespace dsp
 		return phaseSignal;
 	}
 
-	template<class T>
-	auto norm(const Signal<T>& signal)
+	template<class T, class Allocator>
+	auto norm(const Signal<T, Allocator>& signal, const ExecutionContext& context = {})
 	{
 		// The returned signal should have the return type of the std::norm() function applied to the signal's sample
 		using U = decltype(std::norm(std::declval<T>()));
-		Signal<U> normSignal(signal.getSamplingRate_Hz());
-		normSignal.reserve(signal.size());
-
-		std::transform(signal.begin(), signal.end(), std::back_inserter(normSignal), [](auto x) {return std::norm(x); });
+		typename rebind_signal<U, Allocator>::container_type normSamples(signal.size());
+		detail::transform(signal.begin(), signal.size(), normSamples.begin(), [](auto x) {return std::norm(x); }, context);
 
-		return normSignal;
+		return rebind_signal<U, Allocator>(signal.getSamplingRate_Hz(), std::move(normSamples));
 	}
 }
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "Signal.h"
+
+namespace dsp
+{
+	/// @brief Non-owning, read-only view of equally spaced samples (pointer, length, stride, and sampling rate).
+	///
+	/// Library functions taking a SignalView work on data that lives anywhere (memory-mapped files, ring buffers,
+	/// other libraries' arrays, one channel of interleaved data) without copying it into a vector first. Views convert
+	/// implicitly from std::vector and Signal; the viewed samples must outlive the view.
+	///
+	///		dsp::SignalView<float> left(interleaved.data(), numFrames, 2, 48000);  // Every other sample, starting with the first
+	///		auto X = dsp::fft::rfft(left.subview(0, 1024));
+	/// @tparam T Data type of the samples
+	template<class T>
+	class SignalView
+	{
+	public:
+		using value_type = T;
+		using size_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using const_reference = const T&;
+		using const_pointer = const T*;
+
+		/// @brief Random-access iterator stepping over the samples of a (possibly strided) view
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const T*;
+			using reference = const T&;
+
+			const_iterator() = default;
+			const_iterator(const T* p, difference_type stride) : p_(p), stride_(stride) {}
+
+			reference operator*() const { return *p_; }
+			pointer operator->() const { return p_; }
+			reference operator[](difference_type n) const { return p_[n * stride_]; }
+
+			/// @brief Returns the distance in memory between two adjacent samples (1 for contiguous samples)
+			difference_type stride() const { return stride_; }
+
+			const_iterator& operator++() { p_ += stride_; return *this; }
+			const_iterator operator++(int) { auto tmp = *this; p_ += stride_; return tmp; }
+			const_iterator& operator--() { p_ -= stride_; return *this; }
+			const_iterator operator--(int) { auto tmp = *this; p_ -= stride_; return tmp; }
+			const_iterator& operator+=(difference_type n) { p_ += n * stride_; return *this; }
+			const_iterator& operator-=(difference_type n) { p_ -= n * stride_; return *this; }
+			friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+			friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+			friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+			friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs) { return (lhs.p_ - rhs.p_) / lhs.stride_; }
+
+			friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.p_ == rhs.p_; }
+			friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) { return lhs.p_ != rhs.p_; }
+			friend bool operator<(const const_iterator& lhs, const const_iterator& rhs) { return (rhs - lhs) > 0; }
+			friend bool operator>(const const_iterator& lhs, const const_iterator& rhs) { return rhs < lhs; }
+			friend bool operator<=(const const_iterator& lhs, const const_iterator& rhs) { return !(rhs < lhs); }
+			friend bool operator>=(const const_iterator& lhs, const const_iterator& rhs) { return !(lhs < rhs); }
+
+		private:
+			const T* p_{ nullptr };
+			difference_type stride_{ 1 };
+		};
+		using iterator = const_iterator;
+
+		SignalView() = default;
+
+		/// @brief Views size samples starting at data, stride elements apart (e.g., 2 for one channel of stereo data)
+		SignalView(const T* data, size_t size, difference_type stride = 1, unsigned samplingRate_Hz = 0)
+			: data_(data), size_(size), stride_(stride), samplingRate_Hz_(samplingRate_Hz)
+		{
+			if (stride <= 0) { throw std::invalid_argument("The stride of a SignalView must be positive!"); }
+		}
+
+		/// @brief Views all samples of a vector
+		template<class Allocator>
+		SignalView(const std::vector<T, Allocator>& samples, unsigned samplingRate_Hz = 0)
+			: data_(samples.data()), size_(samples.size()), samplingRate_Hz_(samplingRate_Hz) {}
+
+		/// @brief Views all samples of a signal, including its sampling rate
+		template<class Allocator>
+		SignalView(const Signal<T, Allocator>& signal)
+			: data_(signal.data()), size_(signal.size()), samplingRate_Hz_(signal.getSamplingRate_Hz()) {}
+
+		/// @brief Returns a pointer to the first sample. Samples are only adjacent in memory if isContiguous().
+		const T* data() const { return data_; }
+		size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		difference_type stride() const { return stride_; }
+		bool isContiguous() const { return stride_ == 1; }
+
+		/// @brief Returns the sampling rate of the viewed samples, or 0 if it is unknown
+		unsigned getSamplingRate_Hz() const { return samplingRate_Hz_; }
+
+		const T& operator[](size_t pos) const { return data_[static_cast<difference_type>(pos) * stride_]; }
+		const T& at(size_t pos) const
+		{
+			if (pos >= size_) { throw std::out_of_range("SignalView index out of range!"); }
+			return (*this)[pos];
+		}
+		const T& front() const { return (*this)[0]; }
+		const T& back() const { return (*this)[size_ - 1]; }
+
+		const_iterator begin() const { return { data_, stride_ }; }
+		const_iterator end() const { return { data_ + static_cast<difference_type>(size_) * stride_, stride_ }; }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+
+		/// @brief Returns a view of count samples starting at sample offset (cropped to the end of this view)
+		SignalView subview(size_t offset, size_t count = static_cast<size_t>(-1)) const
+		{
+			if (offset > size_) { throw std::out_of_range("SignalView offset out of range!"); }
+			count = std::min(count, size_ - offset);
+			return { data_ + static_cast<difference_type>(offset) * stride_, count, stride_, samplingRate_Hz_ };
+		}
+
+		/// @brief Returns a view of every step-th sample (the sampling rate is divided accordingly)
+		SignalView strided(size_t step) const
+		{
+			if (step == 0) { throw std::invalid_argument("The step of a strided view must not be zero!"); }
+			return { data_, (size_ + step - 1) / step, stride_ * static_cast<difference_type>(step),
+				samplingRate_Hz_ / static_cast<unsigned>(step) };
+		}
+
+		/// @brief Copies the viewed samples into a vector
+		std::vector<T> toVector() const { return std::vector<T>(begin(), end()); }
+
+	private:
+		const T* data_{ nullptr };
+		size_t size_{ 0 };
+		difference_type stride_{ 1 };
+		unsigned samplingRate_Hz_{ 0 };
+	};
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "Signal.h"
+
+/// @brief Allocators for sample buffers
+///
+/// Signal<T, Allocator> and std::vector accept any of these allocators:
+///
+///		dsp::AlignedSignal<float> x(48000);  // 64-byte aligned samples, e.g., for AVX-512 loads
+///		dsp::Signal<double, dsp::PoolAllocator<double>> frame(48000);  // Recycled memory for short-lived signals
+///		dsp::Signal<double, std::pmr::polymorphic_allocator<double>> y(48000, dsp::poolResource());
+///
+/// The arithmetic kernels (see kernels.h) and the FFTW backend detect aligned buffers and use aligned loads and stores for them.
+namespace dsp
+{
+	/// @brief Alignment of all buffers returned by AlignedAllocator (by default) and MemoryPool, in bytes. Sufficient for AVX-512.
+	constexpr size_t simdAlignment = 64;
+
+	/// @brief Returns true if the pointer p is aligned to a multiple of alignment bytes.
+	inline bool isAligned(const void* p, size_t alignment)
+	{
+		return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+	}
+
+	/// @brief Allocator returning memory aligned to Alignment bytes (e.g., for SIMD loads or SIMD-optimized FFTW plans)
+	/// @tparam T Type of the allocated elements
+	/// @tparam Alignment Alignment in bytes. Must be a power of two and at least alignof(T).
+	template<class T, size_t Alignment = simdAlignment>
+	class AlignedAllocator
+	{
+		static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two!");
+		static_assert(Alignment >= alignof(T), "Alignment must be at least the natural alignment of T!");
+
+	public:
+		using value_type = T;
+		static constexpr size_t alignment = Alignment;
+
+		template<class U>
+		struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+		AlignedAllocator() noexcept = default;
+		template<class U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+		T* allocate(size_t n)
+		{
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T)) { throw std::bad_array_new_length(); }
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+		}
+
+		void deallocate(T* p, size_t) noexcept
+		{
+			::operator delete(p, std::align_val_t(Alignment));
+		}
+	};
+
+	template<class T, class U, size_t Alignment>
+	bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return true; }
+
+	template<class T, class U, size_t Alignment>
+	bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return false; }
+
+	/// @brief Thread-safe pool of memory blocks in power-of-two size classes.
+	///
+	/// Requests are rounded up to the next size class (64 bytes to 4 MiB) and served from a free list of blocks that were
+	/// returned earlier, so that signals which are created and destroyed repeatedly (e.g., one per frame) stop hitting
+	/// the system allocator after warm-up. Larger requests bypass the pool. All blocks are aligned to simdAlignment bytes.
+	class MemoryPool
+	{
+	public:
+		static constexpr size_t minBlockSize = 64;  //!< Size of the smallest size class in bytes
+		static constexpr size_t maxBlockSize = size_t(1) << 22;  //!< Size of the largest size class in bytes
+
+		/// @brief Returns the pool shared by all PoolAllocator instances.
+		static MemoryPool& instance();
+
+		MemoryPool() = default;
+		MemoryPool(const MemoryPool&) = delete;
+		MemoryPool& operator=(const MemoryPool&) = delete;
+		~MemoryPool();
+
+		/// @brief Returns a block of at least bytes bytes.
+		void* allocate(size_t bytes);
+
+		/// @brief Returns a block obtained from allocate(bytes) to the pool.
+		void deallocate(void* p, size_t bytes) noexcept;
+
+		/// @brief Frees all blocks that are currently cached in the pool.
+		void release();
+
+		/// @brief Returns the number of blocks that are currently cached in the pool.
+		size_t cachedBlocks() const;
+
+	private:
+		static size_t sizeClass(size_t bytes);
+
+		mutable std::mutex mutex_;
+		std::vector<std::vector<void*>> freeLists_;  //!< One free list per size class
+	};
+
+	/// @brief Allocator drawing from the shared MemoryPool
+	/// @tparam T Type of the allocated elements
+	template<class T>
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		PoolAllocator() noexcept = default;
+		template<class U>
+		PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+		T* allocate(size_t n)
+		{
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T)) { throw std::bad_array_new_length(); }
+			return static_cast<T*>(MemoryPool::instance().allocate(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, size_t n) noexcept
+		{
+			MemoryPool::instance().deallocate(p, n * sizeof(T));
+		}
+	};
+
+	template<class T, class U>
+	bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) { return true; }
+
+	template<class T, class U>
+	bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) { return false; }
+
+	/// @brief Returns a std::pmr::memory_resource backed by the shared MemoryPool (e.g., for std::pmr::polymorphic_allocator).
+	std::pmr::memory_resource* poolResource();
+
+	/// @brief Vector with aligned storage
+	template<class T>
+	using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+	/// @brief Signal with aligned storage
+	template<class T>
+	using AlignedSignal = Signal<T, AlignedAllocator<T>>;
+
+	/// @brief Signal with storage from the shared MemoryPool
+	template<class T>
+	using PoolSignal = Signal<T, PoolAllocator<T>>;
+}
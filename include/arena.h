@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "allocators.h"
+
+namespace dsp
+{
+	/// @brief Monotonic scratch memory for short-lived temporaries (e.g., the buffers needed to process one frame).
+	///
+	/// Allocations only bump a pointer and are never freed individually. Instead, the arena is rewound to a marker
+	/// (see ScratchScope) or reset as a whole. Memory is kept across rewinds, and whenever the arena becomes empty its
+	/// chunks are merged into a single one, so that repeated processing of similar frames causes no heap traffic at all
+	/// after the first frame. An arena must only be used by one thread at a time; use threadScratch() to get one per thread.
+	class ScratchArena
+	{
+	public:
+		/// @brief Position in the arena that it can be rewound to
+		struct Marker
+		{
+			size_t chunk{ 0 };
+			size_t offset{ 0 };
+		};
+
+		explicit ScratchArena(size_t initialCapacity = 0);
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena& operator=(const ScratchArena&) = delete;
+		~ScratchArena();
+
+		/// @brief Returns uninitialized memory of the given size and alignment (at most simdAlignment) that stays valid until the arena is rewound past it.
+		void* allocate(size_t bytes, size_t alignment = simdAlignment);
+
+		/// @brief Returns uninitialized, aligned memory for n elements of a trivially destructible type T.
+		template<class T>
+		T* allocate(size_t n)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "The arena never runs destructors!");
+			return static_cast<T*>(allocate(n * sizeof(T), simdAlignment));
+		}
+
+		/// @brief Returns the current position, e.g., to rewind to it later.
+		Marker marker() const { return { current_, offset_ }; }
+
+		/// @brief Frees all allocations made after the marker was taken.
+		void rewind(const Marker& marker);
+
+		/// @brief Frees all allocations.
+		void reset() { rewind({}); }
+
+		/// @brief Returns the number of bytes in use (including the unused ends of chunks that allocations skipped).
+		size_t used() const;
+
+		/// @brief Returns the number of bytes owned by the arena.
+		size_t capacity() const;
+
+	private:
+		struct Chunk
+		{
+			std::byte* data;
+			size_t size;
+		};
+
+		void addChunk(size_t minimumSize);
+		void releaseChunks();
+
+		std::vector<Chunk> chunks_;
+		size_t current_{ 0 };  //!< Index of the chunk that allocations are served from
+		size_t offset_{ 0 };  //!< Number of bytes used in the current chunk
+	};
+
+	/// @brief Rewinds an arena to the position it had when the scope was entered.
+	class ScratchScope
+	{
+	public:
+		explicit ScratchScope(ScratchArena& arena) : arena_(arena), marker_(arena.marker()) {}
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+		~ScratchScope() { arena_.rewind(marker_); }
+
+	private:
+		ScratchArena& arena_;
+		ScratchArena::Marker marker_;
+	};
+
+	/// @brief Returns the scratch arena of the calling thread.
+	ScratchArena& threadScratch();
+}
@@ -1,10 +1,22 @@
 #pragma once
+#include "allocators.h"
+#include "arena.h"
+#include "CalibratedSignal.h"
 #include "convert.h"
+#include "execution.h"
+#include "expression.h"
 #include "fft.h"
 #include "filter.h"
+#include "io.h"
+#include "kernels.h"
+#include "MultiSignal.h"
+#include "pcm.h"
+#include "resample.h"
 #include "Signal.h"
 #include "signals.h"
+#include "SignalView.h"
 #include "special.h"
 #include "stats.h"
+#include "threadpool.h"
 #include "utilities.h"
 #include "window.h"
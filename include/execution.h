@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "threadpool.h"
+
+/// @brief Control over the parallel execution of reductions and elementwise functions.
+///
+/// Functions that accept an ExecutionContext split their input into fixed chunks. Reductions compute one partial
+/// result per chunk and combine the partial results in chunk order, so the result depends on the chunk size, but not
+/// on the number or scheduling of the threads. In reproducible mode, sums do not even depend on the policy or the
+/// chunk size: they are computed over fixed blocks of samples whose sums are added pairwise in a fixed tree, so that
+/// sequential and parallel runs give bit-identical results (e.g., for regression hashes).
+///
+///		const auto context = dsp::ExecutionContext::parallel();
+///		const auto m = dsp::mean(recording, context);
+///		const auto magnitude = dsp::abs(spectrum, context);
+namespace dsp
+{
+	/// @brief Whether a function runs on the calling thread or in parallel
+	enum class execution_policy
+	{
+		automatic,  //!< In parallel if the input has at least ExecutionContext::parallelThreshold samples
+		sequential,
+		parallel
+	};
+
+	/// @brief Execution policy and chunking of a function call. Default contexts run on the calling thread; parallel
+	/// execution must be requested with parallel() or automatic().
+	struct ExecutionContext
+	{
+		execution_policy policy{ execution_policy::sequential };
+		size_t grainSize{ 1 << 14 };  //!< Number of samples per chunk
+		size_t parallelThreshold{ 1 << 16 };  //!< Minimum number of samples for parallel execution with execution_policy::automatic
+		ThreadPool* pool{ nullptr };  //!< Pool that runs the chunks (nullptr for ThreadPool::global())
+		bool reproducible{ false };  //!< Sum over a fixed tree of blocks, so that the result does not depend on the policy and grainSize
+
+		/// @brief Returns a context that runs everything on the calling thread
+		static ExecutionContext sequential()
+		{
+			return { execution_policy::sequential };
+		}
+
+		/// @brief Returns a context that runs in parallel if the input has at least parallelThreshold samples
+		static ExecutionContext automatic(size_t parallelThreshold = 1 << 16)
+		{
+			ExecutionContext context{ execution_policy::automatic };
+			context.parallelThreshold = parallelThreshold;
+			return context;
+		}
+
+		/// @brief Returns a context that runs in parallel regardless of the input size
+		static ExecutionContext parallel(size_t grainSize = 1 << 14)
+		{
+			return { execution_policy::parallel, grainSize };
+		}
+
+		/// @brief Returns whether an input of n samples is processed in parallel
+		bool runsInParallel(size_t n) const
+		{
+			switch (policy)
+			{
+			case execution_policy::sequential:
+				return false;
+			case execution_policy::parallel:
+				return n > grainSize;
+			default:
+				return n >= parallelThreshold && n > grainSize;
+			}
+		}
+	};
+
+	/// @cond developer-only
+	namespace detail
+	{
+		template<class It>
+		constexpr bool is_random_access_v = std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+		// Calls f(lo, hi) for the consecutive chunks [lo, hi) of [0, n) with chunkSize samples each, in parallel if the context says so
+		template<class F>
+		void forEachChunk(size_t n, size_t chunkSize, const ExecutionContext& context, F f)
+		{
+			chunkSize = std::max<size_t>(chunkSize, 1);
+			const auto numChunks = (n + chunkSize - 1) / chunkSize;
+			if (!context.runsInParallel(n) || numChunks < 2)
+			{
+				for (size_t c = 0; c < numChunks; ++c)
+				{
+					f(c * chunkSize, std::min(n, (c + 1) * chunkSize));
+				}
+				return;
+			}
+
+			auto& pool = context.pool != nullptr ? *context.pool : ThreadPool::global();
+			pool.parallelFor(numChunks, [&](size_t c) { f(c * chunkSize, std::min(n, (c + 1) * chunkSize)); });
+		}
+
+		// Folds map(lo, hi) of the chunks of [0, n) into init with combine, in chunk order
+		template<class R, class Map, class Combine>
+		R reduceChunks(size_t n, size_t chunkSize, const ExecutionContext& context, R init, Map map, Combine combine)
+		{
+			chunkSize = std::max<size_t>(chunkSize, 1);
+			if (!context.runsInParallel(n))
+			{
+				for (size_t lo = 0; lo < n; lo += chunkSize)
+				{
+					init = combine(init, map(lo, std::min(n, lo + chunkSize)));
+				}
+				return init;
+			}
+
+			std::vector<R> partial((n + chunkSize - 1) / chunkSize);
+			forEachChunk(n, chunkSize, context, [&](size_t lo, size_t hi) { partial[lo / chunkSize] = map(lo, hi); });
+			for (const auto& p : partial)
+			{
+				init = combine(init, p);
+			}
+			return init;
+		}
+
+		// Number of samples per leaf of the summation tree of reproducible reductions
+		constexpr size_t reproducibleBlockSize = 4096;
+
+		// Sums leaf(lo, hi) over fixed blocks [lo, hi) of [0, n) and adds the block sums pairwise (block 0 + block 1,
+		// block 2 + block 3, ..., then the pairs of pairs, ...). The tree only depends on n, so the result is the same
+		// for any execution policy, chunk size, and number of threads.
+		template<class R, class Leaf>
+		R reduceTree(size_t n, const ExecutionContext& context, Leaf leaf)
+		{
+			constexpr auto B = reproducibleBlockSize;
+			const auto numBlocks = (n + B - 1) / B;
+			if (numBlocks == 0) return R(0);
+
+			std::vector<R> sums(numBlocks);
+			const auto chunkSize = std::max<size_t>(context.grainSize / B, 1) * B;
+			forEachChunk(n, chunkSize, context, [&](size_t lo, size_t hi)
+				{
+					for (size_t block = lo; block < hi; block += B)
+					{
+						sums[block / B] = leaf(block, std::min(hi, block + B));
+					}
+				});
+
+			for (size_t width = 1; width < numBlocks; width *= 2)
+			{
+				for (size_t i = 0; i + width < numBlocks; i += 2 * width)
+				{
+					sums[i] += sums[i + width];
+				}
+			}
+			return sums[0];
+		}
+
+		// Sums leaf(lo, hi) over [0, n): with reduceTree() in reproducible mode, over the chunks of the context in
+		// parallel, and with a single call otherwise
+		template<class R, class Leaf>
+		R reduceSum(size_t n, const ExecutionContext& context, Leaf leaf)
+		{
+			if (context.reproducible) return reduceTree<R>(n, context, leaf);
+			if (!context.runsInParallel(n)) return leaf(0, n);
+			return reduceChunks(n, context.grainSize, context, R(0), leaf, std::plus<R>());
+		}
+
+		// Writes op(*(first + i)) to *(out + i) for i in [0, n)
+		template<class RandomIt, class OutputIt, class UnaryOp>
+		void transform(RandomIt first, size_t n, OutputIt out, UnaryOp op, const ExecutionContext& context)
+		{
+			const auto offset = [](auto it, size_t i) { return it + static_cast<std::ptrdiff_t>(i); };
+			forEachChunk(n, context.grainSize, context,
+				[&](size_t lo, size_t hi) { std::transform(offset(first, lo), offset(first, hi), offset(out, lo), op); });
+		}
+	}
+	/// @endcond
+}
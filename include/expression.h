@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Signal.h"
+
+/// @brief Expression templates for lazy, fused element-wise arithmetic on signals and vectors.
+///
+/// The arithmetic operators of Signal evaluate eagerly, so an expression like a * b + c * d - e creates a full-length
+/// temporary for every intermediate result. Wrapping one operand with lazy() instead builds a lightweight expression tree
+/// that is evaluated in a single loop (without any temporaries) when it is assigned to a Signal or passed to evaluate():
+///
+///		dsp::Signal<double> y = dsp::expr::lazy(a) * b + dsp::expr::lazy(c) * d - e;
+///
+/// Expressions only refer to their operands, so they must be evaluated before the operands go out of scope.
+namespace dsp::expr
+{
+	/// @brief Base class of all expression nodes (CRTP)
+	/// @tparam E Type of the derived expression
+	template<class E>
+	struct Expression
+	{
+		const E& self() const { return static_cast<const E&>(*this); }
+	};
+
+	/// @brief Leaf node referring to the samples of a Signal or a vector
+	template<class T>
+	class Terminal : public Expression<Terminal<T>>
+	{
+	public:
+		using value_type = T;
+
+		Terminal(const T* data, size_t size, unsigned samplingRate_Hz = 0)
+			: data_(data), size_(size), samplingRate_Hz_(samplingRate_Hz) {}
+
+		T operator[](size_t i) const { return data_[i]; }
+		size_t size() const { return size_; }
+		bool isScalar() const { return false; }
+		unsigned samplingRate_Hz() const { return samplingRate_Hz_; }
+
+	private:
+		const T* data_;
+		size_t size_;
+		unsigned samplingRate_Hz_;  //!< 0 for vectors
+	};
+
+	/// @brief Leaf node holding a scalar that is broadcast to every element
+	template<class T>
+	class Scalar : public Expression<Scalar<T>>
+	{
+	public:
+		using value_type = T;
+
+		explicit Scalar(const T& value) : value_(value) {}
+
+		T operator[](size_t) const { return value_; }
+		size_t size() const { return 0; }
+		bool isScalar() const { return true; }
+		unsigned samplingRate_Hz() const { return 0; }
+
+	private:
+		T value_;
+	};
+
+	/// @cond developer-only
+	struct Plus { template<class A, class B> static auto apply(const A& a, const B& b) { return a + b; } };
+	struct Minus { template<class A, class B> static auto apply(const A& a, const B& b) { return a - b; } };
+	struct Multiplies { template<class A, class B> static auto apply(const A& a, const B& b) { return a * b; } };
+	struct Divides { template<class A, class B> static auto apply(const A& a, const B& b) { return a / b; } };
+	struct Negate { template<class A> static auto apply(const A& a) { return -a; } };
+	/// @endcond
+
+	/// @brief Inner node combining two expressions element by element
+	template<class L, class R, class Op>
+	class Binary : public Expression<Binary<L, R, Op>>
+	{
+	public:
+		using value_type = std::common_type_t<typename L::value_type, typename R::value_type>;
+
+		Binary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs)
+		{
+			if (!lhs_.isScalar() && !rhs_.isScalar() && lhs_.size() != rhs_.size())
+			{
+				throw std::logic_error("Expression operands have different lengths!");
+			}
+			if (lhs_.samplingRate_Hz() != 0 && rhs_.samplingRate_Hz() != 0 && lhs_.samplingRate_Hz() != rhs_.samplingRate_Hz())
+			{
+				throw std::logic_error("Signals have different sampling rates!");
+			}
+		}
+
+		value_type operator[](size_t i) const { return Op::apply(lhs_[i], rhs_[i]); }
+		size_t size() const { return lhs_.isScalar() ? rhs_.size() : lhs_.size(); }
+		bool isScalar() const { return lhs_.isScalar() && rhs_.isScalar(); }
+		unsigned samplingRate_Hz() const { return lhs_.samplingRate_Hz() != 0 ? lhs_.samplingRate_Hz() : rhs_.samplingRate_Hz(); }
+
+	private:
+		L lhs_;
+		R rhs_;
+	};
+
+	/// @brief Inner node applying a unary operation to each element of an expression
+	template<class E, class Op>
+	class Unary : public Expression<Unary<E, Op>>
+	{
+	public:
+		using value_type = typename E::value_type;
+
+		explicit Unary(const E& operand) : operand_(operand) {}
+
+		value_type operator[](size_t i) const { return Op::apply(operand_[i]); }
+		size_t size() const { return operand_.size(); }
+		bool isScalar() const { return operand_.isScalar(); }
+		unsigned samplingRate_Hz() const { return operand_.samplingRate_Hz(); }
+
+	private:
+		E operand_;
+	};
+
+	/// @brief Starts a lazy expression with the samples of a signal.
+	template<class T, class Allocator>
+	Terminal<T> lazy(const Signal<T, Allocator>& signal)
+	{
+		return Terminal<T>(signal.data(), signal.size(), signal.getSamplingRate_Hz());
+	}
+
+	/// @brief Starts a lazy expression with the elements of a vector.
+	template<class T, class Allocator>
+	Terminal<T> lazy(const std::vector<T, Allocator>& vec)
+	{
+		return Terminal<T>(vec.data(), vec.size());
+	}
+
+	/// @brief Evaluates an expression into the buffer out, which must hold e.size() elements. out may be one of the operands.
+	template<class E, class T>
+	void evaluate(const Expression<E>& e, T* out)
+	{
+		const auto& expression = e.self();
+		const size_t n = expression.size();
+		for (size_t i = 0; i < n; ++i)
+		{
+			out[i] = expression[i];
+		}
+	}
+
+	/// @brief Evaluates an expression into a new vector.
+	template<class E>
+	auto evaluate(const Expression<E>& e)
+	{
+		std::vector<typename E::value_type> result(e.self().size());
+		evaluate(e, result.data());
+		return result;
+	}
+
+	/// @cond developer-only
+	// Wraps the operands of the mixed operators below
+	template<class E>
+	const E& operand(const Expression<E>& e) { return e.self(); }
+	template<class T, class Allocator>
+	Terminal<T> operand(const Signal<T, Allocator>& signal) { return lazy(signal); }
+	template<class T, class Allocator>
+	Terminal<T> operand(const std::vector<T, Allocator>& vec) { return lazy(vec); }
+
+	template<class A>
+	struct is_operand : std::false_type {};
+	template<class T, class Allocator>
+	struct is_operand<Signal<T, Allocator>> : std::true_type {};
+	template<class T, class Allocator>
+	struct is_operand<std::vector<T, Allocator>> : std::true_type {};
+
+	// At least one side must already be an expression, so that the eager operators of Signal stay untouched
+	template<class A, class B>
+	using enable_binary = std::enable_if_t<
+		(std::is_base_of_v<Expression<A>, A> && (std::is_base_of_v<Expression<B>, B> || is_operand<B>::value)) ||
+		(is_operand<A>::value && std::is_base_of_v<Expression<B>, B>), int>;
+
+	template<class E, class S>
+	using enable_scalar = std::enable_if_t<std::is_base_of_v<Expression<E>, E> && std::is_arithmetic_v<S>, int>;
+	/// @endcond
+
+#define DSP_EXPR_BINARY_OPERATOR(op, Op) \
+	template<class A, class B, enable_binary<A, B> = 0> \
+	auto operator op(const A& lhs, const B& rhs) \
+	{ \
+		using L = std::decay_t<decltype(operand(lhs))>; \
+		using R = std::decay_t<decltype(operand(rhs))>; \
+		return Binary<L, R, Op>(operand(lhs), operand(rhs)); \
+	} \
+	template<class E, class S, enable_scalar<E, S> = 0> \
+	auto operator op(const E& lhs, const S& value) \
+	{ \
+		using T = typename E::value_type; \
+		return Binary<E, Scalar<T>, Op>(lhs, Scalar<T>(static_cast<T>(value))); \
+	} \
+	template<class E, class S, enable_scalar<E, S> = 0> \
+	auto operator op(const S& value, const E& rhs) \
+	{ \
+		using T = typename E::value_type; \
+		return Binary<Scalar<T>, E, Op>(Scalar<T>(static_cast<T>(value)), rhs); \
+	}
+
+	DSP_EXPR_BINARY_OPERATOR(+, Plus)
+	DSP_EXPR_BINARY_OPERATOR(-, Minus)
+	DSP_EXPR_BINARY_OPERATOR(*, Multiplies)
+	DSP_EXPR_BINARY_OPERATOR(/, Divides)
+
+#undef DSP_EXPR_BINARY_OPERATOR
+
+	template<class E>
+	Unary<E, Negate> operator-(const Expression<E>& e)
+	{
+		return Unary<E, Negate>(e.self());
+	}
+}
+
+template<class T, class Allocator>
+template<class E>
+dsp::Signal<T, Allocator>::Signal(const expr::Expression<E>& expression)
+	: samplingRate_Hz_(expression.self().samplingRate_Hz()), samples_(expression.self().size())
+{
+	expr::evaluate(expression, samples_.data());
+}
+
+template<class T, class Allocator>
+template<class E>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator=(const expr::Expression<E>& expression)
+{
+	const auto& e = expression.self();
+	if (e.samplingRate_Hz() != 0) { samplingRate_Hz_ = e.samplingRate_Hz(); }
+	// If this signal is an operand, its size already matches and no reallocation happens before the evaluation
+	samples_.resize(e.size());
+	expr::evaluate(expression, samples_.data());
+	return *this;
+}
@@ -3,6 +3,10 @@
 #include <complex>
 #include <vector>
 
+#include "arena.h"
+#include "MultiSignal.h"
+#include "pcm.h"
+#include "SignalView.h"
 #include "utilities.h"
 #include "window.h"
 
@@ -57,6 +61,19 @@ namespace dsp
 		template<class T>
 		std::vector<std::complex<T>> rfft(const std::vector<T>& x, unsigned n = 0, NormalizationMode mode = NormalizationMode::backward, backend backend = backend::automatic);
 
+		/// @brief Computes the rfft of a view (e.g., of memory-mapped or strided samples) without copying it into a vector first.
+		///
+		/// With the 'simple' backend, contiguous views that are at least n samples long are transformed without any copy of the input.
+		template<class T>
+		std::vector<std::complex<T>> rfft(SignalView<T> x, unsigned n = 0, NormalizationMode mode = NormalizationMode::backward, backend backend = backend::automatic);
+
+		/// @brief Computes the rfft of each channel (in parallel) and returns the spectra in channel order.
+		template<class T>
+		std::vector<std::vector<std::complex<T>>> rfft(const MultiSignal<T>& x, unsigned n = 0, NormalizationMode mode = NormalizationMode::backward, backend backend = backend::automatic)
+		{
+			return x.mapChannels([=](SignalView<T> channel) { return rfft(channel, n, mode, backend); });
+		}
+
 		/// @brief Alias for rfft.
 		template<class T>
 		std::vector<std::complex<T>> fft(const std::vector<T>& x, unsigned n = 0, NormalizationMode mode = NormalizationMode::backward, backend backend = backend::automatic)
@@ -64,6 +81,13 @@ namespace dsp
 			return rfft(x, n, mode, backend);
 		}
 
+		/// @brief Alias for rfft.
+		template<class T>
+		std::vector<std::complex<T>> fft(SignalView<T> x, unsigned n = 0, NormalizationMode mode = NormalizationMode::backward, backend backend = backend::automatic)
+		{
+			return rfft(x, n, mode, backend);
+		}
+
 		/// @brief Computes the inverse of rfft.
 		///
 		/// This function computes the inverse of the 1-D n-point discrete Fourier Transform of real input computed by rfft. In other words, irfft(rfft(x), x.size()) == x to within numerical accuracy. 
@@ -84,9 +108,45 @@ namespace dsp
 		}
 
 
+		/// @brief Computes the real-input FFT of N samples into a caller-owned buffer, without heap allocations.
+		///
+		/// Uses the 'simple' backend, so repeated transforms of the same length (e.g., of consecutive frames) only need
+		/// buffers that are allocated once.
+		/// @param x N samples
+		/// @param X Output buffer for all N frequency bins (the upper half is the complex conjugate of the lower half)
+		/// @param N Transform length, a power of two of at least 4
+		template<class T>
+		void rfft(const T* x, std::complex<T>* X, unsigned N);
+
 		template<class T>
 		std::vector<T> logSquaredMagnitudeSpectrum(const std::vector<T>& signal, int N_fft, double relativeCutoff);
 
+		/// @brief Computes the log-squared magnitude spectrum of one frame without heap allocations.
+		///
+		/// All temporaries are taken from the scratch arena and released before returning, so that processing one frame
+		/// after the other causes no heap traffic once the arena has grown to the required size. Uses the 'simple' FFT backend.
+		/// @tparam T Data type of the samples
+		/// @param frame Samples of the frame
+		/// @param length Number of samples in frame. The frame is cropped or zero-padded to the FFT length.
+		/// @param N_fft FFT length (rounded up to the next power of two)
+		/// @param relativeCutoff How much of the spectrum to calculate (e.g., 0.5 to discard the mirrored part)
+		/// @param out Output buffer for relativeCutoff * N values, where N is N_fft rounded up to the next power of two
+		/// @param arena Scratch memory for the temporaries
+		/// @return The number of values written to out
+		template<class T>
+		size_t logSquaredMagnitudeSpectrum(const T* frame, size_t length, int N_fft, double relativeCutoff, T* out,
+			ScratchArena& arena = threadScratch());
+
+		/// @brief Computes the log-squared magnitude spectrum of one frame of PCM samples without heap allocations.
+		///
+		/// The samples are converted to floating point while they are loaded into the FFT buffer, so that no intermediate
+		/// floating-point copy of the frame is needed.
+		/// @tparam T Data type of the spectrum (float or double)
+		/// @tparam P PCM sample type (pcm::int16, pcm::int24, or pcm::int32)
+		template<class T, class P, std::enable_if_t<pcm::is_pcm_v<P>, int> = 0>
+		size_t logSquaredMagnitudeSpectrum(const P* frame, size_t length, int N_fft, double relativeCutoff, T* out,
+			ScratchArena& arena = threadScratch());
+
 		// TODO:
 		//fft2();
 		//ifft2();
@@ -135,6 +195,10 @@ namespace dsp
 		template<class T>
 		std::vector<T> fftconvolution(const std::vector<T>& volume, const std::vector<T>& kernel, convolution_mode mode = convolution_mode::valid);
 
+		/// @brief Fast convolution of two views using the FFT
+		template<class T>
+		std::vector<T> fftconvolution(SignalView<T> volume, SignalView<T> kernel, convolution_mode mode = convolution_mode::valid);
+
 		/// @brief Returns a spectrogram of the passed signal
 		/// @tparam T Data type of the signal's samples
 		/// @param signal Signal to analyze
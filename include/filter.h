@@ -1,8 +1,15 @@
 #pragma once
 
+#include <array>
+#include <complex>
+#include <tuple>
 #include <vector>
 
+#include "MultiSignal.h"
+#include "pcm.h"
 #include "Signal.h"
+#include "SignalView.h"
+#include "window.h"
 
 /// @brief Functions to apply and design digital filters
 namespace dsp::filter
@@ -16,6 +23,18 @@ namespace dsp::filter
 	template<class T>
 	std::vector<T> filter(std::vector<T> b, std::vector<T> a, 
 		const std::vector<T>& x);
+
+	/// @brief Filters a view of the input data (e.g., of memory-mapped or strided samples) without copying it into a vector first.
+	template<class T>
+	std::vector<T> filter(std::vector<T> b, std::vector<T> a, SignalView<T> x);
+
+	/// @brief Filters each channel (in parallel). The result has the same layout as x.
+	template<class T>
+	MultiSignal<T> filter(std::vector<T> b, std::vector<T> a, const MultiSignal<T>& x)
+	{
+		auto channels = x.mapChannels([&](SignalView<T> channel) { return filter(b, a, channel); });
+		return MultiSignal<T>(x.getSamplingRate_Hz(), channels, x.layout());
+	}
 	
 	/// @brief Returns linear prediction filter coefficients
 	/// @tparam T Data type of the samples
@@ -25,6 +44,133 @@ namespace dsp::filter
 	template<class T>
 	std::vector<T> lpc(const std::vector<T>& x, unsigned N);
 
+	/// @brief Algorithms for the autocorrelation of the linear prediction analysis
+	enum class autocorrelation_method { automatic, direct, vectorized, fft };
+
+	/// @brief Result of a linear prediction analysis of one frame
+	/// @tparam T Data type of the samples
+	template<class T>
+	struct LpcResult
+	{
+		std::vector<T> coefficients;  //!< Linear predictor coefficients (same convention as lpc())
+		std::vector<T> reflection;  //!< Reflection (PARCOR) coefficients of the Levinson-Durbin recursion
+		T error{ 0 };  //!< Energy of the prediction error
+	};
+
+	/// @brief Linear prediction analysis that reuses its scratch buffers across frames.
+	///
+	/// The autocorrelation is computed with a direct double loop, a vectorized loop that accumulates four lags per pass over
+	/// the frame, or via the FFT. 'automatic' picks the cheapest one based on the frame length and the order.
+	/// @tparam T Data type of the samples
+	template<class T>
+	class LpcAnalyzer
+	{
+	public:
+		/// @param order Order of the linear predictor
+		/// @param method Algorithm for the autocorrelation
+		explicit LpcAnalyzer(unsigned order, autocorrelation_method method = autocorrelation_method::automatic);
+
+		/// @brief Analyzes a frame of the given length and stores the result in result, reusing its storage.
+		void analyze(const T* frame, size_t length, LpcResult<T>& result);
+
+		/// @brief Analyzes a frame and returns the result.
+		LpcResult<T> analyze(const std::vector<T>& frame);
+
+		/// @brief Returns the autocorrelation method that is used for frames of the given length.
+		autocorrelation_method selectMethod(size_t length) const;
+
+	private:
+		void autocorrelate(const T* frame, size_t length);
+
+		unsigned order_;
+		autocorrelation_method method_;
+		std::vector<T> r_;  //!< Autocorrelation at lags 0..order
+		std::vector<T> alpha_;  //!< Prediction error filter of the recursion
+		std::vector<T> scratch_;  //!< Previous prediction error filter of the recursion
+		std::vector<T> padded_;  //!< Zero-padded frame, then power spectrum, of the FFT autocorrelation
+		std::vector<std::complex<T>> spectrum_;  //!< Spectrum of the FFT autocorrelation
+	};
+
+	/// @brief Returns the linear prediction analysis of each frame.
+	/// @tparam T Data type of the samples
+	/// @param frames Frames of the signal (e.g., from signalToFrames())
+	/// @param N Order of the linear predictor
+	/// @param method Algorithm for the autocorrelation
+	/// @return Coefficients, reflection coefficients and prediction error of each frame
+	template<class T>
+	std::vector<LpcResult<T>> lpc(const std::vector<std::vector<T>>& frames, unsigned N,
+		autocorrelation_method method = autocorrelation_method::automatic);
+
+	/// @brief Computes the LPC residual (prediction error) by inverse filtering: e[n] = x[n] - sum_j coeff[j] * x[n - j].
+	///
+	/// Samples before the start of the frame are taken as zero. Does not allocate; x and residual must not overlap.
+	/// @tparam T Data type of the samples
+	/// @param x Input frame of the given length
+	/// @param residual Output buffer of the given length
+	/// @param length Number of samples
+	/// @param coeff Linear predictor coefficients coeff[0..N] as returned by lpc() (coeff[0] is ignored)
+	/// @param N Order of the linear predictor
+	template<class T>
+	void lpcResidual(const T* x, T* residual, size_t length, const T* coeff, unsigned N);
+
+	/// @brief Returns the LPC residual of x for the linear predictor coefficients coeff (see lpc()).
+	template<class T>
+	std::vector<T> lpcResidual(const std::vector<T>& x, const std::vector<T>& coeff);
+
+	/// @brief Returns the LPC residual of each frame, using the linear predictor coefficients of the respective frame.
+	template<class T>
+	std::vector<std::vector<T>> lpcResidual(const std::vector<std::vector<T>>& frames, const std::vector<std::vector<T>>& coeffs);
+
+	/// @brief Resynthesizes a signal from its LPC residual: x[n] = e[n] + sum_j coeff[j] * x[n - j]. Inverse of lpcResidual().
+	///
+	/// Does not allocate. In-place operation (residual == x) is allowed.
+	/// @tparam T Data type of the samples
+	/// @param residual Residual of the given length
+	/// @param x Output buffer of the given length
+	/// @param length Number of samples
+	/// @param coeff Linear predictor coefficients coeff[0..N] as returned by lpc() (coeff[0] is ignored)
+	/// @param N Order of the linear predictor
+	template<class T>
+	void lpcSynthesis(const T* residual, T* x, size_t length, const T* coeff, unsigned N);
+
+	/// @brief Returns the signal synthesized from the LPC residual and the linear predictor coefficients coeff (see lpc()).
+	template<class T>
+	std::vector<T> lpcSynthesis(const std::vector<T>& residual, const std::vector<T>& coeff);
+
+	/// @brief Returns the signal synthesized from the residual of each frame and the linear predictor coefficients of the respective frame.
+	template<class T>
+	std::vector<std::vector<T>> lpcSynthesis(const std::vector<std::vector<T>>& residuals, const std::vector<std::vector<T>>& coeffs);
+
+	/// @brief Converts linear predictor coefficients 1, a1, ..., aN (i.e., the predictor 1 - a1 z^-1 - ... - aN z^-N) to the
+	/// coefficients of the polynomial z^N - a1 z^(N-1) - ... - aN, whose roots are the poles of the LPC model.
+	/// @param lpcCoefficients N + 1 linear predictor coefficients as returned by lpc()
+	/// @param polynomial Output buffer for N + 1 polynomial coefficients (highest power first). May be the same as lpcCoefficients.
+	/// @param N Order of the linear predictor
+	template<class T>
+	void lpcToPolynomial(const T* lpcCoefficients, T* polynomial, unsigned N);
+
+	/// @brief Returns the polynomial coefficients (highest power first) for the linear predictor coefficients (see lpc()).
+	template<class T>
+	std::vector<T> lpcToPolynomial(const std::vector<T>& lpcCoefficients);
+
+	/// @brief Computes the roots of the real polynomial a[0] x^N + a[1] x^(N-1) + ... + a[N] with Bairstow's method,
+	/// refining all quadratic factors simultaneously.
+	///
+	/// If N is odd, the polynomial is multiplied by x, which adds a root at 0. Does not allocate: the quadratic factors are kept
+	/// in the roots buffer during the iteration. The coefficients are normalized by a[0], which must not be zero
+	/// (std::invalid_argument). Throws std::runtime_error if the corrections stay singular for more than maxIterations restarts per quadratic factor.
+	/// @param a N + 1 polynomial coefficients, highest power first
+	/// @param N Degree of the polynomial
+	/// @param roots Output buffer for N + N % 2 roots
+	/// @param maxIterations Maximum number of refinement passes over all factors. Poles close to the unit circle (as in LPC models
+	/// of voiced speech) can need around a hundred.
+	template<class T>
+	void polynomialRoots(const T* a, unsigned N, std::complex<T>* roots, unsigned maxIterations = 200);
+
+	/// @brief Returns the roots of the real polynomial with coefficients a (highest power first). See polynomialRoots().
+	template<class T>
+	std::vector<std::complex<T>> polynomialRoots(const std::vector<T>& a, unsigned maxIterations = 200);
+
 	/// @brief Perform a median filter on a vector.
 	/// @tparam T Data type of the samples
 	/// @param x Input vector
@@ -40,4 +186,261 @@ namespace dsp::filter
 	/// @return Signal containing the median filtered samples (same size as input).
 	template<class T>
 	dsp::Signal<T> medianfilter(const Signal<T>& x, typename Signal<T>::size_type kernel_size = 3);
-}
\ No newline at end of file
+
+	/*
+	 * FIR filter design
+	 */
+
+	/// @brief Returns the coefficients of a linear-phase FIR filter designed with the window method.
+	///
+	/// The ideal (brick-wall) impulse response is a sum of sinc functions, which is truncated to numtaps samples and multiplied with the window.
+	/// @tparam T Data type of the coefficients
+	/// @param numtaps Length of the filter (number of coefficients). Must be odd if a passband includes the Nyquist frequency.
+	/// @param cutoff Cutoff frequencies (in the same unit as fs), strictly increasing between 0 and fs/2 (both excluded).
+	/// @param pass_zero If true (default), the DC gain is 1 (lowpass, bandstop), otherwise it is 0 (highpass, bandpass).
+	/// @param windowType Window to apply to the truncated ideal impulse response. Default: Hamming.
+	/// @param scale If true (default), scale the coefficients so that the frequency response is exactly unity at the center of the first passband.
+	/// @param fs Sampling frequency. Default: 2 (i.e., cutoff frequencies are normalized so that 1 is the Nyquist frequency).
+	/// @param windowParameters Additional parameters of the window (e.g., beta for the Kaiser window), see window::get_window().
+	/// @return Filter coefficients of length numtaps that can be passed to filter() or dsp::convolve().
+	template<class T>
+	std::vector<T> firwin(unsigned numtaps, const std::vector<T>& cutoff, bool pass_zero = true,
+		window::type windowType = window::type::hamming, bool scale = true, T fs = 2, const std::vector<T>& windowParameters = {});
+
+	/// @brief Returns the coefficients of a linear-phase FIR filter that minimizes the weighted integrated squared error.
+	/// @tparam T Data type of the coefficients
+	/// @param numtaps Length of the filter. Must be odd.
+	/// @param bands Band edges (in the same unit as fs), as pairs of monotonically non-decreasing frequencies between 0 and fs/2.
+	/// @param desired Desired gain at the start and at the end of each band (same length as bands). The gain is interpolated linearly in between.
+	/// @param weight Relative weight of each band (half the length of bands). Default: all bands have the same weight.
+	/// @param fs Sampling frequency. Default: 2 (i.e., 1 is the Nyquist frequency).
+	/// @return Filter coefficients of length numtaps.
+	template<class T>
+	std::vector<T> firls(unsigned numtaps, const std::vector<T>& bands, const std::vector<T>& desired,
+		const std::vector<T>& weight = {}, T fs = 2);
+
+	/// @brief Filter types that can be designed with remez()
+	enum class remez_type { bandpass, differentiator, hilbert };
+
+	/// @brief Returns the coefficients of the minimax optimal (equiripple) linear-phase FIR filter using the Parks-McClellan (Remez exchange) algorithm.
+	/// @tparam T Data type of the coefficients
+	/// @param numtaps Length of the filter
+	/// @param bands Band edges (in the same unit as fs), as pairs of monotonically increasing frequencies between 0 and fs/2.
+	/// @param desired Desired gain in each band (half the length of bands). For differentiators, this is the slope of the amplitude response with respect to the angular frequency (1 for an ideal differentiator).
+	/// @param weight Relative weight of each band (half the length of bands). Default: all bands have the same weight.
+	/// @param fs Sampling frequency. Default: 1 (i.e., 0.5 is the Nyquist frequency).
+	/// @param type Type of the filter: bandpass (symmetric impulse response), differentiator or hilbert (anti-symmetric impulse response).
+	/// @param maxiter Maximum number of iterations of the exchange algorithm.
+	/// @param grid_density Density of the frequency grid (number of grid points per extremum).
+	/// @return Filter coefficients of length numtaps.
+	template<class T>
+	std::vector<T> remez(unsigned numtaps, const std::vector<T>& bands, const std::vector<T>& desired,
+		const std::vector<T>& weight = {}, T fs = 1, remez_type type = remez_type::bandpass,
+		unsigned maxiter = 25, unsigned grid_density = 16);
+
+	/// @brief Available FIR design methods
+	enum class fir_method { firwin, firls, remez };
+
+	/// @brief Complete specification of a FIR filter design.
+	///
+	/// A specification is the key into the coefficient cache of firdesign(), so equal specifications share their coefficients.
+	/// @tparam T Data type of the coefficients
+	template<class T>
+	struct FirSpec
+	{
+		fir_method method{ fir_method::firwin };  //!< Design method
+		unsigned numtaps{ 0 };  //!< Length of the filter
+		std::vector<T> bands;  //!< Cutoff frequencies (firwin) or band edges (firls, remez)
+		std::vector<T> desired;  //!< Desired gains at the band edges (firls) or per band (remez)
+		std::vector<T> weight;  //!< Relative weight per band (firls, remez)
+		remez_type remezType{ remez_type::bandpass };  //!< Filter type (remez only)
+		bool pass_zero{ true };  //!< Whether the DC gain is 1 (firwin only)
+		window::type windowType{ window::type::hamming };  //!< Window (firwin only)
+		std::vector<T> windowParameters;  //!< Window parameters (firwin only)
+		T fs{ 2 };  //!< Sampling frequency
+	};
+
+	/// @brief Strict weak ordering of FIR specifications (needed for the coefficient cache)
+	template<class T>
+	bool operator<(const FirSpec<T>& lhs, const FirSpec<T>& rhs)
+	{
+		return std::tie(lhs.method, lhs.numtaps, lhs.bands, lhs.desired, lhs.weight, lhs.remezType, lhs.pass_zero, lhs.windowType, lhs.windowParameters, lhs.fs)
+			< std::tie(rhs.method, rhs.numtaps, rhs.bands, rhs.desired, rhs.weight, rhs.remezType, rhs.pass_zero, rhs.windowType, rhs.windowParameters, rhs.fs);
+	}
+
+	/// @brief Returns the coefficients of the FIR filter described by spec.
+	///
+	/// Each specification is designed only once: The coefficients are cached and looked up on subsequent calls, so
+	/// switching between a set of precomputed filters at runtime costs a map lookup. This function is thread-safe.
+	/// @tparam T Data type of the coefficients
+	/// @param spec Specification of the filter
+	/// @return Reference to the cached coefficients. It stays valid until clearFirDesignCache() is called.
+	template<class T>
+	const std::vector<T>& firdesign(const FirSpec<T>& spec);
+
+	/// @brief Removes all cached coefficient sets of firdesign().
+	template<class T>
+	void clearFirDesignCache();
+
+	/*
+	 * IIR filter design
+	 */
+
+	/// @brief A filter represented by its zeros, poles and gain
+	/// @tparam T Data type of the real and imaginary parts
+	template<class T>
+	struct ZeroPoleGain
+	{
+		std::vector<std::complex<T>> zeros;  //!< Zeros of the transfer function
+		std::vector<std::complex<T>> poles;  //!< Poles of the transfer function
+		T gain{ 1 };  //!< System gain
+	};
+
+	/// @brief A cascade of second-order sections (biquads). Each section holds the coefficients {b0, b1, b2, a0, a1, a2}.
+	template<class T>
+	using SecondOrderSections = std::vector<std::array<T, 6>>;
+
+	/// @brief Frequency response types of IIR filters
+	enum class filter_type { lowpass, highpass, bandpass, bandstop };
+
+	/// @brief Available IIR filter families
+	enum class iir_type { butter, cheby1, cheby2, ellip };
+
+	/// @brief Returns the zeros, poles and gain of an analog Butterworth lowpass prototype of order N (cutoff at 1 rad/s).
+	template<class T>
+	ZeroPoleGain<T> buttap(unsigned N);
+
+	/// @brief Returns the zeros, poles and gain of an analog Chebyshev type I lowpass prototype of order N.
+	/// @param N Filter order
+	/// @param rp Maximum ripple in the passband (in dB). The passband ends at 1 rad/s.
+	template<class T>
+	ZeroPoleGain<T> cheb1ap(unsigned N, T rp);
+
+	/// @brief Returns the zeros, poles and gain of an analog Chebyshev type II lowpass prototype of order N.
+	/// @param N Filter order
+	/// @param rs Minimum attenuation in the stopband (in dB). The stopband starts at 1 rad/s.
+	template<class T>
+	ZeroPoleGain<T> cheb2ap(unsigned N, T rs);
+
+	/// @brief Returns the zeros, poles and gain of an analog elliptic (Cauer) lowpass prototype of order N.
+	/// @param N Filter order
+	/// @param rp Maximum ripple in the passband (in dB). The passband ends at 1 rad/s.
+	/// @param rs Minimum attenuation in the stopband (in dB).
+	template<class T>
+	ZeroPoleGain<T> ellipap(unsigned N, T rp, T rs);
+
+	/// @brief Transforms an analog lowpass prototype to a lowpass filter with cutoff frequency wo (in rad/s).
+	template<class T>
+	ZeroPoleGain<T> lp2lp_zpk(const ZeroPoleGain<T>& prototype, T wo);
+
+	/// @brief Transforms an analog lowpass prototype to a highpass filter with cutoff frequency wo (in rad/s).
+	template<class T>
+	ZeroPoleGain<T> lp2hp_zpk(const ZeroPoleGain<T>& prototype, T wo);
+
+	/// @brief Transforms an analog lowpass prototype to a bandpass filter with center frequency wo and bandwidth bw (in rad/s).
+	template<class T>
+	ZeroPoleGain<T> lp2bp_zpk(const ZeroPoleGain<T>& prototype, T wo, T bw);
+
+	/// @brief Transforms an analog lowpass prototype to a bandstop filter with center frequency wo and bandwidth bw (in rad/s).
+	template<class T>
+	ZeroPoleGain<T> lp2bs_zpk(const ZeroPoleGain<T>& prototype, T wo, T bw);
+
+	/// @brief Transforms an analog filter into a digital filter using the bilinear transform.
+	/// @param analog Zeros, poles and gain of the analog filter
+	/// @param fs Sampling frequency of the digital filter
+	/// @return Zeros, poles and gain of the digital filter
+	template<class T>
+	ZeroPoleGain<T> bilinear_zpk(const ZeroPoleGain<T>& analog, T fs);
+
+	/// @brief Converts a digital filter from zeros, poles and gain to second-order sections.
+	///
+	/// Poles closest to the unit circle are paired with their nearest zeros and placed in the last sections, which keeps the
+	/// intermediate signals small and the cascade numerically robust (also in single precision).
+	/// @param zpk Zeros, poles and gain of the digital filter. Complex zeros and poles must come in conjugate pairs.
+	/// @return The second-order sections. The gain is applied in the first section.
+	template<class T>
+	SecondOrderSections<T> zpk2sos(const ZeroPoleGain<T>& zpk);
+
+	/// @brief Designs a digital IIR filter and returns it as second-order sections.
+	///
+	/// The design (analog prototype, frequency transformation, bilinear transform, and pairing) is done in extended
+	/// precision, so the coefficients are rounded to T only once per section.
+	/// @tparam T Data type of the coefficients
+	/// @param N Order of the filter (bandpass and bandstop filters have order 2N)
+	/// @param Wn Critical frequency (lowpass, highpass) or pair of band edges (bandpass, bandstop), in the same unit as fs.
+	/// @param btype Type of the filter
+	/// @param ftype Filter family
+	/// @param rp Maximum passband ripple in dB (Chebyshev type I and elliptic only)
+	/// @param rs Minimum stopband attenuation in dB (Chebyshev type II and elliptic only)
+	/// @param fs Sampling frequency. Default: 2 (i.e., 1 is the Nyquist frequency).
+	/// @return The second-order sections, ready for sosfilt() or SosFilter.
+	template<class T>
+	SecondOrderSections<T> iirfilter(unsigned N, const std::vector<T>& Wn, filter_type btype = filter_type::lowpass,
+		iir_type ftype = iir_type::butter, T rp = 0, T rs = 0, T fs = 2);
+
+	/// @brief Designs a digital Butterworth filter (maximally flat passband). See iirfilter() for the parameters.
+	template<class T>
+	SecondOrderSections<T> butter(unsigned N, const std::vector<T>& Wn, filter_type btype = filter_type::lowpass, T fs = 2)
+	{
+		return iirfilter<T>(N, Wn, btype, iir_type::butter, 0, 0, fs);
+	}
+
+	/// @brief Designs a digital Chebyshev type I filter (equiripple passband). See iirfilter() for the parameters.
+	template<class T>
+	SecondOrderSections<T> cheby1(unsigned N, T rp, const std::vector<T>& Wn, filter_type btype = filter_type::lowpass, T fs = 2)
+	{
+		return iirfilter<T>(N, Wn, btype, iir_type::cheby1, rp, 0, fs);
+	}
+
+	/// @brief Designs a digital Chebyshev type II filter (equiripple stopband). See iirfilter() for the parameters.
+	template<class T>
+	SecondOrderSections<T> cheby2(unsigned N, T rs, const std::vector<T>& Wn, filter_type btype = filter_type::lowpass, T fs = 2)
+	{
+		return iirfilter<T>(N, Wn, btype, iir_type::cheby2, 0, rs, fs);
+	}
+
+	/// @brief Designs a digital elliptic (Cauer) filter (equiripple passband and stopband). See iirfilter() for the parameters.
+	template<class T>
+	SecondOrderSections<T> ellip(unsigned N, T rp, T rs, const std::vector<T>& Wn, filter_type btype = filter_type::lowpass, T fs = 2)
+	{
+		return iirfilter<T>(N, Wn, btype, iir_type::ellip, rp, rs, fs);
+	}
+
+	/// @brief Stateful cascade of second-order sections (transposed direct form II) for block-wise processing of streams.
+	/// @tparam T Data type of the samples and coefficients
+	template<class T>
+	class SosFilter
+	{
+	public:
+		explicit SosFilter(const SecondOrderSections<T>& sos);
+
+		/// @brief Filters a block of samples. The state is carried over to the next call. In-place operation (in == out) is allowed.
+		void process(const T* in, T* out, size_t n);
+
+		/// @brief Filters a block of PCM samples, converting them to floating point while the first section reads them.
+		/// @tparam P PCM sample type (pcm::int16, pcm::int24, or pcm::int32)
+		template<class P, std::enable_if_t<pcm::is_pcm_v<P>, int> = 0>
+		void process(const P* in, T* out, size_t n);
+
+		/// @brief Filters a block of samples and returns the result.
+		std::vector<T> process(const std::vector<T>& x);
+
+		/// @brief Clears the internal state (as if the filter had only seen zeros).
+		void reset();
+
+	private:
+		// Runs section s over n samples, where load(i) returns input sample i
+		template<class Load>
+		void runSection(size_t s, Load load, T* out, size_t n);
+
+		std::vector<std::array<T, 5>> coefficients_;  //!< {b0, b1, b2, a1, a2} of each section, normalized by a0
+		std::vector<std::array<T, 2>> state_;  //!< Delay elements of each section
+	};
+
+	/// @brief Filters the input data x with a cascade of second-order sections.
+	/// @param sos The second-order sections, e.g., as returned by iirfilter()
+	/// @param x Input signal
+	/// @return Filtered signal
+	template<class T>
+	std::vector<T> sosfilt(const SecondOrderSections<T>& sos, const std::vector<T>& x);
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "MultiSignal.h"
+#include "pcm.h"
+#include "SignalView.h"
+
+/// @brief Reading and writing of audio files (WAV, RF64, and headerless raw PCM).
+///
+/// AudioReader and AudioWriter stream interleaved frames in chunks of any size, so that recordings of any length can
+/// be processed with a bounded amount of memory. MappedAudioFile maps a file into memory and returns views of its
+/// samples without reading or copying them. Samples are stored little endian, as in WAV files.
+///
+///		dsp::io::AudioReader reader("recording.wav");
+///		dsp::MultiSignal<float> block(reader.format().samplingRate_Hz, reader.format().numChannels, 4096);
+///		while (reader.read(block) > 0) { ... }
+namespace dsp::io
+{
+	/// @brief Encoding of the samples in a file
+	enum class sample_format { pcm16, pcm24, pcm32, float32, float64 };
+
+	/// @brief Returns the number of bytes of one sample of the given format
+	size_t bytesPerSample(sample_format format);
+
+	/// @brief Container of the samples
+	enum class container
+	{
+		wav,  //!< RIFF/WAVE, switched to RF64 on closing if the file exceeds 4 GiB
+		rf64,  //!< RF64 (EBU Tech 3306), the 64-bit extension of WAV
+		raw  //!< Headerless interleaved samples
+	};
+
+	/// @brief Sampling rate, number of channels, and sample encoding of a file
+	struct AudioFormat
+	{
+		unsigned samplingRate_Hz{ 0 };
+		unsigned numChannels{ 1 };
+		sample_format format{ sample_format::pcm16 };
+
+		/// @brief Returns the number of bytes of one frame (one sample per channel)
+		size_t bytesPerFrame() const { return numChannels * bytesPerSample(format); }
+	};
+
+	/// @brief Streaming reader of interleaved frames, converting the samples to floating point chunk by chunk
+	class AudioReader
+	{
+	public:
+		/// @brief Opens a WAV or RF64 file
+		explicit AudioReader(const std::string& path);
+
+		/// @brief Opens a headerless raw file whose samples start after headerBytes bytes
+		AudioReader(const std::string& path, const AudioFormat& rawFormat, size_t headerBytes = 0);
+
+		const AudioFormat& format() const { return format_; }
+
+		/// @brief Returns the number of frames in the file
+		size_t numFrames() const { return numFrames_; }
+
+		/// @brief Returns the index of the next frame to be read
+		size_t position() const { return position_; }
+
+		/// @brief Moves to the given frame
+		void seek(size_t frame);
+
+		/// @brief Reads up to numFrames interleaved frames and converts them to T (normalized to [-1, 1) for PCM files)
+		/// @return The number of frames read (0 at the end of the file)
+		template<class T>
+		size_t read(T* interleaved, size_t numFrames);
+
+		/// @brief Reads up to block.numFrames() frames into block, in its layout. Frames past the end of the file are set to zero.
+		/// @return The number of frames read (0 at the end of the file)
+		template<class T>
+		size_t read(MultiSignal<T>& block);
+
+		/// @brief Reads all remaining frames
+		template<class T>
+		MultiSignal<T> readAll(ChannelLayout layout = ChannelLayout::planar);
+
+	private:
+		std::ifstream file_;
+		AudioFormat format_;
+		std::uint64_t dataOffset_{ 0 };
+		size_t numFrames_{ 0 };
+		size_t position_{ 0 };
+		std::vector<char> buffer_;  //!< Encoded samples of the current chunk
+	};
+
+	/// @brief Streaming writer of interleaved frames, converting the samples from floating point chunk by chunk.
+	///
+	/// The header is completed when the writer is closed or destroyed.
+	class AudioWriter
+	{
+	public:
+		AudioWriter(const std::string& path, const AudioFormat& format, container type = container::wav);
+		AudioWriter(const AudioWriter&) = delete;
+		AudioWriter& operator=(const AudioWriter&) = delete;
+		~AudioWriter();
+
+		const AudioFormat& format() const { return format_; }
+
+		/// @brief Returns the number of frames written so far
+		size_t numFrames() const { return numFrames_; }
+
+		/// @brief Writes numFrames interleaved frames. Samples outside [-1, 1) are clipped for PCM formats.
+		/// @param dither Dither generator for PCM formats, or nullptr for no dither
+		/// @return The number of clipped samples
+		template<class T>
+		size_t write(const T* interleaved, size_t numFrames, pcm::Dither* dither = nullptr);
+
+		/// @brief Writes all frames of block, which must have format().numChannels channels
+		/// @return The number of clipped samples
+		template<class T>
+		size_t write(const MultiSignal<T>& block, pcm::Dither* dither = nullptr);
+
+		/// @brief Completes the header and closes the file
+		void close();
+
+	private:
+		void writeHeader();
+
+		std::ofstream file_;
+		AudioFormat format_;
+		container container_;
+		size_t numFrames_{ 0 };
+		std::vector<char> buffer_;  //!< Encoded samples of the current chunk
+	};
+
+	/// @brief Read-only memory mapping of an audio file whose samples are accessed through views, without copying.
+	///
+	/// The operating system loads pages on demand and may evict them again, so even very large files can be processed
+	/// with a small resident set. Views are only valid while the MappedAudioFile exists.
+	///
+	///		dsp::io::MappedAudioFile file("array.wav");  // 32-bit float samples
+	///		auto left = file.channel<float>(0);
+	///		auto X = dsp::fft::rfft(left.subview(48000, 1024));
+	class MappedAudioFile
+	{
+	public:
+		/// @brief Maps a WAV or RF64 file
+		explicit MappedAudioFile(const std::string& path);
+
+		/// @brief Maps a headerless raw file whose samples start after headerBytes bytes
+		MappedAudioFile(const std::string& path, const AudioFormat& rawFormat, size_t headerBytes = 0);
+
+		MappedAudioFile(const MappedAudioFile&) = delete;
+		MappedAudioFile& operator=(const MappedAudioFile&) = delete;
+		MappedAudioFile(MappedAudioFile&& other) noexcept;
+		MappedAudioFile& operator=(MappedAudioFile&& other) noexcept;
+		~MappedAudioFile();
+
+		const AudioFormat& format() const { return format_; }
+		size_t numFrames() const { return numFrames_; }
+
+		/// @brief Returns a pointer to the first sample
+		const void* data() const { return data_; }
+
+		/// @brief Returns a view of all interleaved samples
+		/// @tparam T Sample type matching format().format: pcm::int16, pcm::int24, pcm::int32, float, or double
+		template<class T>
+		SignalView<T> samples() const;
+
+		/// @brief Returns a (strided) view of one channel
+		/// @tparam T Sample type matching format().format: pcm::int16, pcm::int24, pcm::int32, float, or double
+		template<class T>
+		SignalView<T> channel(unsigned channel) const;
+
+	private:
+		void map(const std::string& path);
+		void unmap();
+
+		AudioFormat format_;
+		size_t numFrames_{ 0 };
+		const unsigned char* mapping_{ nullptr };
+		size_t mappingSize_{ 0 };
+		const unsigned char* data_{ nullptr };
+#if defined(_WIN32)
+		void* fileHandle_{ nullptr };
+		void* mappingHandle_{ nullptr };
+#endif
+	};
+}
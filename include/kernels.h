@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+/// @brief Element-wise arithmetic and reduction kernels on contiguous memory
+///
+/// The kernels operate in place on raw pointers, so they can be used by Signal, by std::vector, and by any other
+/// contiguous buffer. Float and double buffers are processed with SSE2 or AVX instructions (whichever the library was
+/// compiled for); all other sample types use a four-fold unrolled loop that the compiler is free to vectorize.
+/// Buffers aligned to the register width (e.g., from AlignedAllocator, see allocators.h) use aligned loads and stores.
+/// x and y may point to the same buffer, but must not overlap otherwise.
+namespace dsp::kernels
+{
+	/// @brief Computes x[i] += y[i] for i in [0, n)
+	template<class T>
+	void plus(T* x, const T* y, size_t n);
+
+	/// @brief Computes x[i] += value for i in [0, n)
+	template<class T>
+	void plus(T* x, const T& value, size_t n);
+
+	/// @brief Computes x[i] -= y[i] for i in [0, n)
+	template<class T>
+	void minus(T* x, const T* y, size_t n);
+
+	/// @brief Computes x[i] -= value for i in [0, n)
+	template<class T>
+	void minus(T* x, const T& value, size_t n);
+
+	/// @brief Computes x[i] *= y[i] for i in [0, n)
+	template<class T>
+	void multiplies(T* x, const T* y, size_t n);
+
+	/// @brief Computes x[i] *= value for i in [0, n)
+	template<class T>
+	void multiplies(T* x, const T& value, size_t n);
+
+	/// @brief Computes x[i] /= y[i] for i in [0, n)
+	template<class T>
+	void divides(T* x, const T* y, size_t n);
+
+	/// @brief Computes x[i] /= value for i in [0, n)
+	template<class T>
+	void divides(T* x, const T& value, size_t n);
+
+	/// @brief Computes y[i] += a * x[i] for i in [0, n) (e.g., one tap of a direct convolution)
+	template<class T>
+	void multiplyAdd(T* y, const T* x, const T& a, size_t n);
+
+	/// @brief Interleaves the n samples of each of numChannels planar buffers: out[i * numChannels + c] = channels[c][i]
+	template<class T>
+	void interleave(const T* const* channels, size_t numChannels, T* out, size_t n);
+
+	/// @brief Splits n frames of interleaved samples into numChannels planar buffers: channels[c][i] = in[i * numChannels + c]
+	template<class T>
+	void deinterleave(const T* in, size_t numChannels, T* const* channels, size_t n);
+
+	/// @brief Summation algorithms of the reduction kernels, from fastest to most accurate
+	enum class summation_method
+	{
+		naive,  //!< Two interleaved running sums per SIMD lane. The error grows linearly with the number of samples.
+		pairwise,  //!< Sums of halves, down to blocks that are summed naively. The error grows with log(n), at nearly the speed of naive.
+		kahan,  //!< Compensated running sums. The error does not grow with the number of samples, at about half the speed.
+		widened  //!< Running sums of float samples in double precision (double and long double samples use kahan)
+	};
+
+	/// @brief Type in which the reduction kernels return their results (at least double), so that partial results can
+	/// be combined without rounding them to float first
+	template<class T>
+	using accumulator_t = std::common_type_t<T, double>;
+
+	/// @brief Returns the sum of x[i] for i in [0, n)
+	/// @tparam T float, double, or long double
+	template<class T>
+	accumulator_t<T> sum(const T* x, size_t n, summation_method method = summation_method::pairwise);
+
+	/// @brief Returns the sum of x[i]^2 for i in [0, n) (the energy of x)
+	/// @tparam T float, double, or long double
+	template<class T>
+	accumulator_t<T> sumOfSquares(const T* x, size_t n, summation_method method = summation_method::pairwise);
+
+	/// @brief Returns the name of the instruction set used for float and double buffers ("AVX", "SSE2", or "none")
+	const char* instructionSet();
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/// @brief Integer PCM sample types and their conversion to and from floating point
+///
+/// Floating-point samples are normalized to [-1, 1): a PCM sample s with B bits corresponds to s / 2^(B-1). Encoding
+/// scales, optionally dithers, rounds to the nearest integer, and saturates at the limits of the PCM type. Without
+/// dither, int16 and int32 buffers are converted with SSE2 instructions (when available).
+namespace dsp::pcm
+{
+	/// @brief 16-bit PCM sample
+	using int16 = std::int16_t;
+
+	/// @brief 32-bit PCM sample
+	using int32 = std::int32_t;
+
+	/// @brief Packed 24-bit PCM sample (three bytes, little endian), as stored in WAV files and delivered by most audio interfaces
+	struct int24
+	{
+		std::uint8_t bytes[3]{};
+
+		int24() = default;
+		int24(std::int32_t value)
+			: bytes{ static_cast<std::uint8_t>(value), static_cast<std::uint8_t>(value >> 8), static_cast<std::uint8_t>(value >> 16) } {}
+
+		/// @brief Returns the sign-extended value
+		operator std::int32_t() const
+		{
+			const auto u = static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) | (static_cast<std::uint32_t>(bytes[2]) << 16);
+			return static_cast<std::int32_t>(u << 8) >> 8;
+		}
+	};
+	static_assert(sizeof(int24) == 3, "int24 must be packed!");
+
+	/// @brief Number of bits and value range of the PCM sample types
+	template<class P>
+	struct traits;
+
+	template<>
+	struct traits<int16>
+	{
+		static constexpr int bits = 16;
+		static constexpr std::int32_t min = -32768;
+		static constexpr std::int32_t max = 32767;
+	};
+
+	template<>
+	struct traits<int24>
+	{
+		static constexpr int bits = 24;
+		static constexpr std::int32_t min = -8388608;
+		static constexpr std::int32_t max = 8388607;
+	};
+
+	template<>
+	struct traits<int32>
+	{
+		static constexpr int bits = 32;
+		static constexpr std::int32_t min = -2147483647 - 1;
+		static constexpr std::int32_t max = 2147483647;
+	};
+
+	/// @brief True for the PCM sample types int16, int24, and int32
+	template<class P, class = void>
+	struct is_pcm : std::false_type {};
+
+	template<class P>
+	struct is_pcm<P, std::void_t<decltype(traits<P>::bits)>> : std::true_type {};
+
+	template<class P>
+	constexpr bool is_pcm_v = is_pcm<P>::value;
+
+	/// @brief Types of dither that can be added before rounding to PCM
+	enum class dither_type { none, rectangular, triangular };
+
+	/// @brief Deterministic dither noise generator, with an amplitude in units of the least significant bit.
+	///
+	/// Keep one generator per stream and pass it to every encode() call, so that consecutive chunks get uncorrelated noise.
+	class Dither
+	{
+	public:
+		explicit Dither(dither_type type = dither_type::triangular, std::uint32_t seed = 0x9E3779B9u)
+			: type_(type), state_(seed != 0 ? seed : 1) {}
+
+		dither_type type() const { return type_; }
+
+		/// @brief Returns the next noise value: uniform in [-0.5, 0.5) (rectangular) or triangular in (-1, 1) (triangular)
+		double next()
+		{
+			switch (type_)
+			{
+			case dither_type::rectangular:
+				return uniform();
+			case dither_type::triangular:
+				return uniform() + uniform();
+			default:
+				return 0.0;
+			}
+		}
+
+	private:
+		// xorshift32, uniform in [-0.5, 0.5)
+		double uniform()
+		{
+			state_ ^= state_ << 13;
+			state_ ^= state_ >> 17;
+			state_ ^= state_ << 5;
+			return state_ * (1.0 / 4294967296.0) - 0.5;
+		}
+
+		dither_type type_;
+		std::uint32_t state_;
+	};
+
+	/// @brief Converts one PCM sample to floating point
+	template<class T, class P>
+	T toFloat(const P& sample)
+	{
+		return static_cast<T>(static_cast<std::int32_t>(sample)) * static_cast<T>(1.0 / static_cast<double>(1LL << (traits<P>::bits - 1)));
+	}
+
+	/// @brief Converts n PCM samples to floating point
+	/// @tparam T float or double
+	/// @tparam P int16, int24, or int32
+	template<class T, class P>
+	void decode(const P* in, T* out, size_t n);
+
+	/// @brief Converts n floating-point samples to PCM
+	/// @tparam T float or double
+	/// @tparam P int16, int24, or int32
+	/// @param dither Dither generator, or nullptr for no dither
+	/// @return The number of samples that were clipped
+	template<class T, class P>
+	size_t encode(const T* in, P* out, size_t n, Dither* dither = nullptr);
+
+	/// @brief Returns the PCM samples of a vector converted to floating point
+	template<class T, class P>
+	std::vector<T> decode(const std::vector<P>& in)
+	{
+		std::vector<T> out(in.size());
+		decode(in.data(), out.data(), in.size());
+		return out;
+	}
+
+	/// @brief Returns the floating-point samples of a vector converted to PCM
+	template<class P, class T>
+	std::vector<P> encode(const std::vector<T>& in, Dither* dither = nullptr)
+	{
+		std::vector<P> out(in.size());
+		encode(in.data(), out.data(), in.size(), dither);
+		return out;
+	}
+}
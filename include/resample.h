@@ -0,0 +1,115 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Signal.h"
+#include "window.h"
+
+/// @brief Sampling rate conversion
+namespace dsp::resample
+{
+	/// @brief Polyphase decomposition of an anti-aliasing FIR filter for rational resampling by up/down.
+	/// @tparam T Data type of the filter coefficients
+	template<class T>
+	struct PolyphaseFilterBank
+	{
+		unsigned up{ 1 };  //!< Upsampling factor
+		unsigned down{ 1 };  //!< Downsampling factor
+		size_t phaseLength{ 0 };  //!< Number of taps per phase
+		size_t delay{ 0 };  //!< Number of leading output samples that belong to the filter's transient
+		std::vector<T> taps;  //!< up * phaseLength coefficients. Phase p is stored time-reversed in [p * phaseLength, (p + 1) * phaseLength).
+
+		/// @brief Builds the polyphase decomposition of the FIR filter h.
+		PolyphaseFilterBank(const std::vector<T>& h, unsigned up, unsigned down, size_t delay = 0);
+	};
+
+	/// @brief Upsamples, FIR-filters, and downsamples a signal.
+	///
+	/// The result is identical to inserting up - 1 zeros between the samples of x, filtering with h, and keeping every
+	/// down-th sample, but only the kept output samples are computed and no zeros are ever inserted.
+	/// @tparam T Data type of the samples
+	/// @param h FIR filter coefficients
+	/// @param x Input signal
+	/// @param up Upsampling factor
+	/// @param down Downsampling factor
+	/// @return The output signal of length ((x.size() - 1) * up + h.size() - 1) / down + 1
+	template<class T>
+	std::vector<T> upfirdn(const std::vector<T>& h, const std::vector<T>& x, unsigned up = 1, unsigned down = 1);
+
+	/// @brief Returns the (cached) polyphase filter bank used by resample_poly() and PolyphaseResampler.
+	///
+	/// The anti-aliasing filter is a windowed-sinc lowpass (see filter::firwin()) of length 20 * max(up, down) + 1 with its
+	/// cutoff at the lower of the two Nyquist frequencies. Banks are computed once per (up, down, window) and shared between threads.
+	/// @param up Upsampling factor (after reduction by the greatest common divisor)
+	/// @param down Downsampling factor (after reduction by the greatest common divisor)
+	/// @param windowType Window used to design the anti-aliasing filter
+	/// @param windowParameters Optional window parameters (e.g., beta for the Kaiser window)
+	template<class T>
+	std::shared_ptr<const PolyphaseFilterBank<T>> filterbank(unsigned up, unsigned down,
+		window::type windowType = window::type::hamming, const std::vector<T>& windowParameters = {});
+
+	/// @brief Removes all cached polyphase filter banks. Banks still in use by a resampler stay valid.
+	template<class T>
+	void clearFilterBankCache();
+
+	/// @brief Resamples x by the rational factor up/down using polyphase filtering.
+	///
+	/// The output has ceil(x.size() * up / down) samples and is aligned with the input (the filter delay is compensated).
+	/// @param x Input signal
+	/// @param up Upsampling factor
+	/// @param down Downsampling factor
+	/// @param windowType Window used to design the anti-aliasing filter
+	/// @param windowParameters Optional window parameters
+	/// @return The resampled signal
+	template<class T>
+	std::vector<T> resample_poly(const std::vector<T>& x, unsigned up, unsigned down,
+		window::type windowType = window::type::hamming, const std::vector<T>& windowParameters = {});
+
+	/// @brief Resamples a Signal by the rational factor up/down. The returned signal has the sampling rate samplingRate_Hz * up / down.
+	template<class T>
+	Signal<T> resample_poly(const Signal<T>& x, unsigned up, unsigned down,
+		window::type windowType = window::type::hamming, const std::vector<T>& windowParameters = {});
+
+	/// @brief Resamples a Signal to a new sampling rate (e.g., 44100 Hz to 16000 Hz) using resample_poly().
+	template<class T>
+	Signal<T> resample(const Signal<T>& x, unsigned newSamplingRate_Hz,
+		window::type windowType = window::type::hamming, const std::vector<T>& windowParameters = {});
+
+	/// @brief Stateful polyphase resampler for streams that arrive block by block.
+	///
+	/// Concatenating the outputs of all process() calls and the final flush() gives the same samples as resample_poly() on the whole stream.
+	/// @tparam T Data type of the samples
+	template<class T>
+	class PolyphaseResampler
+	{
+	public:
+		PolyphaseResampler(unsigned up, unsigned down,
+			window::type windowType = window::type::hamming, const std::vector<T>& windowParameters = {});
+
+		/// @brief Resamples a block of n input samples and appends the available output samples to out.
+		void process(const T* in, size_t n, std::vector<T>& out);
+
+		/// @brief Resamples a block of input samples and returns the available output samples.
+		std::vector<T> process(const std::vector<T>& x);
+
+		/// @brief Returns the output samples still held back by the filter delay and resets the resampler.
+		std::vector<T> flush();
+
+		/// @brief Resets the resampler to its initial state.
+		void reset();
+
+		/// @brief Returns the reduced upsampling factor.
+		unsigned getUp() const { return bank_->up; }
+
+		/// @brief Returns the reduced downsampling factor.
+		unsigned getDown() const { return bank_->down; }
+
+	private:
+		std::shared_ptr<const PolyphaseFilterBank<T>> bank_;
+		std::vector<T> buffer_;  //!< The last phaseLength - 1 input samples followed by the current block
+		size_t inputCount_{ 0 };  //!< Number of input samples received since the last reset
+		size_t outputIndex_{ 0 };  //!< Index of the next output sample of the (delayed) filter output
+		size_t emitted_{ 0 };  //!< Number of output samples returned since the last reset
+	};
+}
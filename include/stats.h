@@ -1,10 +1,24 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <numeric>
-#include <unordered_set>
-#include <unordered_map>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "execution.h"
+#include "MultiSignal.h"
 #include "Signal.h"
+#include "SignalView.h"
+#include "utilities.h"
 
 namespace dsp
 {
@@ -13,12 +27,30 @@ namespace dsp
 	/// @tparam InputIt Iterator type.
 	/// @param begin Start of the range.
 	/// @param end End of the range.
+	/// @param context Parallel execution of long ranges. In parallel, chunks are summed separately and their sums are added in order.
 	/// @return Mean value of the range.
 	template<class T, class InputIt>
-	T mean(InputIt begin, InputIt end)
+	T mean(InputIt begin, InputIt end, const ExecutionContext& context = {})
 	{
+		const auto n = std::distance(begin, end);
+		if constexpr (detail::is_random_access_v<InputIt>)
+		{
+			if (context.reproducible)
+			{
+				const auto sum = detail::reduceTree<T>(static_cast<size_t>(n), context,
+					[&](size_t lo, size_t hi) { return std::accumulate(begin + static_cast<std::ptrdiff_t>(lo), begin + static_cast<std::ptrdiff_t>(hi), T(0)); });
+				return sum / n;
+			}
+			if (context.runsInParallel(static_cast<size_t>(n)))
+			{
+				const auto sum = detail::reduceChunks(static_cast<size_t>(n), context.grainSize, context, T(0),
+					[&](size_t lo, size_t hi) { return std::accumulate(begin + static_cast<std::ptrdiff_t>(lo), begin + static_cast<std::ptrdiff_t>(hi), T(0)); },
+					std::plus<T>());
+				return sum / n;
+			}
+		}
 		auto sum = std::accumulate(begin, end, T(0));
-		return sum / std::distance(begin, end);
+		return sum / n;
 	}
 	
 	/// @brief Returns the mean value of a vector
@@ -26,9 +58,9 @@ namespace dsp
 	/// @param x Vector to calculate the mean of.
 	/// @return Mean value of the vector.
 	template<class T>
-	T mean(const std::vector<T>& x)
+	T mean(const std::vector<T>& x, const ExecutionContext& context = {})
 	{
-		return mean<T>(x.begin(), x.end());
+		return mean<T>(x.begin(), x.end(), context);
 	}
 
 	/// @brief Returns the mean value of a signal
@@ -36,67 +68,545 @@ namespace dsp
 	/// @param x Signal to calculate the mean of.
 	/// @return Mean value of the signal.
 	template<class T>
-	T mean(const Signal<T>& x)
+	T mean(const Signal<T>& x, const ExecutionContext& context = {})
+	{
+		return mean<T>(x.begin(), x.end(), context);
+	}
+
+	/// @brief Returns the mean value of a view (e.g., of memory-mapped or strided samples)
+	template<class T>
+	T mean(SignalView<T> x, const ExecutionContext& context = {})
+	{
+		return mean<T>(x.begin(), x.end(), context);
+	}
+
+	/// @brief Returns the mean value of contiguous samples, summed with the given algorithm
+	/// @tparam T float, double, or long double
+	/// @param method Summation algorithm (see kernels::summation_method)
+	/// @param context Parallel execution of long ranges. Each chunk is summed with method and the sums are added in order.
+	template<class T>
+	T mean(const T* x, size_t n, kernels::summation_method method, const ExecutionContext& context = {})
+	{
+		static_assert(detail::has_reduction_kernel_v<T>, "Summation methods are only available for float, double, and long double!");
+		const auto sum = detail::reduceSum<kernels::accumulator_t<T>>(n, context,
+			[x, method](size_t lo, size_t hi) { return kernels::sum(x + lo, hi - lo, method); });
+		return static_cast<T>(sum / static_cast<kernels::accumulator_t<T>>(n));
+	}
+
+	/// @brief Returns the mean value of a vector, summed with the given algorithm
+	template<class T>
+	T mean(const std::vector<T>& x, kernels::summation_method method, const ExecutionContext& context = {})
+	{
+		return mean(x.data(), x.size(), method, context);
+	}
+
+	/// @brief Returns the mean value of a signal, summed with the given algorithm
+	template<class T>
+	T mean(const Signal<T>& x, kernels::summation_method method, const ExecutionContext& context = {})
 	{
-		return mean<T>(x.begin(), x.end());
+		return mean(x.data(), x.size(), method, context);
 	}
 
-	/// @brief Returns the median of a range
+	/// @brief Returns the mean value of a view, summed with the given algorithm. Strided views are copied once.
+	template<class T>
+	T mean(SignalView<T> x, kernels::summation_method method, const ExecutionContext& context = {})
+	{
+		if (const T* data = detail::contiguousData<T>(x)) return mean(data, x.size(), method, context);
+		const auto samples = x.toVector();
+		return mean(samples.data(), samples.size(), method, context);
+	}
+
+	/// @brief Returns the mean value of each channel
+	template<class T>
+	std::vector<T> mean(const MultiSignal<T>& x)
+	{
+		return x.mapChannels([](SignalView<T> channel) { return mean(channel); });
+	}
+
+	/// @cond developer-only
+	namespace detail
+	{
+		// Number of evenly spaced samples from which the pivots of a parallel partition are selected
+		constexpr size_t selectionPivotSamples = 4095;
+
+		// Partitions data[lo, hi) into the samples below p1, those in [p1, p2], and those above p2, on the pool of the
+		// context. Every chunk counts its samples of each part, so that the prefix sums of the counts give the position
+		// of every sample in scratch[lo, hi); then the chunks scatter their samples there and copy the result back.
+		// Returns the bounds [a, b) of the middle part.
+		template<class T>
+		std::pair<size_t, size_t> partitionParallel(T* data, size_t lo, size_t hi, T p1, T p2, const ExecutionContext& context, T* scratch)
+		{
+			const auto n = hi - lo;
+			const auto chunkSize = std::max<size_t>(context.grainSize, 1);
+			const auto part = [&](const T& x) { return x < p1 ? 0 : (p2 < x ? 2 : 1); };
+
+			std::vector<std::array<size_t, 3>> positions((n + chunkSize - 1) / chunkSize);
+			forEachChunk(n, chunkSize, context, [&](size_t first, size_t last)
+				{
+					std::array<size_t, 3> counts{};
+					for (auto i = lo + first; i < lo + last; ++i) { ++counts[part(data[i])]; }
+					positions[first / chunkSize] = counts;
+				});
+
+			// Exclusive prefix sums in the order of the parts, then of the chunks
+			size_t position = lo;
+			for (size_t k = 0; k < 3; ++k)
+			{
+				for (auto& counts : positions)
+				{
+					const auto count = counts[k];
+					counts[k] = position;
+					position += count;
+				}
+			}
+			const std::pair<size_t, size_t> middle{ positions.front()[1], positions.front()[2] };
+
+			forEachChunk(n, chunkSize, context, [&](size_t first, size_t last)
+				{
+					auto next = positions[first / chunkSize];
+					for (auto i = lo + first; i < lo + last; ++i) { scratch[next[part(data[i])]++] = data[i]; }
+				});
+			forEachChunk(n, chunkSize, context, [&](size_t first, size_t last)
+				{
+					std::copy(scratch + lo + first, scratch + lo + last, data + lo + first);
+				});
+			return middle;
+		}
+
+		// Moves the elements with the sorted, unique ranks [rank, rankEnd) to their sorted positions in data[lo, hi).
+		// Selecting the middle rank first splits the remaining ranks between the two partitions, so that m ranks take
+		// O(n log m) instead of O(n m) time.
+		//
+		// Ranges that the context runs in parallel are partitioned on its pool around two pivots from a sample, chosen
+		// just below and just above the middle rank (as in the Floyd-Rivest algorithm). The middle part is then small
+		// and very likely contains the middle rank; the ranks of each part are selected recursively. scratch must hold
+		// hi samples if the context runs [lo, hi) in parallel.
+		template<class T>
+		void selectRanks(T* data, size_t lo, size_t hi, const size_t* rank, const size_t* rankEnd, const ExecutionContext& context, T* scratch)
+		{
+			if (rank == rankEnd || lo >= hi) return;
+
+			const auto middle = rank + (rankEnd - rank) / 2;
+			const auto n = hi - lo;
+			if (context.runsInParallel(n) && n > selectionPivotSamples)
+			{
+				std::vector<T> sample(selectionPivotSamples);
+				for (size_t i = 0; i < sample.size(); ++i)
+				{
+					sample[i] = data[lo + i * n / sample.size()];
+				}
+
+				// Three standard errors of the sampled quantile on either side of it
+				const auto last = static_cast<double>(sample.size() - 1);
+				const auto f = static_cast<double>(*middle - lo) / static_cast<double>(n - 1);
+				const auto spread = 1.5 / std::sqrt(static_cast<double>(sample.size()));
+				const auto k1 = static_cast<size_t>(std::floor(std::max(0.0, f - spread) * last));
+				const auto k2 = static_cast<size_t>(std::ceil(std::min(1.0, f + spread) * last));
+				std::nth_element(sample.begin(), sample.begin() + static_cast<std::ptrdiff_t>(k1), sample.end());
+				std::nth_element(sample.begin() + static_cast<std::ptrdiff_t>(k1), sample.begin() + static_cast<std::ptrdiff_t>(k2), sample.end());
+				const T p1 = sample[k1];
+				const T p2 = sample[k2];
+
+				const auto [a, b] = partitionParallel(data, lo, hi, p1, p2, context, scratch);
+				const bool constantMiddle = !(p1 < p2);
+				if (a > lo || b < hi || constantMiddle)
+				{
+					// The samples of a constant middle part are all at their sorted positions
+					const auto r1 = std::lower_bound(rank, rankEnd, a);
+					const auto r2 = std::lower_bound(r1, rankEnd, b);
+					selectRanks(data, lo, a, rank, r1, context, scratch);
+					if (!constantMiddle) selectRanks(data, a, b, r1, r2, context, scratch);
+					selectRanks(data, b, hi, r2, rankEnd, context, scratch);
+					return;
+				}
+				// All samples lie between the pivots (very few distinct values), which the sequential selection handles
+			}
+
+			std::nth_element(data + lo, data + *middle, data + hi);
+			const auto sequential = ExecutionContext::sequential();
+			selectRanks(data, lo, *middle, rank, middle, sequential, scratch);
+			selectRanks(data, *middle + 1, hi, middle + 1, rankEnd, sequential, scratch);
+		}
+
+		// Selects the sorted, unique ranks [rank, rankEnd) of data[0, n), with a scratch buffer for parallel partitions
+		template<class T>
+		void selectRanks(T* data, size_t n, const size_t* rank, const size_t* rankEnd, const ExecutionContext& context)
+		{
+			std::unique_ptr<T[]> scratch;
+			if (context.runsInParallel(n))
+			{
+				scratch.reset(new T[n]);
+			}
+			selectRanks(data, 0, n, rank, rankEnd, context, scratch.get());
+		}
+
+		// Returns a scratch copy of a range, converted to T (in parallel chunks if the context says so)
+		template<class T, class InputIt>
+		std::vector<T> selectionCopy(InputIt begin, InputIt end, const ExecutionContext& context)
+		{
+			std::vector<T> data;
+			using category = typename std::iterator_traits<InputIt>::iterator_category;
+			if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>)
+			{
+				data.resize(static_cast<size_t>(std::distance(begin, end)));
+				forEachChunk(data.size(), context.grainSize, context,
+					[&](size_t lo, size_t hi) { std::copy(begin + static_cast<std::ptrdiff_t>(lo), begin + static_cast<std::ptrdiff_t>(hi), data.begin() + static_cast<std::ptrdiff_t>(lo)); });
+			}
+			else
+			{
+				data.assign(begin, end);
+			}
+			if (data.empty())
+			{
+				throw std::invalid_argument("Cannot compute order statistics of an empty range!");
+			}
+			return data;
+		}
+	}
+	/// @endcond
+
+	/// @brief Returns the quantiles of a range, interpolated linearly between the closest ranks (as numpy.quantile()).
+	///
+	/// All quantiles are selected from one scratch copy of the range in expected O(n log m) time for m quantiles,
+	/// without sorting it. With a parallel context, long ranges are copied and partitioned on the pool of the context.
+	/// The result does not depend on the context.
 	/// @tparam T Type of the samples. Should be float, double, or long double. Other types may cause undefined behavior.
 	/// @tparam InputIt Iterator type
 	/// @param begin Start of the range
 	/// @param end End of the range
-	/// @return The median value of the range
+	/// @param q Quantiles to compute, each in [0, 1]
+	/// @param context Execution policy and pool of the copy and the partitions
+	/// @return The quantiles in the order of q
 	template<class T, class InputIt>
-	T median(InputIt begin, InputIt end)
+	std::vector<T> quantiles(InputIt begin, InputIt end, const std::vector<double>& q, const ExecutionContext& context = {})
 	{
-		std::vector<T> tmp(std::distance(begin, end) / 2 + 1);
-		std::partial_sort_copy(begin, end, tmp.begin(), tmp.end());
-		if (std::distance(begin, end) % 2)
+		if (std::any_of(q.begin(), q.end(), [](double p) { return !(p >= 0.0 && p <= 1.0); }))
+		{
+			throw std::invalid_argument("Quantiles must be between 0 and 1!");
+		}
+		auto data = detail::selectionCopy<T>(begin, end, context);
+		const auto n = data.size();
+
+		// Each quantile lies between the ranks floor(h) and ceil(h), where h = (n - 1) q
+		std::vector<size_t> ranks;
+		ranks.reserve(2 * q.size());
+		for (auto p : q)
+		{
+			const auto h = p * static_cast<double>(n - 1);
+			ranks.push_back(static_cast<size_t>(std::floor(h)));
+			ranks.push_back(std::min(n - 1, static_cast<size_t>(std::ceil(h))));
+		}
+		std::sort(ranks.begin(), ranks.end());
+		ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+		detail::selectRanks(data.data(), n, ranks.data(), ranks.data() + ranks.size(), context);
+
+		std::vector<T> result;
+		result.reserve(q.size());
+		for (auto p : q)
 		{
-			return tmp.back();
+			const auto h = p * static_cast<double>(n - 1);
+			const auto lo = static_cast<size_t>(std::floor(h));
+			const auto hi = std::min(n - 1, static_cast<size_t>(std::ceil(h)));
+			const auto fraction = h - static_cast<double>(lo);
+			result.push_back(fraction == 0.0 ? data[lo] : static_cast<T>(data[lo] + fraction * (data[hi] - data[lo])));
 		}
-		return static_cast<T>((tmp[tmp.size() - 1] + tmp[tmp.size() - 2]) / 2.0);
+		return result;
+	}
+
+	/// @brief Returns the quantiles of a container (see quantiles() for ranges)
+	/// @tparam T Type of container. Should be std::vector, dsp::Signal, or dsp::SignalView. Other containers may cause undefined behavior.
+	template<class T>
+	std::vector<typename T::value_type> quantiles(const T& x, const std::vector<double>& q, const ExecutionContext& context = {})
+	{
+		return quantiles<typename T::value_type>(x.begin(), x.end(), q, context);
+	}
+
+	/// @brief Returns the q-th quantile of a range, interpolated linearly between the closest ranks (as numpy.quantile())
+	/// @tparam T Type of the samples. Should be float, double, or long double. Other types may cause undefined behavior.
+	/// @param q Quantile in [0, 1]
+	template<class T, class InputIt>
+	T quantile(InputIt begin, InputIt end, double q)
+	{
+		return quantiles<T>(begin, end, { q }).front();
+	}
+
+	/// @brief Returns the q-th quantile of a container, interpolated linearly between the closest ranks
+	/// @tparam T Type of container. Should be std::vector, dsp::Signal, or dsp::SignalView. Other containers may cause undefined behavior.
+	template<class T>
+	auto quantile(const T& x, double q)
+	{
+		return quantile<typename T::value_type>(x.begin(), x.end(), q);
+	}
+
+	/// @brief Returns the p-th percentile of a range (the quantile p / 100)
+	/// @tparam T Type of the samples. Should be float, double, or long double. Other types may cause undefined behavior.
+	/// @param p Percentile in [0, 100]
+	template<class T, class InputIt>
+	T percentile(InputIt begin, InputIt end, double p)
+	{
+		return quantile<T>(begin, end, p / 100.0);
+	}
+
+	/// @brief Returns the p-th percentile of a container (the quantile p / 100)
+	/// @tparam T Type of container. Should be std::vector, dsp::Signal, or dsp::SignalView. Other containers may cause undefined behavior.
+	template<class T>
+	auto percentile(const T& x, double p)
+	{
+		return percentile<typename T::value_type>(x.begin(), x.end(), p);
+	}
+
+	/// @brief Returns the median of a range in expected linear time
+	/// @tparam T Type of the samples. Should be float, double, or long double. Other types may cause undefined behavior.
+	/// @tparam InputIt Iterator type
+	/// @param begin Start of the range
+	/// @param end End of the range
+	/// @param context Execution policy and pool of the copy and the partitions (see quantiles())
+	/// @return The median value of the range (the mean of the two middle values for an even number of samples)
+	template<class T, class InputIt>
+	T median(InputIt begin, InputIt end, const ExecutionContext& context = {})
+	{
+		auto data = detail::selectionCopy<T>(begin, end, context);
+		const auto n = data.size();
+		const size_t ranks[] = { (n - 1) / 2, n / 2 };
+		detail::selectRanks(data.data(), n, ranks, ranks + (n % 2 ? 1 : 2), context);
+		if (n % 2)
+		{
+			return data[n / 2];
+		}
+		return static_cast<T>((data[n / 2 - 1] + data[n / 2]) / 2.0);
 	}
 
 	/// @brief Returns the median of a vector or Signal.
-	/// @tparam T Type of container. Should be std::vector or dsp::Signal. Other containers may cause undefined behavior.
+	/// @tparam T Type of container. Should be std::vector, dsp::Signal, or dsp::SignalView. Other containers may cause undefined behavior.
 	/// @param x Container to calculate the median of
+	/// @param context Execution policy and pool of the copy and the partitions (see quantiles())
 	/// @return The median of the container
 	template<class T>
-	auto median(const T& x)
+	auto median(const T& x, const ExecutionContext& context = {})
 	{
-		return median<typename T::value_type>(x.begin(), x.end());
+		return median<typename T::value_type>(x.begin(), x.end(), context);
 	}
 
-	/// @brief Returns the mode (most frequent element) of a range
-	/// @tparam T Type of the samples. Should be float, double, or long double. Other types may cause undefined behavior.
+	/// @brief Algorithms for counting the occurrences of distinct values in mode() and unique()
+	enum class counting_method
+	{
+		automatic,  //!< histogram for integers in a dense range (e.g., PCM samples), hash otherwise
+		histogram,  //!< One counter per value between the minimum and the maximum. Integer types only.
+		sort,  //!< Sorts a copy of the values. O(n log n) time, but no hashing.
+		hash  //!< Flat (open-addressing) hash map of the distinct values
+	};
+
+	/// @cond developer-only
+	namespace detail
+	{
+		// Integer ranges are histogrammed if the histogram is not much larger than the range itself
+		constexpr size_t histogramOverhead = 4;
+		constexpr size_t histogramMinBins = 1 << 16;
+
+		// Distinct values in the order of their first occurrence, and how often they occur
+		template<class T>
+		struct ValueCounts
+		{
+			std::vector<T> values;
+			std::vector<size_t> counts;
+		};
+
+		template<class T>
+		std::uint64_t hashValue(T x)
+		{
+			std::uint64_t bits;
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				// -0 and 0 compare equal and must have the same hash
+				const double d = x == T(0) ? 0.0 : static_cast<double>(x);
+				std::memcpy(&bits, &d, sizeof(bits));
+			}
+			else
+			{
+				bits = static_cast<std::uint64_t>(x);
+			}
+			// splitmix64 finalizer
+			bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+			bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+			return bits ^ (bits >> 31);
+		}
+
+		template<class T, class InputIt>
+		ValueCounts<T> countByHistogram(InputIt begin, InputIt end)
+		{
+			static_assert(std::is_integral_v<T>, "Histogram counting requires integer samples!");
+			ValueCounts<T> result;
+			if (begin == end) return result;
+
+			const auto [minIt, maxIt] = std::minmax_element(begin, end);
+			const auto offset = static_cast<std::uint64_t>(static_cast<T>(*minIt));
+			std::vector<size_t> histogram(static_cast<size_t>(static_cast<std::uint64_t>(static_cast<T>(*maxIt)) - offset) + 1, 0);
+			for (auto it = begin; it != end; ++it)
+			{
+				const T x = *it;
+				if (histogram[static_cast<size_t>(static_cast<std::uint64_t>(x) - offset)]++ == 0)
+				{
+					result.values.push_back(x);
+				}
+			}
+
+			result.counts.reserve(result.values.size());
+			for (const auto x : result.values)
+			{
+				result.counts.push_back(histogram[static_cast<size_t>(static_cast<std::uint64_t>(x) - offset)]);
+			}
+			return result;
+		}
+
+		template<class T, class InputIt>
+		ValueCounts<T> countByHash(InputIt begin, InputIt end)
+		{
+			ValueCounts<T> result;
+			// Slots hold the index of a distinct value plus one, or zero if they are empty
+			std::vector<size_t> slots(64, 0);
+			auto mask = slots.size() - 1;
+			for (auto it = begin; it != end; ++it)
+			{
+				const T x = *it;
+				auto slot = static_cast<size_t>(hashValue(x)) & mask;
+				while (slots[slot] != 0 && !(result.values[slots[slot] - 1] == x))
+				{
+					slot = (slot + 1) & mask;
+				}
+				if (slots[slot] != 0)
+				{
+					++result.counts[slots[slot] - 1];
+					continue;
+				}
+
+				result.values.push_back(x);
+				result.counts.push_back(1);
+				slots[slot] = result.values.size();
+				if (2 * result.values.size() > slots.size())
+				{
+					// Keep the load factor below one half
+					slots.assign(2 * slots.size(), 0);
+					mask = slots.size() - 1;
+					for (size_t i = 0; i < result.values.size(); ++i)
+					{
+						auto s = static_cast<size_t>(hashValue(result.values[i])) & mask;
+						while (slots[s] != 0) s = (s + 1) & mask;
+						slots[s] = i + 1;
+					}
+				}
+			}
+			return result;
+		}
+
+		template<class T, class InputIt>
+		ValueCounts<T> countBySort(InputIt begin, InputIt end)
+		{
+			// Sort (value, index) pairs, so that runs of equal values know their first occurrence
+			std::vector<std::pair<T, size_t>> sorted;
+			size_t index = 0;
+			for (auto it = begin; it != end; ++it)
+			{
+				sorted.emplace_back(*it, index++);
+			}
+			std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first || (!(b.first < a.first) && a.second < b.second); });
+
+			struct Run { size_t first; T value; size_t count; };
+			std::vector<Run> runs;
+			for (size_t i = 0; i < sorted.size();)
+			{
+				size_t j = i + 1;
+				while (j < sorted.size() && !(sorted[i].first < sorted[j].first)) ++j;
+				runs.push_back({ sorted[i].second, sorted[i].first, j - i });
+				i = j;
+			}
+			std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b) { return a.first < b.first; });
+
+			ValueCounts<T> result;
+			result.values.reserve(runs.size());
+			result.counts.reserve(runs.size());
+			for (const auto& run : runs)
+			{
+				result.values.push_back(run.value);
+				result.counts.push_back(run.count);
+			}
+			return result;
+		}
+
+		template<class T, class InputIt>
+		ValueCounts<T> countValues(InputIt begin, InputIt end, counting_method method)
+		{
+			if (method == counting_method::automatic)
+			{
+				method = counting_method::hash;
+				if constexpr (std::is_integral_v<T>)
+				{
+					if (begin != end)
+					{
+						const auto [minIt, maxIt] = std::minmax_element(begin, end);
+						const auto bins = static_cast<std::uint64_t>(static_cast<T>(*maxIt)) - static_cast<std::uint64_t>(static_cast<T>(*minIt));
+						const auto n = static_cast<std::uint64_t>(std::distance(begin, end));
+						if (bins < std::max<std::uint64_t>(histogramOverhead * n, histogramMinBins))
+						{
+							method = counting_method::histogram;
+						}
+					}
+				}
+			}
+
+			switch (method)
+			{
+			case counting_method::histogram:
+				if constexpr (std::is_integral_v<T>)
+				{
+					return countByHistogram<T>(begin, end);
+				}
+				else
+				{
+					throw std::invalid_argument("Histogram counting requires integer samples!");
+				}
+			case counting_method::sort:
+				return countBySort<T>(begin, end);
+			default:
+				return countByHash<T>(begin, end);
+			}
+		}
+	}
+	/// @endcond
+
+	/// @brief Returns the mode (most frequent element) of a range. Of several equally frequent elements, the smallest is returned.
+	/// @tparam T Type of the samples
 	/// @tparam InputIt Iterator type
 	/// @param begin Start of the range
 	/// @param end End of the range
+	/// @param method Algorithm used to count the elements. The default histograms quantized integer data (e.g., PCM
+	/// samples) in one pass over the samples and hashes everything else.
 	/// @return The mode of the range
 	template<class T, class InputIt>
-	T mode(InputIt begin, InputIt end)
+	T mode(InputIt begin, InputIt end, counting_method method = counting_method::automatic)
 	{
-		std::unordered_map<T, unsigned> count;
-		// Count the number of occurences of each element in the range
-		for(auto it = begin; it != end; ++it)
+		if (begin == end) { throw std::invalid_argument("Cannot compute the mode of an empty range!"); }
+
+		const auto counted = detail::countValues<T>(begin, end, method);
+		size_t best = 0;
+		for (size_t i = 1; i < counted.values.size(); ++i)
 		{
-			++count[*it];
+			if (counted.counts[i] > counted.counts[best] || (counted.counts[i] == counted.counts[best] && counted.values[i] < counted.values[best]))
+			{
+				best = i;
+			}
 		}
-
-		auto m_it = std::max_element(count.begin(), count.end(), [](auto lhs, auto rhs) { return lhs.second < rhs.second; });
-		return m_it->first;
+		return counted.values[best];
 	}
 
 	/// @brief Returns the mode of a vector or Signal.
-	/// @tparam T Type of container. Should be std::vector or dsp::Signal. Other containers may cause undefined behavior.
+	/// @tparam T Type of container. Should be std::vector, dsp::Signal, or dsp::SignalView. Other containers may cause undefined behavior.
 	/// @param x Container to calculate the mode of
+	/// @param method Algorithm used to count the elements
 	/// @return The mode of the container
 	template<class T>
-	auto mode(const T& x)
+	auto mode(const T& x, counting_method method = counting_method::automatic)
 	{
-		return mode<typename T::value_type>(x.begin(), x.end());
+		return mode<typename T::value_type>(x.begin(), x.end(), method);
 	}
 
 	/// @brief Returns the unique values in a range
@@ -104,44 +614,201 @@ namespace dsp
 	/// @tparam InputIt Iterator type
 	/// @param begin Start of the range
 	/// @param end End of the range
-	/// @return A vector containing the unique elements in the original order
+	/// @param method Algorithm used to find the unique elements
+	/// @return A vector containing the unique elements in the order of their first occurrence
 	template<class T, class InputIt>
-	std::vector<T> unique(InputIt begin, InputIt end)
+	std::vector<T> unique(InputIt begin, InputIt end, counting_method method = counting_method::automatic)
 	{
-		std::unordered_set s(begin, end);
-		return { s.begin(), s.end() };
+		return detail::countValues<T>(begin, end, method).values;
 	}
 
 	/// @brief Returns the unique values from a container
-	/// @tparam T Type of container. Should be std::vector or dsp::Signal. Other containers may cause undefined behavior.
+	/// @tparam T Type of container. Should be std::vector, dsp::Signal, or dsp::SignalView. Other containers may cause undefined behavior.
 	/// @param x Container holding the non-unique elements.
-	/// @return A vector containing the unique elements in the original order
+	/// @param method Algorithm used to find the unique elements
+	/// @return A vector containing the unique elements in the order of their first occurrence
 	template<class T>
-	std::vector<typename T::value_type> unique(const T& x)
+	std::vector<typename T::value_type> unique(const T& x, counting_method method = counting_method::automatic)
 	{
-		return unique<typename T::value_type>(x.begin(), x.end());
+		return unique<typename T::value_type>(x.begin(), x.end(), method);
 	}
 	
 	/// @brief Calculate the variance or standard deviation based on a sample or based on the population
 	enum class weight{sample, population};
 
+	/// @brief Running count, mean, and central moments (sums of powers of the deviations from the mean) of a sequence.
+	///
+	/// Samples are added one by one with Welford's update, and partial results of separate chunks are combined with
+	/// the pairwise update of Chan et al. (extended to the third and fourth moment by Pébay), so that the statistics of
+	/// a sequence are obtained in a single, numerically stable pass that can be split across threads.
+	/// @tparam T Type of the samples. Should be float, double, or long double.
+	/// @tparam Order Highest tracked moment: 2 (mean and variance) or 4 (also skewness and kurtosis)
+	template<class T, unsigned Order = 4>
+	class Moments
+	{
+		static_assert(Order == 2 || Order == 4, "Moments can track the second or the fourth order!");
+
+	public:
+		/// @brief Adds one sample
+		void push(T x)
+		{
+			const auto n1 = static_cast<T>(count_);
+			++count_;
+			const auto n = static_cast<T>(count_);
+			const auto delta = x - mean_;
+			const auto delta_n = delta / n;
+			const auto term1 = delta * delta_n * n1;
+			mean_ += delta_n;
+			if constexpr (Order == 4)
+			{
+				const auto delta_n2 = delta_n * delta_n;
+				m4_ += term1 * delta_n2 * (n * n - 3 * n + 3) + 6 * delta_n2 * m2_ - 4 * delta_n * m3_;
+				m3_ += term1 * delta_n * (n - 2) - 3 * delta_n * m2_;
+			}
+			m2_ += term1;
+		}
+
+		/// @brief Adds all samples that were added to other
+		void merge(const Moments& other)
+		{
+			if (other.count_ == 0) return;
+			if (count_ == 0)
+			{
+				*this = other;
+				return;
+			}
+
+			const auto na = static_cast<T>(count_);
+			const auto nb = static_cast<T>(other.count_);
+			const auto n = na + nb;
+			const auto delta = other.mean_ - mean_;
+			const auto delta_n = delta / n;
+			if constexpr (Order == 4)
+			{
+				const auto delta_n2 = delta_n * delta_n;
+				m4_ += other.m4_ + delta * delta_n * delta_n2 * na * nb * (na * na - na * nb + nb * nb)
+					+ 6 * delta_n2 * (na * na * other.m2_ + nb * nb * m2_) + 4 * delta_n * (na * other.m3_ - nb * m3_);
+				m3_ += other.m3_ + delta * delta_n2 * na * nb * (na - nb) + 3 * delta_n * (na * other.m2_ - nb * m2_);
+			}
+			m2_ += other.m2_ + delta * delta_n * na * nb;
+			mean_ += nb * delta_n;
+			count_ += other.count_;
+		}
+
+		/// @brief Adds the samples of a range in two passes over the (cache-resident) range: first the mean, then the
+		/// deviations from it. Used for the chunks of moments(), as it vectorizes and needs no division per sample.
+		template<class InputIt>
+		void mergeRange(InputIt begin, InputIt end)
+		{
+			Moments chunk;
+			chunk.count_ = static_cast<size_t>(std::distance(begin, end));
+			if (chunk.count_ == 0) return;
+			chunk.mean_ = std::accumulate(begin, end, T(0)) / static_cast<T>(chunk.count_);
+			for (auto it = begin; it != end; ++it)
+			{
+				const T d = *it - chunk.mean_;
+				const T d2 = d * d;
+				chunk.m2_ += d2;
+				if constexpr (Order == 4)
+				{
+					chunk.m3_ += d2 * d;
+					chunk.m4_ += d2 * d2;
+				}
+			}
+			merge(chunk);
+		}
+
+		size_t count() const { return count_; }
+		T mean() const { return mean_; }
+
+		/// @brief Returns the variance with the denominator N - 1 (weight::sample) or N (weight::population). The variance
+		/// is undefined (quiet NaN) for fewer than two samples with weight::sample and for no samples at all.
+		T var(weight w = weight::sample) const
+		{
+			const size_t denominator = w == weight::sample ? (count_ < 2 ? 0 : count_ - 1) : count_;
+			if (denominator == 0) return std::numeric_limits<T>::quiet_NaN();
+			return m2_ / static_cast<T>(denominator);
+		}
+
+		/// @brief Returns the standard deviation with the denominator N - 1 (weight::sample) or N (weight::population)
+		T std(weight w = weight::sample) const { return std::sqrt(var(w)); }
+
+		/// @brief Returns the (biased) skewness m3 / m2^(3/2), as scipy.stats.skew()
+		T skewness() const
+		{
+			static_assert(Order == 4, "Skewness requires moments up to the fourth order!");
+			return std::sqrt(static_cast<T>(count_)) * m3_ / std::pow(m2_, T(1.5));
+		}
+
+		/// @brief Returns the (biased) excess kurtosis m4 / m2^2 - 3, as scipy.stats.kurtosis()
+		T kurtosis() const
+		{
+			static_assert(Order == 4, "Kurtosis requires moments up to the fourth order!");
+			return static_cast<T>(count_) * m4_ / (m2_ * m2_) - 3;
+		}
+
+	private:
+		size_t count_{ 0 };
+		T mean_{ 0 };
+		T m2_{ 0 };
+		T m3_{ 0 };
+		T m4_{ 0 };
+	};
+
+	/// @cond developer-only
+	namespace detail
+	{
+		// Number of samples per chunk of moments(). Each chunk is read twice while it is in the cache.
+		constexpr size_t momentsChunkSize = 4096;
+
+	}
+	/// @endcond
+
+	/// @brief Returns the count, mean, and central moments of a range in a single pass over memory.
+	///
+	/// Random-access ranges are split into fixed chunks whose partial moments are computed in parallel (if the context
+	/// asks for it, see ExecutionContext) and merged in order. The chunks do not depend on the context, so the result is always
+	/// reproducible: it is bit-identical for any execution policy, grain size, and number of threads.
+	/// @tparam T Type of the samples. Should be float, double, or long double.
+	/// @tparam Order Highest moment to compute (2 or 4)
+	template<class T, unsigned Order = 4, class InputIt>
+	Moments<T, Order> moments(InputIt begin, InputIt end, const ExecutionContext& context = {})
+	{
+		if constexpr (detail::is_random_access_v<InputIt>)
+		{
+			const auto n = static_cast<size_t>(std::distance(begin, end));
+			return detail::reduceChunks(n, detail::momentsChunkSize, context, Moments<T, Order>(),
+				[&](size_t lo, size_t hi)
+				{
+					Moments<T, Order> chunk;
+					chunk.mergeRange(begin + static_cast<std::ptrdiff_t>(lo), begin + static_cast<std::ptrdiff_t>(hi));
+					return chunk;
+				},
+				[](Moments<T, Order> result, const Moments<T, Order>& chunk) { result.merge(chunk); return result; });
+		}
+		else
+		{
+			Moments<T, Order> result;
+			for (auto it = begin; it != end; ++it)
+			{
+				result.push(*it);
+			}
+			return result;
+		}
+	}
+
 	/// @brief Calculates the variance of a range
 	/// @tparam T Type of the samples. Should be float, double, or long double. Other types will cause undefined behavior.
 	/// @tparam InputIt Iterator type.
 	/// @param begin Start of the range.
 	/// @param end End of the range.
 	/// @param w Denominator to use in the calculation: If w == weight::sample, the denominator is N-1; if it w == population, the denominator is N. Default: sample.
+	/// @param context Parallel execution of long ranges
 	/// @return Variance of the samples in the range.
 	template<class T, class InputIt>
-	T var(InputIt begin, InputIt end, weight w = weight::sample)
+	T var(InputIt begin, InputIt end, weight w = weight::sample, const ExecutionContext& context = {})
 	{
-		auto mu = mean<T>(begin, end);
-		auto sum = std::transform_reduce(begin, end, T(0), std::plus<T>(), [mu](auto x) {return std::pow(x - mu, 2); });
-		if(w == weight::sample)
-		{
-			return sum / (std::distance(begin, end) - 1);
-		}
-		return sum / static_cast<T>(std::distance(begin, end));		
+		return moments<T, 2>(begin, end, context).var(w);
 	}
 
 	/// @brief Calculates the variance of a vector.
@@ -150,9 +817,9 @@ namespace dsp
 	/// @param w Denominator to use in the calculation: If w == weight::sample, the denominator is N-1; if it w == population, the denominator is N. Default: sample.
 	/// @return Variance of the samples in the vector.
 	template<class T>
-	T var(const std::vector<T>& x, weight w = weight::sample)
+	T var(const std::vector<T>& x, weight w = weight::sample, const ExecutionContext& context = {})
 	{
-		return var<T>(x.begin(), x.end(), w);
+		return var<T>(x.begin(), x.end(), w, context);
 	}
 		
 	/// @brief Calculates the variance of a Signal.
@@ -161,9 +828,23 @@ namespace dsp
 	/// @param w Denominator to use in the calculation: If w == weight::sample, the denominator is N-1; if it w == population, the denominator is N. Default: sample.
 	/// @return Variance of the signal.
 	template<class T>
-	T var(const dsp::Signal<T>& x, weight w = weight::sample)
+	T var(const dsp::Signal<T>& x, weight w = weight::sample, const ExecutionContext& context = {})
 	{
-		return var<T>(x.begin(), x.end(), w);
+		return var<T>(x.begin(), x.end(), w, context);
+	}
+
+	/// @brief Calculates the variance of a view (e.g., of memory-mapped or strided samples)
+	template<class T>
+	T var(SignalView<T> x, weight w = weight::sample, const ExecutionContext& context = {})
+	{
+		return var<T>(x.begin(), x.end(), w, context);
+	}
+
+	/// @brief Calculates the variance of each channel
+	template<class T>
+	std::vector<T> var(const MultiSignal<T>& x, weight w = weight::sample)
+	{
+		return x.mapChannels([w](SignalView<T> channel) { return var(channel, w); });
 	}
 
 	/// @brief Calculates the standard deviation of a range
@@ -201,6 +882,48 @@ namespace dsp
 		return std<T>(x.begin(), x.end(), w);
 	}
 
+	/// @brief Calculates the standard deviation of a view (e.g., of memory-mapped or strided samples)
+	template<class T>
+	T std(SignalView<T> x, weight w = weight::sample)
+	{
+		return std<T>(x.begin(), x.end(), w);
+	}
+
+	/// @brief Calculates the standard deviation of each channel
+	template<class T>
+	std::vector<T> std(const MultiSignal<T>& x, weight w = weight::sample)
+	{
+		return x.mapChannels([w](SignalView<T> channel) { return std(channel, w); });
+	}
+
+	/// @brief Returns the count, mean, and central moments of a vector (see Moments)
+	template<class T>
+	Moments<T> moments(const std::vector<T>& x)
+	{
+		return moments<T>(x.begin(), x.end());
+	}
+
+	/// @brief Returns the count, mean, and central moments of a Signal (see Moments)
+	template<class T>
+	Moments<T> moments(const Signal<T>& x)
+	{
+		return moments<T>(x.begin(), x.end());
+	}
+
+	/// @brief Returns the count, mean, and central moments of a view (see Moments)
+	template<class T>
+	Moments<T> moments(SignalView<T> x)
+	{
+		return moments<T>(x.begin(), x.end());
+	}
+
+	/// @brief Returns the count, mean, and central moments of each channel (see Moments)
+	template<class T>
+	std::vector<Moments<T>> moments(const MultiSignal<T>& x)
+	{
+		return x.mapChannels([](SignalView<T> channel) { return moments(channel); });
+	}
+
 	/// @brief Returns the standardized z-scores of the data in a range
 	/// @tparam InputIt Iterator type
 	/// @tparam T Data type of the samples. Should be float, double, or long double. Other types may cause undefined behavior.
@@ -210,10 +933,12 @@ namespace dsp
 	template<class T, class InputIt>
 	std::vector<T> zscore(InputIt begin, InputIt end)
 	{
-		std::vector<T> tmp{ begin, end };
-		auto mu = dsp::mean<T>(begin, end);
-		auto std = dsp::std<T>(begin, end);
-		std::transform(tmp.begin(), tmp.end(), tmp.begin(), [mu, std](auto x) {return (x - mu) / std; });
+		// One pass for the moments and one for the standardized values
+		const auto m = moments<T, 2>(begin, end);
+		const auto mu = m.mean();
+		const auto sigma = m.std();
+		std::vector<T> tmp(m.count());
+		std::transform(begin, end, tmp.begin(), [mu, sigma](auto x) { return (x - mu) / sigma; });
 		return tmp;
 	}
 
@@ -236,4 +961,619 @@ namespace dsp
 	{
 		return dsp::Signal<T>(x.getSamplingRate_Hz(), zscore<T>(x.begin(), x.end()));
 	}
+
+	/// @brief Returns the standardized z-scores of the data in a temporary Signal, reusing its samples
+	template<class T>
+	dsp::Signal<T> zscore(dsp::Signal<T>&& x)
+	{
+		const auto m = moments<T, 2>(x.begin(), x.end());
+		const auto mu = m.mean();
+		const auto sigma = m.std();
+		std::transform(x.begin(), x.end(), x.begin(), [mu, sigma](auto v) { return (v - mu) / sigma; });
+		return std::move(x);
+	}
+
+	/// @brief Returns the standardized z-scores of the data in a view (e.g., of memory-mapped or strided samples)
+	template<class T>
+	std::vector<T> zscore(SignalView<T> x)
+	{
+		return zscore<T>(x.begin(), x.end());
+	}
+
+	/// @brief Stateful statistics of streams, updated in constant time per sample
+	namespace stats
+	{
+		/// @brief Compensated (Kahan) sum, whose rounding error stays bounded independently of the number of terms
+		template<class T>
+		class KahanSum
+		{
+		public:
+			void add(T x)
+			{
+				// The low-order bits lost in the previous addition are fed into the next one
+				const T y = x - compensation_;
+				const T t = sum_ + y;
+				compensation_ = (t - sum_) - y;
+				sum_ = t;
+			}
+
+			void merge(const KahanSum& other)
+			{
+				add(other.sum_);
+				add(-other.compensation_);
+			}
+
+			T value() const { return sum_ - compensation_; }
+
+		private:
+			T sum_{ 0 };
+			T compensation_{ 0 };
+		};
+
+		/// @brief Running statistics of an unbounded stream: count, sum, mean, variance, min/max, energy, and RMS.
+		///
+		/// Accumulators of separate parts of a stream (e.g., one per thread) can be merged into the statistics of the
+		/// whole stream. Sums are compensated and the variance uses Welford's update, so that long runs do not drift.
+		/// @tparam T Type of the samples. Should be float, double, or long double.
+		template<class T>
+		class Accumulator
+		{
+		public:
+			void push(T x)
+			{
+				moments_.push(x);
+				sum_.add(x);
+				energy_.add(x * x);
+				min_ = std::min(min_, x);
+				max_ = std::max(max_, x);
+			}
+
+			template<class InputIt>
+			void push(InputIt begin, InputIt end)
+			{
+				for (auto it = begin; it != end; ++it)
+				{
+					push(*it);
+				}
+			}
+
+			/// @brief Adds all samples that were pushed to other
+			void merge(const Accumulator& other)
+			{
+				moments_.merge(other.moments_);
+				sum_.merge(other.sum_);
+				energy_.merge(other.energy_);
+				min_ = std::min(min_, other.min_);
+				max_ = std::max(max_, other.max_);
+			}
+
+			void reset() { *this = Accumulator(); }
+
+			size_t count() const { return moments_.count(); }
+			T sum() const { return sum_.value(); }
+			T mean() const { return sum_.value() / static_cast<T>(count()); }
+			T var(weight w = weight::sample) const { return moments_.var(w); }
+			T std(weight w = weight::sample) const { return moments_.std(w); }
+
+			/// @brief Returns the smallest sample (the largest finite value of T if no samples were pushed)
+			T min() const { return min_; }
+
+			/// @brief Returns the largest sample (the lowest finite value of T if no samples were pushed)
+			T max() const { return max_; }
+
+			/// @brief Returns the sum of the squared samples
+			T energy() const { return energy_.value(); }
+
+			/// @brief Returns the root mean square of the samples
+			T rms() const { return std::sqrt(energy() / static_cast<T>(count())); }
+
+		private:
+			Moments<T, 2> moments_;
+			KahanSum<T> sum_;
+			KahanSum<T> energy_;
+			T min_{ std::numeric_limits<T>::max() };
+			T max_{ std::numeric_limits<T>::lowest() };
+		};
+
+		/// @brief Statistics of the most recent samples of a stream: sum, mean, variance, min/max, energy, and RMS.
+		///
+		/// Pushing a sample into a full window drops the oldest one. Sums are updated incrementally with compensated
+		/// additions and subtractions, and the minimum and maximum are tracked with monotonic queues, so that every
+		/// operation takes constant (amortized) time and no memory is allocated after construction.
+		///
+		///		dsp::stats::SlidingWindowStats<float> level(4800);  // 100 ms at 48 kHz
+		///		for (auto x : stream) { level.push(x); meter = level.rms(); }
+		/// @tparam T Type of the samples. Should be float, double, or long double.
+		template<class T>
+		class SlidingWindowStats
+		{
+		public:
+			explicit SlidingWindowStats(size_t length)
+				: samples_(length), minima_(length), maxima_(length)
+			{
+				if (length == 0) { throw std::invalid_argument("The window length must be positive!"); }
+			}
+
+			/// @brief Adds a sample, dropping the oldest sample if the window is full
+			void push(T x)
+			{
+				if (full()) { pop(); }
+				if (size_ == 0)
+				{
+					// Sums of deviations from a sample in the window avoid cancellation in the variance
+					shift_ = x;
+					sum_ = {};
+					sumSquares_ = {};
+					energy_ = {};
+				}
+
+				samples_[(oldest_ + size_) % samples_.size()] = x;
+				++size_;
+				const T d = x - shift_;
+				sum_.add(d);
+				sumSquares_.add(d * d);
+				energy_.add(x * x);
+				minima_.push(next_, x);
+				maxima_.push(next_, x);
+				++next_;
+			}
+
+			/// @brief Removes the oldest sample
+			void pop()
+			{
+				if (size_ == 0) { throw std::logic_error("Cannot pop from an empty window!"); }
+
+				const T x = samples_[oldest_];
+				const T d = x - shift_;
+				sum_.add(-d);
+				sumSquares_.add(-d * d);
+				energy_.add(-x * x);
+				const auto index = next_ - size_;
+				minima_.pop(index);
+				maxima_.pop(index);
+				oldest_ = (oldest_ + 1) % samples_.size();
+				--size_;
+			}
+
+			void reset()
+			{
+				size_ = 0;
+				oldest_ = 0;
+				minima_.clear();
+				maxima_.clear();
+			}
+
+			/// @brief Returns the number of samples in the window
+			size_t size() const { return size_; }
+			size_t length() const { return samples_.size(); }
+			bool empty() const { return size_ == 0; }
+			bool full() const { return size_ == samples_.size(); }
+
+			T sum() const { return shift_ * static_cast<T>(size_) + sum_.value(); }
+			T mean() const { return shift_ + sum_.value() / static_cast<T>(size_); }
+
+			T var(weight w = weight::sample) const
+			{
+				const auto n = static_cast<T>(size_);
+				const T s = sum_.value();
+				const T m2 = std::max(T(0), sumSquares_.value() - s * s / n);
+				return m2 / (w == weight::sample ? n - 1 : n);
+			}
+
+			T std(weight w = weight::sample) const { return std::sqrt(var(w)); }
+
+			/// @brief Returns the smallest sample in the window. Throws std::logic_error if the window is empty.
+			T min() const
+			{
+				if (size_ == 0) { throw std::logic_error("Cannot compute the minimum of an empty window!"); }
+				return minima_.front();
+			}
+
+			/// @brief Returns the largest sample in the window. Throws std::logic_error if the window is empty.
+			T max() const
+			{
+				if (size_ == 0) { throw std::logic_error("Cannot compute the maximum of an empty window!"); }
+				return maxima_.front();
+			}
+
+			/// @brief Returns the sum of the squared samples in the window
+			T energy() const { return std::max(T(0), energy_.value()); }
+
+			/// @brief Returns the root mean square of the samples in the window
+			T rms() const { return std::sqrt(energy() / static_cast<T>(size_)); }
+
+		private:
+			// Monotonic queue of (index, value) pairs in a ring buffer, whose front is the extremum of the window
+			template<class Compare>
+			class ExtremumQueue
+			{
+			public:
+				explicit ExtremumQueue(size_t capacity) : entries_(capacity) {}
+
+				void push(size_t index, T x)
+				{
+					// Entries that are not better than x can never become the extremum again
+					while (size_ > 0 && !Compare()(at(size_ - 1).second, x)) { --size_; }
+					at(size_) = { index, x };
+					++size_;
+				}
+
+				void pop(size_t index)
+				{
+					if (size_ > 0 && at(0).first == index)
+					{
+						head_ = (head_ + 1) % entries_.size();
+						--size_;
+					}
+				}
+
+				void clear() { head_ = 0; size_ = 0; }
+				T front() const { return entries_[head_].second; }
+
+			private:
+				std::pair<size_t, T>& at(size_t i) { return entries_[(head_ + i) % entries_.size()]; }
+
+				std::vector<std::pair<size_t, T>> entries_;
+				size_t head_{ 0 };
+				size_t size_{ 0 };
+			};
+
+			std::vector<T> samples_;
+			size_t oldest_{ 0 };
+			size_t size_{ 0 };
+			size_t next_{ 0 };  //!< Index of the next sample in the stream
+			T shift_{ 0 };
+			KahanSum<T> sum_;  //!< Sum of the deviations from shift_
+			KahanSum<T> sumSquares_;  //!< Sum of the squared deviations from shift_
+			KahanSum<T> energy_;
+			ExtremumQueue<std::less<T>> minima_;
+			ExtremumQueue<std::greater<T>> maxima_;
+		};
+
+		/// @brief Mergeable sketch of the distribution of a stream for approximate quantiles in bounded memory (t-digest).
+		///
+		/// Samples are clustered into centroids (mean and weight) whose size is limited by the scale function
+		/// k(q) = compression / (2 pi) * asin(2q - 1), so that clusters are small near the tails and the extreme
+		/// quantiles (e.g., p99) are most accurate. At most about compression centroids are kept, independently of the
+		/// number of samples; higher compression gives more accurate quantiles. Digests of separate streams (e.g., one
+		/// per thread or per process, exchanged through serialize()) can be merged.
+		///
+		/// Queries first merge buffered samples into the centroids, so a digest must not be queried from several threads
+		/// at the same time.
+		/// @tparam T Type of the samples. Should be float, double, or long double.
+		template<class T>
+		class TDigest
+		{
+		public:
+			explicit TDigest(double compression = 100.0)
+				: compression_(compression)
+			{
+				if (!(compression >= 10.0)) { throw std::invalid_argument("The compression of a t-digest must be at least 10!"); }
+				buffer_.reserve(bufferCapacity());
+			}
+
+			/// @brief Adds a sample with the given weight
+			void push(T x, double weight = 1.0)
+			{
+				buffer_.push_back({ x, weight });
+				count_ += weight;
+				min_ = std::min(min_, x);
+				max_ = std::max(max_, x);
+				if (buffer_.size() >= bufferCapacity()) { compress(); }
+			}
+
+			template<class InputIt>
+			void push(InputIt begin, InputIt end)
+			{
+				for (auto it = begin; it != end; ++it)
+				{
+					push(*it);
+				}
+			}
+
+			/// @brief Adds all samples that were pushed to other (which may be this digest itself)
+			void merge(const TDigest& other)
+			{
+				if (&other == this)
+				{
+					// The loop below would append to the centroids it iterates over
+					const TDigest copy(other);
+					merge(copy);
+					return;
+				}
+
+				other.compress();
+				for (const auto& c : other.centroids_)
+				{
+					buffer_.push_back(c);
+					if (buffer_.size() >= bufferCapacity()) { compress(); }
+				}
+				count_ += other.count_;
+				min_ = std::min(min_, other.min_);
+				max_ = std::max(max_, other.max_);
+				compress();
+			}
+
+			/// @brief Returns the total weight of the pushed samples
+			double count() const { return count_; }
+			bool empty() const { return count_ == 0.0; }
+			T min() const { return min_; }
+			T max() const { return max_; }
+			double compression() const { return compression_; }
+
+			/// @brief Returns the number of centroids (after merging the buffered samples)
+			size_t size() const
+			{
+				compress();
+				return centroids_.size();
+			}
+
+			/// @brief Returns the approximate q-th quantile (q in [0, 1])
+			T quantile(double q) const
+			{
+				if (!(q >= 0.0 && q <= 1.0)) { throw std::invalid_argument("Quantiles must be between 0 and 1!"); }
+				if (empty()) { throw std::logic_error("Cannot compute quantiles of an empty t-digest!"); }
+				compress();
+
+				// Centroid i represents the cumulative weight up to its center; the minimum and maximum lie at the ends
+				const auto index = q * count_;
+				double left = 0.0;
+				double leftWeight = 0.0;
+				T leftValue = min_;
+				for (const auto& c : centroids_)
+				{
+					const auto center = left + c.weight / 2;
+					if (index <= center)
+					{
+						const auto span = center - leftWeight;
+						const auto fraction = span > 0.0 ? (index - leftWeight) / span : 1.0;
+						return static_cast<T>(leftValue + fraction * (c.mean - leftValue));
+					}
+					left += c.weight;
+					leftWeight = center;
+					leftValue = c.mean;
+				}
+				const auto span = count_ - leftWeight;
+				const auto fraction = span > 0.0 ? (index - leftWeight) / span : 1.0;
+				return static_cast<T>(leftValue + fraction * (max_ - leftValue));
+			}
+
+			/// @brief Returns the approximate p-th percentile (p in [0, 100])
+			T percentile(double p) const { return quantile(p / 100.0); }
+
+			/// @brief Returns the digest as bytes, e.g., to combine the digests of several processes with merge()
+			std::vector<char> serialize() const
+			{
+				compress();
+				std::vector<char> bytes(headerSize + centroids_.size() * centroidSize);
+				char* p = bytes.data();
+				write(p, magic);
+				write(p, static_cast<std::uint32_t>(sizeof(T)));
+				write(p, compression_);
+				write(p, count_);
+				write(p, min_);
+				write(p, max_);
+				write(p, static_cast<std::uint64_t>(centroids_.size()));
+				for (const auto& c : centroids_)
+				{
+					write(p, c.mean);
+					write(p, c.weight);
+				}
+				return bytes;
+			}
+
+			/// @brief Restores a digest from the bytes returned by serialize() (on a machine with the same byte order)
+			static TDigest deserialize(const std::vector<char>& bytes)
+			{
+				if (bytes.size() < headerSize) { throw std::invalid_argument("Invalid t-digest data!"); }
+				const char* p = bytes.data();
+				const auto header = read<std::uint32_t>(p);
+				const auto sampleSize = read<std::uint32_t>(p);
+				const auto compression = read<double>(p);
+				const auto count = read<double>(p);
+				const auto min = read<T>(p);
+				const auto max = read<T>(p);
+				const auto numCentroids = read<std::uint64_t>(p);
+
+				// Dividing instead of multiplying cannot overflow for a corrupted number of centroids
+				const auto payload = bytes.size() - headerSize;
+				if (header != magic || sampleSize != sizeof(T) || payload % centroidSize != 0 || numCentroids != payload / centroidSize)
+				{
+					throw std::invalid_argument("Invalid t-digest data!");
+				}
+
+				TDigest digest(compression);
+				digest.count_ = count;
+				digest.min_ = min;
+				digest.max_ = max;
+				digest.centroids_.resize(static_cast<size_t>(numCentroids));
+				for (auto& c : digest.centroids_)
+				{
+					c.mean = read<T>(p);
+					c.weight = read<double>(p);
+				}
+				return digest;
+			}
+
+		private:
+			struct Centroid
+			{
+				T mean;
+				double weight;
+			};
+
+			// The fields are serialized one by one, without the padding of the structs: magic, sample size, compression,
+			// count, min, max, number of centroids, and the mean and weight of each centroid
+			static constexpr size_t headerSize = 2 * sizeof(std::uint32_t) + 2 * sizeof(double) + 2 * sizeof(T) + sizeof(std::uint64_t);
+			static constexpr size_t centroidSize = sizeof(T) + sizeof(double);
+
+			template<class U>
+			static void write(char*& p, U value)
+			{
+				std::memcpy(p, &value, sizeof(U));
+				p += sizeof(U);
+			}
+
+			template<class U>
+			static U read(const char*& p)
+			{
+				U value;
+				std::memcpy(&value, p, sizeof(U));
+				p += sizeof(U);
+				return value;
+			}
+
+			static constexpr std::uint32_t magic = 0x54444731;  // "TDG1"
+
+			size_t bufferCapacity() const { return static_cast<size_t>(5 * compression_); }
+
+			double k(double q) const { return compression_ / (2 * dsp::pi) * std::asin(2 * q - 1); }
+			double kInverse(double k) const { return (std::sin(k * 2 * dsp::pi / compression_) + 1) / 2; }
+
+			// Merges the buffered samples into the centroids in one sweep over all centroids sorted by their mean
+			void compress() const
+			{
+				if (buffer_.empty()) return;
+
+				buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+				std::sort(buffer_.begin(), buffer_.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+				double total = 0.0;
+				for (const auto& c : buffer_) total += c.weight;
+
+				centroids_.clear();
+				auto current = buffer_.front();
+				double weightSoFar = 0.0;
+				auto limit = kInverse(k(0.0) + 1.0);
+				for (size_t i = 1; i < buffer_.size(); ++i)
+				{
+					const auto& next = buffer_[i];
+					const auto proposed = current.weight + next.weight;
+					if ((weightSoFar + proposed) / total <= limit)
+					{
+						current.mean += static_cast<T>((next.mean - current.mean) * (next.weight / proposed));
+						current.weight = proposed;
+					}
+					else
+					{
+						weightSoFar += current.weight;
+						centroids_.push_back(current);
+						limit = kInverse(k(std::min(1.0, weightSoFar / total)) + 1.0);
+						current = next;
+					}
+				}
+				centroids_.push_back(current);
+				buffer_.clear();
+			}
+
+			double compression_;
+			double count_{ 0.0 };
+			T min_{ std::numeric_limits<T>::max() };
+			T max_{ std::numeric_limits<T>::lowest() };
+			mutable std::vector<Centroid> centroids_;
+			mutable std::vector<Centroid> buffer_;  //!< Samples (or centroids of merged digests) that are not merged yet
+		};
+
+		/// @brief Constant-memory estimator of a single quantile of a stream (P² algorithm by Jain and Chlamtac).
+		///
+		/// Five markers track the minimum, the maximum, the quantile, and two quantiles halfway to the extremes, and are
+		/// moved with piecewise-parabolic interpolation as samples arrive. Much lighter than a TDigest, but the estimate
+		/// cannot be merged with that of another stream.
+		/// @tparam T Type of the samples. Should be float, double, or long double.
+		template<class T>
+		class P2Quantile
+		{
+		public:
+			/// @param q Quantile to estimate, in [0, 1]
+			explicit P2Quantile(double q)
+				: q_(q), increments_{ 0.0, q / 2, q, (1 + q) / 2, 1.0 }
+			{
+				if (!(q >= 0.0 && q <= 1.0)) { throw std::invalid_argument("Quantiles must be between 0 and 1!"); }
+			}
+
+			void push(T x)
+			{
+				if (count_ < 5)
+				{
+					heights_[count_++] = x;
+					if (count_ == 5)
+					{
+						std::sort(heights_.begin(), heights_.end());
+						for (int i = 0; i < 5; ++i) { positions_[i] = i; }
+						desired_ = { 0.0, 2 * q_, 4 * q_, 2 + 2 * q_, 4.0 };
+					}
+					return;
+				}
+				++count_;
+
+				// Find the cell of x and extend the extremes if necessary
+				int cell;
+				if (x < heights_[0]) { heights_[0] = x; cell = 0; }
+				else if (x >= heights_[4]) { heights_[4] = std::max(heights_[4], x); cell = 3; }
+				else { cell = static_cast<int>(std::upper_bound(heights_.begin() + 1, heights_.begin() + 4, x) - heights_.begin()) - 1; }
+
+				for (int i = cell + 1; i < 5; ++i) { ++positions_[i]; }
+				for (int i = 0; i < 5; ++i) { desired_[i] += increments_[i]; }
+
+				// Move the three middle markers toward their desired positions
+				for (int i = 1; i <= 3; ++i)
+				{
+					const auto d = desired_[i] - positions_[i];
+					if ((d >= 1.0 && positions_[i + 1] - positions_[i] > 1) || (d <= -1.0 && positions_[i - 1] - positions_[i] < -1))
+					{
+						const int step = d > 0 ? 1 : -1;
+						const auto candidate = parabolic(i, step);
+						heights_[i] = heights_[i - 1] < candidate && candidate < heights_[i + 1] ? candidate : linear(i, step);
+						positions_[i] += step;
+					}
+				}
+			}
+
+			template<class InputIt>
+			void push(InputIt begin, InputIt end)
+			{
+				for (auto it = begin; it != end; ++it)
+				{
+					push(*it);
+				}
+			}
+
+			size_t count() const { return count_; }
+
+			/// @brief Returns the estimated quantile (exact for fewer than five samples)
+			T value() const
+			{
+				if (count_ == 0) { throw std::logic_error("Cannot estimate quantiles without samples!"); }
+				if (count_ < 5)
+				{
+					auto sorted = heights_;
+					std::sort(sorted.begin(), sorted.begin() + count_);
+					const auto h = q_ * static_cast<double>(count_ - 1);
+					const auto lo = static_cast<size_t>(std::floor(h));
+					const auto hi = std::min(count_ - 1, lo + 1);
+					return static_cast<T>(sorted[lo] + (h - static_cast<double>(lo)) * (sorted[hi] - sorted[lo]));
+				}
+				return heights_[2];
+			}
+
+		private:
+			T parabolic(int i, int d) const
+			{
+				const double n0 = positions_[i - 1], n1 = positions_[i], n2 = positions_[i + 1];
+				return static_cast<T>(heights_[i] + d / (n2 - n0) * ((n1 - n0 + d) * (heights_[i + 1] - heights_[i]) / (n2 - n1)
+					+ (n2 - n1 - d) * (heights_[i] - heights_[i - 1]) / (n1 - n0)));
+			}
+
+			T linear(int i, int d) const
+			{
+				return static_cast<T>(heights_[i] + d * (heights_[i + d] - heights_[i]) / static_cast<double>(positions_[i + d] - positions_[i]));
+			}
+
+			double q_;
+			size_t count_{ 0 };
+			std::array<T, 5> heights_{};  //!< Marker heights (the first samples until there are five)
+			std::array<long long, 5> positions_{};  //!< Actual marker positions (0-based ranks)
+			std::array<double, 5> desired_{};  //!< Desired marker positions
+			std::array<double, 5> increments_;  //!< Increments of the desired positions per sample
+		};
+	}
 }
\ No newline at end of file
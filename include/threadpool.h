@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dsp
+{
+	/// @brief Work-stealing pool of worker threads that runs the parallel algorithms of the library.
+	///
+	/// Every worker has its own task queue. Workers take tasks from the back of their own queue and, when it is empty,
+	/// steal from the front of the other queues. parallelFor() lets the calling thread work on the loop as well, and
+	/// calls from inside a task or a parallel loop (nested parallelism) run sequentially on the calling thread, so that
+	/// nested library calls neither oversubscribe the machine nor wait for workers that are waiting themselves.
+	///
+	/// The library uses global() unless an ExecutionContext names another pool. Applications that run their own
+	/// workers can resize or pin it with setGlobal(), or pass a pool of their own.
+	///
+	///		dsp::ThreadPool pool(8, { 0, 1, 2, 3, 4, 5, 6, 7 });  // Eight workers on the cores of the first NUMA node
+	///		dsp::ExecutionContext context = dsp::ExecutionContext::parallel();
+	///		context.pool = &pool;
+	///		const auto energy = dsp::calculateEnergy<float>(x.begin(), x.end(), context);
+	class ThreadPool
+	{
+	public:
+		/// @param numThreads Number of workers (0 for one less than the number of hardware threads, but at least one)
+		/// @param cpus Logical processors to pin the workers to, in turn (e.g., the cores of one NUMA node). Empty for no pinning.
+		explicit ThreadPool(unsigned numThreads = 0, std::vector<unsigned> cpus = {});
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/// @brief Runs the remaining tasks and joins the workers
+		~ThreadPool();
+
+		/// @brief Returns the number of workers
+		unsigned numThreads() const { return static_cast<unsigned>(workers_.size()); }
+
+		/// @brief Calls f(i) for every i in [0, n) on the workers and the calling thread and returns when all calls have finished.
+		///
+		/// Indices are handed out one at a time, so each call should do a sizable amount of work (e.g., one chunk or one
+		/// channel). The first exception thrown by f is rethrown after all calls have finished.
+		void parallelFor(size_t n, const std::function<void(size_t)>& f);
+
+		/// @brief Queues a task and returns the future of its result
+		template<class F>
+		auto submit(F f) -> std::future<std::invoke_result_t<F&>>
+		{
+			auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F&>()>>(std::move(f));
+			auto result = task->get_future();
+			push([task] { (*task)(); });
+			return result;
+		}
+
+		/// @brief Returns whether the calling thread is running a task or a parallel loop of any pool
+		static bool inParallelRegion();
+
+		/// @brief Returns the pool that the library uses by default
+		static ThreadPool& global();
+
+		/// @brief Replaces the global pool. Must not be called while the library runs parallel work.
+		static void setGlobal(unsigned numThreads, std::vector<unsigned> cpus = {});
+
+	private:
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+			std::thread thread;
+		};
+
+		void push(std::function<void()> task);
+		bool runOne(size_t self);
+		void work(size_t index, int cpu);
+
+		std::vector<std::unique_ptr<Worker>> workers_;
+		std::mutex sleepMutex_;
+		std::condition_variable wake_;
+		size_t queued_{ 0 };  //!< Number of tasks that have not been started yet (guarded by sleepMutex_)
+		bool stop_{ false };
+		std::atomic<size_t> nextWorker_{ 0 };
+	};
+}
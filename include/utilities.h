@@ -1,12 +1,18 @@
 #pragma once
 #include <algorithm>
 #include <complex>
+#include <iterator>
 #include <map>
 #include <numeric>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "allocators.h"
+#include "execution.h"
+#include "kernels.h"
 #include "Signal.h"
+#include "SignalView.h"
 
 /// @brief Constants and convenience functions for general signal processing tasks and 1D vector operations
 namespace dsp
@@ -35,23 +41,230 @@ namespace dsp
 		return values;
 	}
 
+	/// @cond developer-only
+	namespace detail
+	{
+		// Whether the reduction kernels (kernels::sum() and kernels::sumOfSquares()) are instantiated for T
+		template<class T>
+		constexpr bool has_reduction_kernel_v = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, long double>;
+
+		// Whether It is an iterator of std::vector<V, Allocator> (and thus of a Signal<V, Allocator>)
+		template<class It, class V, class Allocator>
+		constexpr bool is_vector_iterator_v = std::is_same_v<It, typename std::vector<V, Allocator>::iterator>
+			|| std::is_same_v<It, typename std::vector<V, Allocator>::const_iterator>;
+
+		// Whether the elements of any range of It are adjacent in memory. Before C++20, only pointers and the iterators
+		// of vectors and Signals with the standard allocator or the allocators of the library (AlignedAllocator and
+		// PoolAllocator) are recognized. Containers with other allocators are handled by the range overloads through
+		// std::data().
+		template<class It, class V = typename std::iterator_traits<It>::value_type>
+		constexpr bool is_contiguous_iterator_v =
+#if defined(__cpp_lib_concepts)
+			std::contiguous_iterator<It> ||
+#endif
+			std::is_pointer_v<It> || is_vector_iterator_v<It, V, std::allocator<V>> || is_vector_iterator_v<It, V, AlignedAllocator<V>>
+			|| is_vector_iterator_v<It, V, PoolAllocator<V>>;
+
+		template<class Range>
+		using range_value_t = std::decay_t<decltype(*std::begin(std::declval<const Range&>()))>;
+
+		template<class Range>
+		struct is_signal_view : std::false_type {};
+
+		template<class T>
+		struct is_signal_view<SignalView<T>> : std::true_type {};
+
+		template<class Range, class = void>
+		struct has_data : std::false_type {};
+
+		template<class Range>
+		struct has_data<Range, std::void_t<decltype(std::data(std::declval<const Range&>()))>> : std::true_type {};
+
+		// Returns a pointer to the samples of [first, last) if they are adjacent in memory and of a type that the
+		// reduction kernels read, and nullptr otherwise (e.g., for empty or strided ranges, or other sample types)
+		template<class T, class It>
+		const T* contiguousData(It first, It last)
+		{
+			if constexpr (!has_reduction_kernel_v<T> || !std::is_same_v<typename std::iterator_traits<It>::value_type, T>)
+			{
+				return nullptr;
+			}
+			else
+			{
+				if (first == last) return nullptr;
+				if constexpr (is_contiguous_iterator_v<It>)
+				{
+					return &*first;
+				}
+				else if constexpr (std::is_same_v<It, typename SignalView<T>::const_iterator>)
+				{
+					return first.stride() == 1 ? &*first : nullptr;
+				}
+				else
+				{
+					return nullptr;
+				}
+			}
+		}
+
+		// Returns a pointer to the samples of a range (e.g., a vector, Signal, array, or contiguous SignalView) if they
+		// are adjacent in memory and of a type that the reduction kernels read, and nullptr otherwise
+		template<class T, class Range>
+		const T* contiguousData(const Range& x)
+		{
+			if constexpr (is_signal_view<Range>::value)
+			{
+				return contiguousData<T>(x.begin(), x.end());
+			}
+			else if constexpr (has_data<Range>::value && has_reduction_kernel_v<T>)
+			{
+				if constexpr (std::is_same_v<decltype(std::data(x)), const T*>)
+				{
+					return std::size(x) > 0 ? std::data(x) : nullptr;
+				}
+				else
+				{
+					return nullptr;
+				}
+			}
+			else
+			{
+				return contiguousData<T>(std::begin(x), std::end(x));
+			}
+		}
+
+		// Energy of n contiguous samples, reduced with a kernel per chunk
+		template<class T>
+		T energy(const T* x, size_t n, kernels::summation_method method, const ExecutionContext& context)
+		{
+			return static_cast<T>(reduceSum<kernels::accumulator_t<T>>(n, context,
+				[x, method](size_t lo, size_t hi) { return kernels::sumOfSquares(x + lo, hi - lo, method); }));
+		}
+	}
+	/// @endcond
+
 	/// @brief Returns the energy of the passed range.
+	///
+	/// Any forward iterators are accepted (e.g., const_iterator, pointers, or the iterators of a SignalView). Samples
+	/// that are adjacent in memory are summed with the SIMD kernel of kernels::summation_method::naive, everything
+	/// else element by element; the range is never copied. The kernel adds the squares in several interleaved partial
+	/// sums, so its result can differ in the last bits from a sequential std::inner_product() (which earlier versions
+	/// used for all ranges).
 	/// @tparam T Type of the elements in range.
 	/// @param start Iterator pointing to the start of the range (e.g. my_signal.begin())
 	/// @param end Iterator pointing to the end of the range (e.g. my_signal.end())
+	/// @param context Parallel execution of long (random-access) ranges. In parallel, the squares of chunks are summed separately and the sums are added in order.
 	/// @return The energy of the range (sum of the squared samples in range)
-	template<class T>
-	T calculateEnergy(typename std::vector<T>::iterator start,
-		typename std::vector<T>::iterator end);
+	template<class T, class ForwardIt>
+	T calculateEnergy(ForwardIt start, ForwardIt end, const ExecutionContext& context = {})
+	{
+		const auto n = static_cast<size_t>(std::distance(start, end));
+		if constexpr (detail::has_reduction_kernel_v<T>)
+		{
+			// Other types (e.g., integers or complex samples) only instantiate the element-wise path
+			if (const T* x = detail::contiguousData<T>(start, end))
+			{
+				return detail::energy(x, n, kernels::summation_method::naive, context);
+			}
+		}
+		if constexpr (detail::is_random_access_v<ForwardIt>)
+		{
+			return detail::reduceSum<T>(n, context, [start](size_t lo, size_t hi)
+				{
+					const auto first = start + static_cast<std::ptrdiff_t>(lo);
+					const auto last = start + static_cast<std::ptrdiff_t>(hi);
+					return std::inner_product(first, last, first, T(0));
+				});
+		}
+		else
+		{
+			return std::inner_product(start, end, start, T(0));
+		}
+	}
+
+	/// @brief Returns the energy of the passed range, summed with the given algorithm.
+	///
+	/// Long float recordings lose several digits with naive summation; pairwise, kahan, and widened keep the error
+	/// close to that of a double accumulator at (nearly) the speed of the SIMD kernel. Ranges whose samples are not
+	/// adjacent in memory (e.g., strided views) are copied once, because the algorithms run on the kernels.
+	/// @tparam T float, double, or long double
+	/// @param method Summation algorithm (see kernels::summation_method)
+	/// @param context Parallel execution of long ranges. Each chunk is summed with method and the sums are added in order.
+	template<class T, class ForwardIt>
+	T calculateEnergy(ForwardIt start, ForwardIt end, kernels::summation_method method, const ExecutionContext& context = {})
+	{
+		static_assert(detail::has_reduction_kernel_v<T>, "Summation methods are only available for float, double, and long double!");
+		const auto n = static_cast<size_t>(std::distance(start, end));
+		if (n == 0) return T(0);
+		if (const T* x = detail::contiguousData<T>(start, end))
+		{
+			return detail::energy(x, n, method, context);
+		}
+		const std::vector<T> samples(start, end);
+		return detail::energy(samples.data(), n, method, context);
+	}
 
-	/// @brief Returns the mean power of the passed range
+	/// @brief Returns the energy of a vector, Signal, SignalView, array, or any other range, without copying it
+	template<class Range, class T = detail::range_value_t<Range>>
+	T calculateEnergy(const Range& x, const ExecutionContext& context = {})
+	{
+		if constexpr (detail::has_reduction_kernel_v<T>)
+		{
+			if (const T* data = detail::contiguousData<T>(x))
+			{
+				return detail::energy(data, std::size(x), kernels::summation_method::naive, context);
+			}
+		}
+		return calculateEnergy<T>(std::begin(x), std::end(x), context);
+	}
+
+	/// @brief Returns the energy of a range, summed with the given algorithm (see calculateEnergy())
+	template<class Range, class T = detail::range_value_t<Range>>
+	T calculateEnergy(const Range& x, kernels::summation_method method, const ExecutionContext& context = {})
+	{
+		if (const T* data = detail::contiguousData<T>(x))
+		{
+			return detail::energy(data, std::size(x), method, context);
+		}
+		return calculateEnergy<T>(std::begin(x), std::end(x), method, context);
+	}
+
+	/// @brief Returns the mean power of the passed range (see calculateEnergy() for the accepted iterators)
 	/// @tparam T Type of the elements in range.
 	/// @param start Iterator pointing to the start of the range (e.g. my_signal.begin())
 	/// @param end Iterator pointing to the end of the range (e.g. my_signal.end())
+	/// @param context Parallel execution of long ranges. In parallel, the squares of chunks are summed separately and the sums are added in order.
 	/// @return The mean power of the range (energy divided by length)
-	template<class T>
-	T calculateMeanPower(typename std::vector<T>::iterator start,
-		typename std::vector<T>::iterator end);
+	template<class T, class ForwardIt>
+	T calculateMeanPower(ForwardIt start, ForwardIt end, const ExecutionContext& context = {})
+	{
+		auto energy = calculateEnergy<T>(start, end, context);
+		auto numSamples = std::distance(start, end);
+		return energy / numSamples;
+	}
+
+	/// @brief Returns the mean power of the passed range, summed with the given algorithm (see calculateEnergy())
+	template<class T, class ForwardIt>
+	T calculateMeanPower(ForwardIt start, ForwardIt end, kernels::summation_method method, const ExecutionContext& context = {})
+	{
+		auto energy = calculateEnergy<T>(start, end, method, context);
+		auto numSamples = std::distance(start, end);
+		return energy / numSamples;
+	}
+
+	/// @brief Returns the mean power of a range, without copying it
+	template<class Range, class T = detail::range_value_t<Range>>
+	T calculateMeanPower(const Range& x, const ExecutionContext& context = {})
+	{
+		return calculateEnergy(x, context) / static_cast<T>(std::size(x));
+	}
+
+	/// @brief Returns the mean power of a range, summed with the given algorithm (see calculateEnergy())
+	template<class Range, class T = detail::range_value_t<Range>>
+	T calculateMeanPower(const Range& x, kernels::summation_method method, const ExecutionContext& context = {})
+	{
+		return calculateEnergy(x, method, context) / static_cast<T>(std::size(x));
+	}
 
 	/// @brief Returns the center portion of a vector
 	/// @tparam T Type of the elements in vector.
@@ -61,6 +274,10 @@ namespace dsp
 	template<class T>
 	std::vector<T> centered(const std::vector<T>& vec, size_t newSize);
 
+	/// @brief Returns the center portion of a (possibly strided) view, without copying the rest of it
+	template<class T>
+	std::vector<T> centered(SignalView<T> x, size_t newSize);
+
 	/// @brief Join a sequence of vectors.
 	/// @tparam T Type of the vector elements
 	/// @param vectors Vector containing references to the vectors.
@@ -69,6 +286,12 @@ namespace dsp
 	std::vector<T> concatenate(std::vector<const std::vector<T>*> vectors)
 	{
 		std::vector<T> concatenated_vector;
+		size_t size = 0;
+		for (const auto& v : vectors)
+		{
+			size += v->size();
+		}
+		concatenated_vector.reserve(size);
 		for (const auto& v : vectors)
 		{
 			concatenated_vector.insert(concatenated_vector.end(), v->begin(), v->end());
@@ -85,6 +308,12 @@ namespace dsp
 	Signal<T> concatenate(std::vector<const Signal<T>*> signals)
 	{
 		Signal<T> concatenated_signal(signals.front()->getSamplingRate_Hz());
+		size_t size = 0;
+		for (const auto& s : signals)
+		{
+			size += s->size();
+		}
+		concatenated_signal.reserve(size);
 		for (const auto& s : signals)
 		{
 			if (s->getSamplingRate_Hz() != concatenated_signal.getSamplingRate_Hz())
@@ -136,10 +365,21 @@ namespace dsp
 	/// direct:	The correlation is determined directly from sums, the definition of correlation.
 	/// fft:	The Fast Fourier Transform is used to perform the correlation more quickly.
 	/// automatic: Automatically chooses direct or fft method based on an estimate of which is faster (default).
+	/// @param context Parallel execution of the direct method over chunks of the output. Every output sample is
+	/// accumulated in the same order, so the result is bit-identical for any execution policy.
 	/// @return A vector containing a subset of the discrete convolution of in1 with in2.
 	template<class T>
 	std::vector<T> convolve(const std::vector<T>& in1, const std::vector<T>& in2,
-		convolution_mode mode = convolution_mode::full, convolution_method method = convolution_method::automatic);
+		convolution_mode mode = convolution_mode::full, convolution_method method = convolution_method::automatic,
+		const ExecutionContext& context = {});
+
+	/// @brief Convolve two views (e.g., of memory-mapped or strided samples) without copying them into vectors first.
+	///
+	/// Same as convolve() for vectors. The direct method reads a contiguous in1 in place; a strided in1 is copied once.
+	template<class T>
+	std::vector<T> convolve(SignalView<T> in1, SignalView<T> in2,
+		convolution_mode mode = convolution_mode::full, convolution_method method = convolution_method::automatic,
+		const ExecutionContext& context = {});
 
 	using correlation_mode = convolution_mode;
 	using correlation_method = convolution_method;
@@ -156,10 +396,20 @@ namespace dsp
 	/// direct:	The correlation is determined directly from sums, the definition of correlation.
 	/// fft:	The Fast Fourier Transform is used to perform the correlation more quickly.
 	/// automatic: Automatically chooses direct or fft method based on an estimate of which is faster (default).
+	/// @param context Parallel execution of the direct method (see convolve())
 	/// @return A vector containing a subset of the discrete linear cross-correlation of in1 with in2.
 	template<class T>
 	std::vector<T> correlate(const std::vector<T>& in1, const std::vector<T>& in2,
-		correlation_mode mode = correlation_mode::full, correlation_method method = correlation_method::automatic);
+		correlation_mode mode = correlation_mode::full, correlation_method method = correlation_method::automatic,
+		const ExecutionContext& context = {});
+
+	/// @brief Cross-correlate two views without copying them into vectors first (see correlate() for vectors).
+	///
+	/// Only the reversed in2 is materialized; in1 is read as described for convolve() of views.
+	template<class T>
+	std::vector<T> correlate(SignalView<T> in1, SignalView<T> in2,
+		correlation_mode mode = correlation_mode::full, correlation_method method = correlation_method::automatic,
+		const ExecutionContext& context = {});
 
 	/// @brief Auto-correlate a vector with itself.
 	/// @tparam T Type of the vector elements
@@ -172,12 +422,21 @@ namespace dsp
 	/// direct:	The correlation is determined directly from sums, the definition of correlation.
 	/// fft:	The Fast Fourier Transform is used to perform the correlation more quickly.
 	/// automatic: Automatically chooses direct or fft method based on an estimate of which is faster (default).
+	/// @param context Parallel execution of the direct method (see convolve())
 	/// @return A vector containing a subset of the discrete linear auto-correlation of in.
 	template<class T>
 	std::vector<T> autocorrelate(const std::vector<T>& in, correlation_mode mode = correlation_mode::full,
-		correlation_method method = correlation_method::automatic)
+		correlation_method method = correlation_method::automatic, const ExecutionContext& context = {})
+	{
+		return correlate(in, in, mode, method, context);
+	}
+
+	/// @brief Auto-correlate a view with itself (see autocorrelate() for vectors)
+	template<class T>
+	std::vector<T> autocorrelate(SignalView<T> in, correlation_mode mode = correlation_mode::full,
+		correlation_method method = correlation_method::automatic, const ExecutionContext& context = {})
 	{
-		return correlate(in, in, mode, method);
+		return correlate(in, in, mode, method, context);
 	}
 
 	/// @brief Return the elements of a vector that satisfy some condition.
@@ -200,6 +459,15 @@ namespace dsp
 		return results;
 	}
 
+	/// @brief Return the elements of a (possibly strided) view that satisfy some condition.
+	template <class T, class Pred>
+	std::vector<T> extract(Pred condition, SignalView<T> x)
+	{
+		std::vector<T> results;
+		std::copy_if(x.begin(), x.end(), std::back_inserter(results), condition);
+		return results;
+	}
+
 	/// @brief Return evenly spaced numbers over a specified interval.
 	///
 	/// Returns N evenly spaced samples, calculated over the interval[start, stop].
@@ -243,6 +511,18 @@ namespace dsp
 		return static_cast<T>(10.0 * std::log(norm_z));
 	}
 
+	/// @brief Returns the normalized sinc function
+	/// @tparam T Data type of the argument
+	/// @param x Argument
+	/// @return sin(pi * x) / (pi * x), and 1 for x == 0
+	template <typename T>
+	T sinc(T x)
+	{
+		if (x == T(0)) { return T(1); }
+		const auto y = static_cast<T>(pi) * x;
+		return std::sin(y) / y;
+	}
+
 	/// @brief Return modulus (which is not the same as the remainder for signed values)
 	template <typename T>
 	T mod(T x1, T x2)
@@ -272,24 +552,31 @@ namespace dsp
 	/// @return Maximum number of frames to split the signal into assuming zero-padding at the end.
 	unsigned maxNumFrames(unsigned signalLength, unsigned frameLength, unsigned overlap);
 
+	/// @brief Pads a (possibly strided) view into a new vector, without copying the view first
+	template<class T>
+	std::vector<T> pad(SignalView<T> x, std::pair<size_t, size_t> pad_width, std::pair<T, T> values = { T(), T() })
+	{
+		std::vector<T> padded;
+		padded.reserve(pad_width.first + x.size() + pad_width.second);
+		padded.insert(padded.end(), pad_width.first, values.first);
+		padded.insert(padded.end(), x.begin(), x.end());
+		padded.insert(padded.end(), pad_width.second, values.second);
+
+		return padded;
+	}
+
 	template<class T>
 	std::vector<T> pad(const std::vector<T>& x, std::pair<size_t, size_t> pad_width, 
 		std::pair<T, T> values = { T(), T() })
 	{
-		std::vector<T> before(pad_width.first, values.first);
-		std::vector<T> after(pad_width.second, values.second);
-
-		return dsp::concatenate<T>({ &before, &x, &after });
+		return pad(SignalView<T>(x), pad_width, values);
 	}
 
 	template<class T>
 	Signal<T> pad(const Signal<T>& x, std::pair<typename Signal<T>::size_type, typename Signal<T>::size_type> pad_width, 
 		std::pair<T, T> values = { T(), T() })
 	{
-		Signal<T> before(x.getSamplingRate_Hz(), std::vector<T>(pad_width.first, values.first));
-		Signal<T> after(x.getSamplingRate_Hz(), std::vector<T>(pad_width.second, values.second));
-
-		return dsp::concatenate<T>({ &before, &x, &after });
+		return Signal<T>(x.getSamplingRate_Hz(), pad(x.getSamples(), pad_width, values));
 	}
 	
 	/// @brief Splits a signal into frames
@@ -301,6 +588,10 @@ namespace dsp
 	template<class T>
 	std::vector<std::vector<T>> signalToFrames(const std::vector<T>& signal, unsigned frameLength, unsigned overlap);
 
+	/// @brief Splits a view (e.g., one channel of interleaved samples) into frames, copying only the frames
+	template<class T>
+	std::vector<std::vector<T>> signalToFrames(SignalView<T> signal, unsigned frameLength, unsigned overlap);
+
 	
 	namespace window
 	{
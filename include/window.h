@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "SignalView.h"
+
 /// @brief Window functions
 namespace dsp::window
 {
@@ -82,6 +84,18 @@ namespace dsp::window
 	template<class T>
 	std::vector<T> get_window(type type, unsigned N, bool sym = true, const std::vector<T>& parameters = {});
 
+	/// @brief Returns the samples of x multiplied by the window w (e.g., one frame viewed in a longer signal)
+	/// @tparam T Type of the samples
+	/// @param x Samples to window
+	/// @param w Window of the same length as x
+	/// @return The windowed samples
+	template<class T>
+	std::vector<T> apply(SignalView<T> x, const std::vector<T>& w);
+
+	/// @brief Returns the samples of x multiplied by a window of the given type and the same length
+	template<class T>
+	std::vector<T> apply(type type, SignalView<T> x, bool sym = true, const std::vector<T>& parameters = {});
+
 	/// @brief Return a boxcar or rectangular window
 	///
 	/// Also known as a rectangular window or Dirichlet window, this is equivalent to no window at all.
@@ -0,0 +1,111 @@
+#include "MultiSignal.h"
+
+#include "kernels.h"
+
+template<class T>
+dsp::MultiSignal<T>::MultiSignal(unsigned samplingRate_Hz, unsigned numChannels, size_t numFrames, ChannelLayout layout)
+	: samplingRate_Hz_(samplingRate_Hz), numChannels_(numChannels), numFrames_(numFrames), layout_(layout),
+	samples_(static_cast<size_t>(numChannels) * numFrames, T(0))
+{
+}
+
+template<class T>
+dsp::MultiSignal<T>::MultiSignal(unsigned samplingRate_Hz, const std::vector<std::vector<T>>& channels, ChannelLayout layout)
+	: MultiSignal(samplingRate_Hz, static_cast<unsigned>(channels.size()), channels.empty() ? 0 : channels.front().size(), layout)
+{
+	for (unsigned c = 0; c < numChannels_; ++c)
+	{
+		setChannel(c, channels[c]);
+	}
+}
+
+template<class T>
+void dsp::MultiSignal<T>::setLayout(ChannelLayout newLayout)
+{
+	if (newLayout == layout_) return;
+
+	AlignedVector<T> rearranged(samples_.size());
+	std::vector<T*> channels(numChannels_);
+	for (unsigned c = 0; c < numChannels_; ++c)
+	{
+		// Whichever buffer is planar holds channel c at offset c * numFrames
+		channels[c] = (newLayout == ChannelLayout::planar ? rearranged.data() : samples_.data()) + c * numFrames_;
+	}
+
+	if (newLayout == ChannelLayout::planar)
+	{
+		kernels::deinterleave(samples_.data(), numChannels_, channels.data(), numFrames_);
+	}
+	else
+	{
+		kernels::interleave(channels.data(), numChannels_, rearranged.data(), numFrames_);
+	}
+
+	samples_.swap(rearranged);
+	layout_ = newLayout;
+}
+
+template<class T>
+void dsp::MultiSignal<T>::assign(const T* samples, ChannelLayout samplesLayout)
+{
+	if (samplesLayout == layout_)
+	{
+		std::copy(samples, samples + samples_.size(), samples_.begin());
+		return;
+	}
+
+	if (layout_ == ChannelLayout::planar)
+	{
+		std::vector<T*> channels(numChannels_);
+		for (unsigned c = 0; c < numChannels_; ++c)
+		{
+			channels[c] = samples_.data() + c * numFrames_;
+		}
+		kernels::deinterleave(samples, numChannels_, channels.data(), numFrames_);
+	}
+	else
+	{
+		std::vector<const T*> channels(numChannels_);
+		for (unsigned c = 0; c < numChannels_; ++c)
+		{
+			channels[c] = samples + c * numFrames_;
+		}
+		kernels::interleave(channels.data(), numChannels_, samples_.data(), numFrames_);
+	}
+}
+
+template<class T>
+dsp::Signal<T> dsp::MultiSignal<T>::getChannel(unsigned channel) const
+{
+	if (channel >= numChannels_)
+	{
+		throw std::out_of_range("Channel index out of range!");
+	}
+	const auto view = this->channel(channel);
+	return Signal<T>(samplingRate_Hz_, std::vector<T>(view.begin(), view.end()));
+}
+
+template<class T>
+void dsp::MultiSignal<T>::setChannel(unsigned channel, SignalView<T> samples)
+{
+	if (channel >= numChannels_)
+	{
+		throw std::out_of_range("Channel index out of range!");
+	}
+	if (samples.size() != numFrames_)
+	{
+		throw std::invalid_argument("All channels must have the same number of samples!");
+	}
+
+	T* out = samples_.data() + channel * channelStride();
+	const auto stride = sampleStride();
+	for (size_t i = 0; i < numFrames_; ++i)
+	{
+		out[i * stride] = samples[i];
+	}
+}
+
+// Explicit template instantiation
+template class dsp::MultiSignal<float>;
+template class dsp::MultiSignal<double>;
+template class dsp::MultiSignal<long double>;
@@ -1,531 +1,553 @@
 #include "Signal.h"
 
-template<class T>
-dsp::Signal<T>::Signal(const Signal& other) : samplingRate_Hz_(other.samplingRate_Hz_), samples_(other.samples_)
+#include "allocators.h"
+#include "kernels.h"
+
+namespace
+{
+	// Signals of vectors (e.g., frames) are not contiguous and fall back to the element-wise helpers
+	template<class T>
+	struct is_vector : std::false_type {};
+
+	template<class T, class A>
+	struct is_vector<std::vector<T, A>> : std::true_type {};
+}
+
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(const Signal& other) : samplingRate_Hz_(other.samplingRate_Hz_), samples_(other.samples_)
+{
+}
+
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(Signal&& other) noexcept : samplingRate_Hz_(other.samplingRate_Hz_), samples_(std::move(other.samples_))
+{
+}
+
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(unsigned samplingRate_Hz) : samplingRate_Hz_(samplingRate_Hz)
+{
+}
+
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(unsigned samplingRate_Hz, const Allocator& allocator) : samplingRate_Hz_(samplingRate_Hz), samples_(allocator)
 {
 }
 
-template <class T>
-dsp::Signal<T>::Signal(Signal&& other) noexcept : samplingRate_Hz_(other.samplingRate_Hz_), samples_(std::move(other.samples_))
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(const container_type& samples) : samples_(samples)
 {
 }
 
-template <class T>
-dsp::Signal<T>::Signal(unsigned samplingRate_Hz) : samplingRate_Hz_(samplingRate_Hz)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(unsigned samplingRate_Hz, const container_type& samples) : samplingRate_Hz_(samplingRate_Hz), samples_(samples)
 {
 }
 
-template <class T>
-dsp::Signal<T>::Signal(const std::vector<T>& samples) : samples_(samples)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(container_type&& samples) noexcept : samples_(std::move(samples))
 {
 }
 
-template <class T>
-dsp::Signal<T>::Signal(unsigned samplingRate_Hz, const std::vector<T>& samples) : samplingRate_Hz_(samplingRate_Hz), samples_(samples)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>::Signal(unsigned samplingRate_Hz, container_type&& samples) noexcept : samplingRate_Hz_(samplingRate_Hz), samples_(std::move(samples))
 {
 }
 
-template <class T>
-const std::vector<T>& dsp::Signal<T>::getSamples() const
+template <class T, class Allocator>
+const typename dsp::Signal<T, Allocator>::container_type& dsp::Signal<T, Allocator>::getSamples() const&
 {
 	return samples_;
 }
 
-template <class T>
-std::vector<T>& dsp::Signal<T>::getSamples()
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::container_type& dsp::Signal<T, Allocator>::getSamples() &
 {
 	return samples_;
 }
 
-template <class T>
-unsigned dsp::Signal<T>::getSamplingRate_Hz() const
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::container_type dsp::Signal<T, Allocator>::getSamples() &&
+{
+	return std::move(samples_);
+}
+
+template <class T, class Allocator>
+unsigned dsp::Signal<T, Allocator>::getSamplingRate_Hz() const
 {
 	return samplingRate_Hz_;
 }
 
-template<class T>
-unsigned& dsp::Signal<T>::getSamplingRate_Hz()
+template <class T, class Allocator>
+unsigned& dsp::Signal<T, Allocator>::getSamplingRate_Hz()
 {
 	return samplingRate_Hz_;
 }
 
-template <class T>
-void dsp::Signal<T>::setSamples(const std::vector<T>& samples)
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::setSamples(const container_type& samples)
 {
 	samples_ = samples;
 }
 
-template <class T>
-void dsp::Signal<T>::setSamplingRate_Hz(unsigned newSamplingRate_Hz)
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::setSamples(container_type&& samples)
+{
+	samples_ = std::move(samples);
+}
+
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::setSamplingRate_Hz(unsigned newSamplingRate_Hz)
 {
 	samplingRate_Hz_ = newSamplingRate_Hz;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::plus(U& x, const U& y)
+void dsp::Signal<T, Allocator>::plus(U& x, const U& y)
 {
 	x += y;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::plus(std::vector<U>& x, const U& y)
+void dsp::Signal<T, Allocator>::plus(std::vector<U>& x, const U& y)
 {
 	std::transform(x.begin(), x.end(), x.begin(), [&y](auto& x) {return x + y; });
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::plus(std::vector<U>& x, const std::vector<U>& y)
+void dsp::Signal<T, Allocator>::plus(std::vector<U>& x, const std::vector<U>& y)
 {
 	std::transform(y.begin(), y.end(), x.begin(), x.begin(), std::plus<U>());
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator+=(const Signal<T>& rhs)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator+=(const Signal& rhs)
 {
 	if (this->samplingRate_Hz_ != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 	if (this->size() != rhs.size()) { throw std::logic_error("Signals have different lengths!"); }
 
-	for (size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
+	{
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			plus(samples_[i], rhs.samples_[i]);
+		}
+	}
+	else
 	{
-		plus(this->at(i), rhs[i]);
+		kernels::plus(samples_.data(), rhs.samples_.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator+=(const std::vector<T>& vec)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator+=(const container_type& vec)
 {
 	if (this->size() != vec.size()) { throw std::logic_error("Signal and vector have different lengths!"); }
 
-	for (size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
+	{
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			plus(samples_[i], vec[i]);
+		}
+	}
+	else
 	{
-		plus(this->at(i), vec[i]);
+		kernels::plus(samples_.data(), vec.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator+=(const_reference value)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator+=(const_reference value)
 {
-	for (auto& x : *this)
+	if constexpr (is_vector<T>::value)
 	{
-		plus(x, value);
-	}	
+		for (auto& x : samples_)
+		{
+			plus(x, value);
+		}
+	}
+	else
+	{
+		kernels::plus(samples_.data(), value, samples_.size());
+	}
 	return *this;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::minus(U& x, const U& y)
+void dsp::Signal<T, Allocator>::minus(U& x, const U& y)
 {
 	x -= y;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::minus(std::vector<U>& x, const U& y)
+void dsp::Signal<T, Allocator>::minus(std::vector<U>& x, const U& y)
 {
 	std::transform(x.begin(), x.end(), x.begin(), [&y](auto& x) {return x - y; });
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::minus(std::vector<U>& x, const std::vector<U>& y)
+void dsp::Signal<T, Allocator>::minus(std::vector<U>& x, const std::vector<U>& y)
 {
 	std::transform(y.begin(), y.end(), x.begin(), x.begin(), std::minus<>());
 }
 
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator-=(const Signal<T>& rhs)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator-=(const Signal& rhs)
 {
 	if (this->samplingRate_Hz_ != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 	if (this->size() != rhs.size()) { throw std::logic_error("Signals have different lengths!"); }
 
-	for(size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
 	{
-		minus(this->at(i), rhs[i]);
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			minus(samples_[i], rhs.samples_[i]);
+		}
+	}
+	else
+	{
+		kernels::minus(samples_.data(), rhs.samples_.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator-=(const std::vector<T>& vec)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator-=(const container_type& vec)
 {
 	if (this->size() != vec.size()) { throw std::logic_error("Signal and vector have different lengths!"); }
 
-	for (size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
+	{
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			minus(samples_[i], vec[i]);
+		}
+	}
+	else
 	{
-		minus(this->at(i), vec[i]);
+		kernels::minus(samples_.data(), vec.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator-=(const_reference value)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator-=(const_reference value)
 {
-	for (auto& x : *this)
+	if constexpr (is_vector<T>::value)
+	{
+		for (auto& x : samples_)
+		{
+			minus(x, value);
+		}
+	}
+	else
 	{
-		minus(x, value);
+		kernels::minus(samples_.data(), value, samples_.size());
 	}
 	return *this;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::multiplies(U& x, const U& y)
+void dsp::Signal<T, Allocator>::multiplies(U& x, const U& y)
 {
 	x *= y;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::multiplies(std::vector<U>& x, const U& y)
+void dsp::Signal<T, Allocator>::multiplies(std::vector<U>& x, const U& y)
 {
 	std::transform(x.begin(), x.end(), x.begin(), [&y](auto& x) {return x * y; });
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::multiplies(std::vector<U>& x, const std::vector<U>& y)
+void dsp::Signal<T, Allocator>::multiplies(std::vector<U>& x, const std::vector<U>& y)
 {
 	std::transform(y.begin(), y.end(), x.begin(), x.begin(), std::multiplies<>());
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator*=(const Signal<T>& rhs)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator*=(const Signal& rhs)
 {
 	if (this->samplingRate_Hz_ != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 	if (this->size() != rhs.size()) { throw std::logic_error("Signals have different lengths!"); }
 
-	for (size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
 	{
-		multiplies(this->at(i), rhs[i]);
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			multiplies(samples_[i], rhs.samples_[i]);
+		}
+	}
+	else
+	{
+		kernels::multiplies(samples_.data(), rhs.samples_.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator*=(const_reference value)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator*=(const_reference value)
 {
-	for (auto& x : *this)
+	if constexpr (is_vector<T>::value)
+	{
+		for (auto& x : samples_)
+		{
+			multiplies(x, value);
+		}
+	}
+	else
 	{
-		multiplies(x, value);
+		kernels::multiplies(samples_.data(), value, samples_.size());
 	}
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator*=(const std::vector<T>& vec)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator*=(const container_type& vec)
 {
 	if (this->size() != vec.size()) { throw std::logic_error("Signal and vector have different lengths!"); }
 
-	for (size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
+	{
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			multiplies(samples_[i], vec[i]);
+		}
+	}
+	else
 	{
-		multiplies(this->at(i), vec[i]);
+		kernels::multiplies(samples_.data(), vec.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::divides(U& x, const U& y)
+void dsp::Signal<T, Allocator>::divides(U& x, const U& y)
 {
 	x /= y;
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::divides(std::vector<U>& x, const U& y)
+void dsp::Signal<T, Allocator>::divides(std::vector<U>& x, const U& y)
 {
 	std::transform(x.begin(), x.end(), x.begin(), [&y](auto& x) {return x / y; });
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-void dsp::Signal<T>::divides(std::vector<U>& x, const std::vector<U>& y)
+void dsp::Signal<T, Allocator>::divides(std::vector<U>& x, const std::vector<U>& y)
 {
 	std::transform(y.begin(), y.end(), x.begin(), x.begin(), std::divides<>());
 }
 
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator/=(const Signal<T>& rhs)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator/=(const Signal& rhs)
 {
 	if (this->samplingRate_Hz_ != rhs.getSamplingRate_Hz()) { throw std::logic_error("Signals have different sampling rates!"); }
 	if (this->size() != rhs.size()) { throw std::logic_error("Signals have different lengths!"); }
 
-	for (size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
 	{
-		divides(this->at(i), rhs[i]);
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			divides(samples_[i], rhs.samples_[i]);
+		}
+	}
+	else
+	{
+		kernels::divides(samples_.data(), rhs.samples_.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator/=(const std::vector<T>& vec)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator/=(const container_type& vec)
 {
 	if (this->size() != vec.size()) { throw std::logic_error("Signal and vector have different lengths!"); }
 
-	for (size_type i = 0; i < this->size(); ++i)
+	if constexpr (is_vector<T>::value)
+	{
+		for (size_type i = 0; i < samples_.size(); ++i)
+		{
+			divides(samples_[i], vec[i]);
+		}
+	}
+	else
 	{
-		divides(this->at(i), vec[i]);
+		kernels::divides(samples_.data(), vec.data(), samples_.size());
 	}
 
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator/=(const_reference value)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator/=(const_reference value)
 {
-	for (auto& x : *this)
+	if constexpr (is_vector<T>::value)
+	{
+		for (auto& x : samples_)
+		{
+			divides(x, value);
+		}
+	}
+	else
 	{
-		divides(x, value);
+		kernels::divides(samples_.data(), value, samples_.size());
 	}
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::assign(size_type count, const T& value)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::assign(size_type count, const T& value)
 {
 	samples_.assign(count, value); return *this;
 }
 
-template <class T>
-typename dsp::Signal<T>::reference dsp::Signal<T>::at(size_type pos)
-{
-	return samples_.at(pos);
-}
-
-template <class T>
-const T& dsp::Signal<T>::at(size_type pos) const
-{
-	return samples_.at(pos);
-}
-
-template <class T>
-typename dsp::Signal<T>::value_type dsp::Signal<T>::getValue(size_type pos) const
-{
-	return samples_[pos];
-}
-
-template <class T>
-typename dsp::Signal<T>::reference dsp::Signal<T>::front()
-{
-	return samples_.front();
-}
-
-template <class T>
-const T& dsp::Signal<T>::front() const
-{
-	return samples_.front();
-}
-
-template <class T>
-typename dsp::Signal<T>::reference dsp::Signal<T>::back()
-{
-	return samples_.back();
-}
-
-template <class T>
-const T& dsp::Signal<T>::back() const
-{
-	return samples_.back();
-}
-
-template<class T>
-T* dsp::Signal<T>::data()
-{
-	return samples_.data();
-}
-
-template <class T>
-const T* dsp::Signal<T>::data() const
-{
-	return samples_.data();
-}
-
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::begin()
-{
-	return samples_.begin();
-}
-
-template <class T>
-typename dsp::Signal<T>::const_iterator dsp::Signal<T>::begin() const
-{
-	return samples_.begin();
-}
-
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::end()
-{
-	return samples_.end();
-}
-
-template <class T>
-typename dsp::Signal<T>::const_iterator dsp::Signal<T>::end() const
-{
-	return samples_.end();
-}
-
-template <class T>
-typename dsp::Signal<T>::reverse_iterator dsp::Signal<T>::rbegin()
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::reverse_iterator dsp::Signal<T, Allocator>::rbegin()
 {
 	return samples_.rbegin();
 }
 
-template <class T>
-typename dsp::Signal<T>::const_reverse_iterator dsp::Signal<T>::rbegin() const
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::const_reverse_iterator dsp::Signal<T, Allocator>::rbegin() const
 {
 	return samples_.rbegin();
 }
 
-template <class T>
-bool dsp::Signal<T>::empty() const
-{
-	return samples_.empty();
-}
-
-template <class T>
-typename dsp::Signal<T>::size_type dsp::Signal<T>::size() const
-{
-	return samples_.size();
-}
-
-template <class T>
-typename dsp::Signal<T>::size_type dsp::Signal<T>::max_size() const
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::size_type dsp::Signal<T, Allocator>::max_size() const
 {
 	return samples_.max_size();
 }
 
-template <class T>
-void dsp::Signal<T>::reserve(size_type new_cap)
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::reserve(size_type new_cap)
 {
 	samples_.reserve(new_cap);
 }
 
-template <class T>
-typename dsp::Signal<T>::size_type dsp::Signal<T>::capacity() const
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::size_type dsp::Signal<T, Allocator>::capacity() const
 {
 	return samples_.capacity();
 }
 
-template <class T>
-void dsp::Signal<T>::shrink_to_fit()
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::shrink_to_fit()
 {
 	samples_.shrink_to_fit();
 }
 
-template <class T>
-void dsp::Signal<T>::clear()
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::clear()
 {
 	samples_.clear();
 }
 
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::insert(const_iterator pos, const value_type& value)
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::iterator dsp::Signal<T, Allocator>::insert(const_iterator pos, const value_type& value)
 {
 	return samples_.insert(pos, value);
 }
 
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::insert(const_iterator pos, value_type&& value)
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::iterator dsp::Signal<T, Allocator>::insert(const_iterator pos, value_type&& value)
 {
 	return samples_.insert(pos, value);
 }
 
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::insert(const_iterator pos, size_type count, const value_type& value)
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::iterator dsp::Signal<T, Allocator>::insert(const_iterator pos, size_type count, const value_type& value)
 {
 	return samples_.insert(pos, count, value);
 }
 
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::insert(const_iterator pos, std::initializer_list<T> ilist)
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::iterator dsp::Signal<T, Allocator>::insert(const_iterator pos, std::initializer_list<T> ilist)
 {
 	return samples_.insert(pos, ilist);
 }
 
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::erase(const_iterator pos)
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::iterator dsp::Signal<T, Allocator>::erase(const_iterator pos)
 {
 	return samples_.erase(pos);
 }
 
-template <class T>
-typename dsp::Signal<T>::iterator dsp::Signal<T>::erase(const_iterator first, const_iterator last)
+template <class T, class Allocator>
+typename dsp::Signal<T, Allocator>::iterator dsp::Signal<T, Allocator>::erase(const_iterator first, const_iterator last)
 {
 	return samples_.erase(first, last);
 }
 
-template <class T>
-void dsp::Signal<T>::push_back(const T& value)
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::push_back(const T& value)
 {
 	samples_.push_back(value);
 }
 
-template <class T>
-void dsp::Signal<T>::push_back(T&& value)
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::push_back(T&& value)
 {
 	samples_.push_back(value);
 }
 
-template <class T>
-void dsp::Signal<T>::pop_back()
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::pop_back()
 {
 	samples_.pop_back();
 }
 
-template <class T>
-void dsp::Signal<T>::resize(size_type count)
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::resize(size_type count)
 {
 	samples_.resize(count);
 }
 
-template <class T>
-void dsp::Signal<T>::resize(size_type count, const value_type value)
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::resize(size_type count, const value_type value)
 {
 	samples_.resize(count, value);
 }
 
-template <class T>
-void dsp::Signal<T>::swap(Signal& other) noexcept
+template <class T, class Allocator>
+void dsp::Signal<T, Allocator>::swap(Signal& other) noexcept
 {
 	samples_.swap(other.getSamples());
 }
 
-template <class T>
-typename dsp::Signal<T>::reference dsp::Signal<T>::operator[](size_type pos)
-{
-	return samples_[pos];
-}
-
-template <class T>
-typename dsp::Signal<T>::const_reference dsp::Signal<T>::operator[](size_type pos) const
-{
-	return samples_[pos];
-}
-
-template <class T>
-auto dsp::Signal<T>::real(const T& c)
+template <class T, class Allocator>
+auto dsp::Signal<T, Allocator>::real(const T& c)
 {
 	return std::real<T>(c);
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-auto dsp::Signal<T>::imag(const std::vector<U>& c)
+auto dsp::Signal<T, Allocator>::imag(const std::vector<U>& c)
 {
 	using V = decltype(imag(std::declval<U>()));
 	std::vector<V> imagPart;
@@ -534,15 +556,15 @@ auto dsp::Signal<T>::imag(const std::vector<U>& c)
 	return imagPart;
 }
 
-template <class T>
-auto dsp::Signal<T>::imag(const T& c)
+template <class T, class Allocator>
+auto dsp::Signal<T, Allocator>::imag(const T& c)
 {
 	return std::imag<T>(c);
 }
 
-template <class T>
+template <class T, class Allocator>
 template <class U>
-auto dsp::Signal<T>::real(const std::vector<U>& c)
+auto dsp::Signal<T, Allocator>::real(const std::vector<U>& c)
 {
 	using V = decltype(real(std::declval<U>()));
 	std::vector<V> realPart;
@@ -552,33 +574,33 @@ auto dsp::Signal<T>::real(const std::vector<U>& c)
 }
 
 
-template <class T>
-auto dsp::Signal<T>::real() const
+template <class T, class Allocator>
+auto dsp::Signal<T, Allocator>::real() const
 {
 	using U = decltype(real(std::declval<T>()));
 	Signal<U> realPart(this->getSamplingRate_Hz());
 	realPart.reserve(this->size());
 
 	realPart.setSamplingRate_Hz(this->getSamplingRate_Hz());
-	std::transform(samples_.begin(), samples_.end(), std::back_inserter(realPart), [this](auto c) {return Signal<T>::real(c); });
+	std::transform(samples_.begin(), samples_.end(), std::back_inserter(realPart), [this](auto c) {return Signal::real(c); });
 	return realPart;
 }
 
-template <class T>
-auto dsp::Signal<T>::imag() const
+template <class T, class Allocator>
+auto dsp::Signal<T, Allocator>::imag() const
 {
 	using U = decltype(real(std::declval<T>()));
 	Signal<U> imagPart(this->getSamplingRate_Hz());
 	imagPart.reserve(this->size());
 
 	imagPart.setSamplingRate_Hz(this->getSamplingRate_Hz());
-	std::transform(samples_.begin(), samples_.end(), std::back_inserter(imagPart), [this](auto c) {return Signal<T>::imag(c); });
+	std::transform(samples_.begin(), samples_.end(), std::back_inserter(imagPart), [this](auto c) {return Signal::imag(c); });
 	return imagPart;
 }
 
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator=(const Signal& other)
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator=(const Signal& other)
 {
 	if (this != &other)  // Self-assignment protection
 	{
@@ -588,8 +610,8 @@ dsp::Signal<T>& dsp::Signal<T>::operator=(const Signal& other)
 	return *this;
 }
 
-template <class T>
-dsp::Signal<T>& dsp::Signal<T>::operator=(Signal&& other) noexcept
+template <class T, class Allocator>
+dsp::Signal<T, Allocator>& dsp::Signal<T, Allocator>::operator=(Signal&& other) noexcept
 {
 	this->samplingRate_Hz_ = other.samplingRate_Hz_;
 	this->samples_ = std::move(other.samples_);
@@ -621,3 +643,22 @@ template class dsp::Signal<std::vector<float>>;
 template class dsp::Signal<std::vector<double>>;
 template class dsp::Signal<std::vector<long double>>;
 
+// Signals with aligned, pooled, and polymorphic storage (see allocators.h)
+template class dsp::Signal<float, dsp::AlignedAllocator<float>>;
+template class dsp::Signal<std::complex<float>, dsp::AlignedAllocator<std::complex<float>>>;
+template class dsp::Signal<double, dsp::AlignedAllocator<double>>;
+template class dsp::Signal<std::complex<double>, dsp::AlignedAllocator<std::complex<double>>>;
+template class dsp::Signal<long double, dsp::AlignedAllocator<long double>>;
+template class dsp::Signal<std::complex<long double>, dsp::AlignedAllocator<std::complex<long double>>>;
+template class dsp::Signal<float, dsp::PoolAllocator<float>>;
+template class dsp::Signal<std::complex<float>, dsp::PoolAllocator<std::complex<float>>>;
+template class dsp::Signal<double, dsp::PoolAllocator<double>>;
+template class dsp::Signal<std::complex<double>, dsp::PoolAllocator<std::complex<double>>>;
+template class dsp::Signal<long double, dsp::PoolAllocator<long double>>;
+template class dsp::Signal<std::complex<long double>, dsp::PoolAllocator<std::complex<long double>>>;
+template class dsp::Signal<float, std::pmr::polymorphic_allocator<float>>;
+template class dsp::Signal<std::complex<float>, std::pmr::polymorphic_allocator<std::complex<float>>>;
+template class dsp::Signal<double, std::pmr::polymorphic_allocator<double>>;
+template class dsp::Signal<std::complex<double>, std::pmr::polymorphic_allocator<std::complex<double>>>;
+template class dsp::Signal<long double, std::pmr::polymorphic_allocator<long double>>;
+template class dsp::Signal<std::complex<long double>, std::pmr::polymorphic_allocator<std::complex<long double>>>;
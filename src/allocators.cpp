@@ -0,0 +1,126 @@
+#include "allocators.h"
+
+namespace
+{
+	constexpr size_t numberOfSizeClasses(size_t min, size_t max)
+	{
+		size_t n = 1;
+		for (; min < max; min <<= 1) { ++n; }
+		return n;
+	}
+
+	void* allocateAligned(size_t bytes)
+	{
+		return ::operator new(bytes, std::align_val_t(dsp::simdAlignment));
+	}
+
+	void deallocateAligned(void* p) noexcept
+	{
+		::operator delete(p, std::align_val_t(dsp::simdAlignment));
+	}
+
+	// Adapts the shared MemoryPool to the std::pmr interface
+	class PoolResource : public std::pmr::memory_resource
+	{
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			if (alignment > dsp::simdAlignment) { throw std::bad_alloc(); }
+			return dsp::MemoryPool::instance().allocate(bytes);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t) override
+		{
+			dsp::MemoryPool::instance().deallocate(p, bytes);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+}
+
+dsp::MemoryPool& dsp::MemoryPool::instance()
+{
+	static MemoryPool pool;
+	return pool;
+}
+
+dsp::MemoryPool::~MemoryPool()
+{
+	release();
+}
+
+size_t dsp::MemoryPool::sizeClass(size_t bytes)
+{
+	size_t index = 0;
+	for (size_t blockSize = minBlockSize; blockSize < bytes; blockSize <<= 1) { ++index; }
+	return index;
+}
+
+void* dsp::MemoryPool::allocate(size_t bytes)
+{
+	if (bytes > maxBlockSize) { return allocateAligned(bytes); }
+
+	const auto index = sizeClass(bytes);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (index < freeLists_.size() && !freeLists_[index].empty())
+		{
+			void* p = freeLists_[index].back();
+			freeLists_[index].pop_back();
+			return p;
+		}
+	}
+	// Allocate outside the lock; the block joins the pool when it is returned
+	return allocateAligned(minBlockSize << index);
+}
+
+void dsp::MemoryPool::deallocate(void* p, size_t bytes) noexcept
+{
+	if (p == nullptr) { return; }
+	if (bytes > maxBlockSize)
+	{
+		deallocateAligned(p);
+		return;
+	}
+
+	const auto index = sizeClass(bytes);
+	std::lock_guard<std::mutex> lock(mutex_);
+	try
+	{
+		if (freeLists_.empty()) { freeLists_.resize(numberOfSizeClasses(minBlockSize, maxBlockSize)); }
+		freeLists_[index].push_back(p);
+	}
+	catch (...)
+	{
+		// The free list could not grow, so give the block back to the system instead
+		deallocateAligned(p);
+	}
+}
+
+void dsp::MemoryPool::release()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (auto& freeList : freeLists_)
+	{
+		for (void* p : freeList) { deallocateAligned(p); }
+		freeList.clear();
+		freeList.shrink_to_fit();
+	}
+}
+
+size_t dsp::MemoryPool::cachedBlocks() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t n = 0;
+	for (const auto& freeList : freeLists_) { n += freeList.size(); }
+	return n;
+}
+
+std::pmr::memory_resource* dsp::poolResource()
+{
+	static PoolResource resource;
+	return &resource;
+}
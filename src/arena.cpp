@@ -0,0 +1,112 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+dsp::ScratchArena::ScratchArena(size_t initialCapacity)
+{
+	if (initialCapacity > 0)
+	{
+		addChunk(initialCapacity);
+	}
+}
+
+dsp::ScratchArena::~ScratchArena()
+{
+	releaseChunks();
+}
+
+void* dsp::ScratchArena::allocate(size_t bytes, size_t alignment)
+{
+	if (alignment == 0 || alignment > simdAlignment || (alignment & (alignment - 1)) != 0)
+	{
+		throw std::invalid_argument("Alignment must be a power of two not larger than simdAlignment!");
+	}
+
+	// Chunks are aligned to simdAlignment, so aligning the offset aligns the pointer
+	while (current_ < chunks_.size())
+	{
+		const auto offset = (offset_ + alignment - 1) & ~(alignment - 1);
+		if (offset <= chunks_[current_].size && bytes <= chunks_[current_].size - offset)
+		{
+			offset_ = offset + bytes;
+			return chunks_[current_].data + offset;
+		}
+		// Continue in the next chunk that earlier, larger allocations left behind
+		++current_;
+		offset_ = 0;
+	}
+
+	addChunk(bytes);
+	offset_ = bytes;
+	return chunks_[current_].data;
+}
+
+void dsp::ScratchArena::rewind(const Marker& marker)
+{
+	current_ = marker.chunk;
+	offset_ = marker.offset;
+
+	// Once the arena is empty, merge all chunks, so that the next round of allocations fits into a single one
+	if (current_ == 0 && offset_ == 0 && chunks_.size() > 1)
+	{
+		const auto total = capacity();
+		releaseChunks();
+		addChunk(total);
+		current_ = 0;
+	}
+}
+
+size_t dsp::ScratchArena::used() const
+{
+	size_t bytes = offset_;
+	for (size_t i = 0; i < current_ && i < chunks_.size(); ++i)
+	{
+		bytes += chunks_[i].size;
+	}
+	return bytes;
+}
+
+size_t dsp::ScratchArena::capacity() const
+{
+	size_t bytes = 0;
+	for (const auto& chunk : chunks_)
+	{
+		bytes += chunk.size;
+	}
+	return bytes;
+}
+
+void dsp::ScratchArena::addChunk(size_t minimumSize)
+{
+	// Grow geometrically, so that a growing workload needs only a logarithmic number of chunks
+	constexpr size_t minimumChunkSize = 4096;
+	auto size = std::max(minimumSize, minimumChunkSize);
+	if (!chunks_.empty())
+	{
+		size = std::max(size, 2 * chunks_.back().size);
+	}
+	size = (size + simdAlignment - 1) & ~(simdAlignment - 1);
+
+	auto* data = static_cast<std::byte*>(::operator new(size, std::align_val_t(simdAlignment)));
+	chunks_.push_back({ data, size });
+	current_ = chunks_.size() - 1;
+}
+
+void dsp::ScratchArena::releaseChunks()
+{
+	for (const auto& chunk : chunks_)
+	{
+		::operator delete(chunk.data, std::align_val_t(simdAlignment));
+	}
+	chunks_.clear();
+	current_ = 0;
+	offset_ = 0;
+}
+
+dsp::ScratchArena& dsp::threadScratch()
+{
+	thread_local ScratchArena arena;
+	return arena;
+}
@@ -1,15 +1,18 @@
 #include "fft.h"
 
 #include <algorithm>
-#include <execution>
+#include <mutex>
 
 #ifndef ZERO_DEPENDENCIES
 #include <fftw3/fftw3.h>
 #endif
 
+#include "allocators.h"
+#include "arena.h"
 #include "filter.h"
 #include "Signal.h"
 #include "signals.h"
+#include "threadpool.h"
 
 
 namespace dsp::fft
@@ -17,8 +20,8 @@ namespace dsp::fft
 	/// @cond developer-only
 
 	/// @brief Helper function to get the FFT length
-	template<class T>
-	auto get_fft_length(const std::vector<T>& x, unsigned n)
+	template<class Container>
+	auto get_fft_length(const Container& x, unsigned n)
 	{
 		if (n == 0)
 		{
@@ -35,15 +38,12 @@ namespace dsp::fft
 	}
 
 	/* Straight-forward FFT implementations (high-performance for short signals) */
+
+	// In-place radix-2 FFT of the N complex values in X (N must be a power of two)
 	template<class T>
-	std::vector<std::complex<T>> fft_(const std::vector<std::complex<T>>& x, unsigned n, NormalizationMode mode)
+	void fftInPlace(std::complex<T>* X, int N)
 	{
-		if (x.empty()) return {};
-
-		int N = get_fft_length(x, n);
-
-		std::vector<std::complex<T>> X = resize_fft_input(x, N);
-		auto* in = reinterpret_cast<T*>(&X[0]);
+		auto* in = reinterpret_cast<T*>(X);
 
 		int nm1 = N - 1;
 		int nd2 = N / 2;
@@ -95,6 +95,17 @@ namespace dsp::fft
 				u[1] = t[0] * s[1] + u[1] * s[0];
 			}
 		}
+	}
+
+	template<class T>
+	std::vector<std::complex<T>> fft_(const std::vector<std::complex<T>>& x, unsigned n, NormalizationMode mode)
+	{
+		if (x.empty()) return {};
+
+		int N = get_fft_length(x, n);
+
+		std::vector<std::complex<T>> X = resize_fft_input(x, N);
+		fftInPlace(X.data(), N);
 
 		switch (mode)
 		{
@@ -138,29 +149,20 @@ namespace dsp::fft
 		return dsp::conj(X);
 	}
 
+	// Real-input FFT of the N real values in x into the N complex values of X (N must be a power of two)
 	template<class T>
-	std::vector<std::complex<T>> rfft_(const std::vector<T>& x, unsigned n, NormalizationMode mode)
+	void rfftInPlace(const T* x, std::complex<T>* X, unsigned N)
 	{
-		if (x.empty()) return {};
-
-		unsigned N = get_fft_length(x, n);
-
-		std::vector<T> x_in = resize_fft_input(x, N);
-
-		auto* in = reinterpret_cast<T*>(&x_in[0]);
-
-		std::vector<std::complex<T>> X(N);
-
+		// Transform the samples as N / 2 complex values and untangle the spectra of the even and odd samples afterwards
 		for (unsigned i = 0; i < N / 2; ++i)
 		{
-			X[i].real(in[2 * i]);
-			X[i].imag(in[2 * i + 1]);
+			X[i] = { x[2 * i], x[2 * i + 1] };
 		}
 
-		X = fft_(X, N / 2, NormalizationMode::backward);
-		X.resize(N, { 0.0, 0.0 });
+		fftInPlace(X, static_cast<int>(N / 2));
+		std::fill(X + N / 2, X + N, std::complex<T>(0.0, 0.0));
 
-		auto* out = reinterpret_cast<T*>(&X[0]);
+		auto* out = reinterpret_cast<T*>(X);
 
 		unsigned nm1 = N - 1;
 		unsigned nd2 = N / 2;
@@ -215,7 +217,27 @@ namespace dsp::fft
 			u[0] = t[0] * s[0] - u[1] * s[1];
 			u[1] = t[0] * s[1] + u[1] * s[0];
 		}
+	}
 
+	template<class T>
+	std::vector<std::complex<T>> rfft_(SignalView<T> x, unsigned n, NormalizationMode mode)
+	{
+		if (x.empty()) return {};
+
+		unsigned N = get_fft_length(x, n);
+
+		std::vector<std::complex<T>> X(N);
+		if (x.isContiguous() && x.size() >= N)
+		{
+			// The transform only reads the first N samples, so contiguous input needs no copy
+			rfftInPlace(x.data(), X.data(), N);
+		}
+		else
+		{
+			std::vector<T> x_in(N, T());
+			std::copy_n(x.begin(), std::min<size_t>(x.size(), N), x_in.begin());
+			rfftInPlace(x_in.data(), X.data(), N);
+		}
 
 		switch (mode)
 		{
@@ -262,7 +284,7 @@ namespace dsp::fft
 			mode = NormalizationMode::backward;
 		}
 		auto xre = dsp::real(x_in);
-		auto X = rfft_(xre, N, mode);
+		auto X = rfft_<T>(xre, N, mode);
 
 		for (unsigned i = 0; i < N; ++i)
 		{
@@ -274,6 +296,40 @@ namespace dsp::fft
 
 #ifndef ZERO_DEPENDENCIES
 	/* Wrapper functions for FFTW library functions of various precisions (high-performance for long signals) */
+
+	// Only fftw_execute() is thread-safe, so plans are created and destroyed under a lock (e.g., when the channels of a
+	// MultiSignal are transformed in parallel)
+	std::mutex& plannerMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	template<class MakePlan, class Execute, class Destroy>
+	void executePlan(MakePlan makePlan, Execute execute, Destroy destroy)
+	{
+		const auto p = [&]
+		{
+			std::lock_guard<std::mutex> lock(plannerMutex());
+			return makePlan();
+		}();
+		execute(p);
+		std::lock_guard<std::mutex> lock(plannerMutex());
+		destroy(p);
+	}
+
+	// Returns x if it holds at least the N values that a transform reads, and a zero-padded copy of x in buffer
+	// otherwise. FFTW_ESTIMATE plans of out-of-place forward transforms do not write to their input. Plans are created
+	// for the actual arrays, so FFTW picks its SIMD codelets whenever their alignment allows it (no aligned copies).
+	template<class U>
+	U* transformInput(const U* x, size_t size, size_t N, AlignedVector<U>& buffer)
+	{
+		if (size >= N) return const_cast<U*>(x);
+		buffer.assign(N, U(0));
+		std::copy_n(x, size, buffer.begin());
+		return buffer.data();
+	}
+
 	auto fftw(const std::vector<std::complex<float>>& x, unsigned n, int sign, unsigned flags, NormalizationMode mode)
 	{
 		if (x.empty()) return std::vector<std::complex<float>>();
@@ -281,14 +337,10 @@ namespace dsp::fft
 		unsigned N = get_fft_length(x, n);
 
 		std::vector<std::complex<float>> X(N);
-		std::vector<std::complex<float>> x_copy = x;
-		x_copy.resize(N, 0.0);
-		fftwf_complex* in = reinterpret_cast<fftwf_complex*>(&x_copy[0]);
-
-		auto* out = reinterpret_cast<fftwf_complex*>(&X[0]);
-		const auto p = fftwf_plan_dft_1d(N, in, out, sign, flags);
+		AlignedVector<std::complex<float>> padded;
+		fftwf_complex* in = reinterpret_cast<fftwf_complex*>(transformInput(x.data(), x.size(), N, padded));
 
-		fftwf_execute(p);
+		executePlan([&] { return fftwf_plan_dft_1d(N, in, reinterpret_cast<fftwf_complex*>(X.data()), sign, flags); }, fftwf_execute, fftwf_destroy_plan);
 
 
 		switch (mode)
@@ -313,7 +365,6 @@ namespace dsp::fft
 			break;
 		}
 
-		fftwf_destroy_plan(p);
 		return X;
 	}
 	auto fftw(const std::vector<std::complex<double>>& x, unsigned n, int sign, unsigned flags, NormalizationMode mode)
@@ -323,14 +374,10 @@ namespace dsp::fft
 		unsigned N = get_fft_length(x, n);
 
 		std::vector<std::complex<double>> X(N);
-		std::vector<std::complex<double>> x_copy = x;
-		x_copy.resize(N, 0.0);
-		fftw_complex* in = reinterpret_cast<fftw_complex*>(&x_copy[0]);
+		AlignedVector<std::complex<double>> padded;
+		fftw_complex* in = reinterpret_cast<fftw_complex*>(transformInput(x.data(), x.size(), N, padded));
 
-		auto* out = reinterpret_cast<fftw_complex*>(&X[0]);
-		const auto p = fftw_plan_dft_1d(N, in, out, sign, flags);
-
-		fftw_execute(p);
+		executePlan([&] { return fftw_plan_dft_1d(N, in, reinterpret_cast<fftw_complex*>(X.data()), sign, flags); }, fftw_execute, fftw_destroy_plan);
 
 
 		switch (mode)
@@ -355,7 +402,6 @@ namespace dsp::fft
 			break;
 		}
 
-		fftw_destroy_plan(p);
 		return X;
 	}
 	auto fftw(const std::vector<std::complex<long double>>& x, unsigned n, int sign, unsigned flags, NormalizationMode mode)
@@ -365,15 +411,11 @@ namespace dsp::fft
 		unsigned N = get_fft_length(x, n);
 
 		std::vector<std::complex<long double>> X(N);
-		std::vector<std::complex<long double>> x_copy = x;
-		x_copy.resize(N, 0.0);
-		fftwl_complex* in = reinterpret_cast<fftwl_complex*>(&x_copy[0]);
-
+		AlignedVector<std::complex<long double>> padded;
+		fftwl_complex* in = reinterpret_cast<fftwl_complex*>(transformInput(x.data(), x.size(), N, padded));
 
-		auto* out = reinterpret_cast<fftwl_complex*>(&X[0]);
-		const auto p = fftwl_plan_dft_1d(N, in, out, sign, flags);
 
-		fftwl_execute(p);
+		executePlan([&] { return fftwl_plan_dft_1d(N, in, reinterpret_cast<fftwl_complex*>(X.data()), sign, flags); }, fftwl_execute, fftwl_destroy_plan);
 
 
 		switch (mode)
@@ -398,25 +440,31 @@ namespace dsp::fft
 			break;
 		}
 
-		fftwl_destroy_plan(p);
 		return X;
 	}
-	auto rfftw(const std::vector<double>& x, unsigned n, unsigned flags, NormalizationMode mode)
+	auto rfftw(SignalView<double> x, unsigned n, unsigned flags, NormalizationMode mode)
 	{
 		if (x.empty()) return std::vector<std::complex<double>>();
 
 		unsigned N = get_fft_length(x, n);
 
 		std::vector<std::complex<double>> X(static_cast<size_t>(N / 2 + 1));
-		std::vector<double> x_copy = x;
-		x_copy.resize(N, 0.0);
-		double* in = &x_copy[0];
-
+		// Contiguous views are read in place, strided ones are gathered (and zero-padded) once
+		AlignedVector<double> padded;
+		double* in;
+		if (x.isContiguous())
+		{
+			in = transformInput(x.data(), x.size(), N, padded);
+		}
+		else
+		{
+			padded.assign(N, 0.0);
+			std::copy_n(x.begin(), std::min<size_t>(x.size(), N), padded.begin());
+			in = padded.data();
+		}
 
-		auto* out = reinterpret_cast<fftw_complex*>(&X[0]);
-		auto* p = fftw_plan_dft_r2c_1d(N, in, out, flags);
 
-		fftw_execute(p);
+		executePlan([&] { return fftw_plan_dft_r2c_1d(N, in, reinterpret_cast<fftw_complex*>(X.data()), flags); }, fftw_execute, fftw_destroy_plan);
 
 
 		switch (mode)
@@ -434,25 +482,31 @@ namespace dsp::fft
 		}
 		auto Xconj = dsp::conj(X);
 		X.insert(X.end(), Xconj.rbegin() + 1, Xconj.rend() - 1);
-		fftw_destroy_plan(p);
 		return X;
 	}
-	auto rfftw(const std::vector<float>& x, unsigned n, unsigned flags, NormalizationMode mode)
+	auto rfftw(SignalView<float> x, unsigned n, unsigned flags, NormalizationMode mode)
 	{
 		if (x.empty()) return std::vector<std::complex<float>>();
 
 		unsigned N = get_fft_length(x, n);
 
 		std::vector<std::complex<float>> X(N);
-		std::vector<float> x_copy = x;
-		x_copy.resize(N, 0.0);
-		float* in = &x_copy[0];
-
+		// Contiguous views are read in place, strided ones are gathered (and zero-padded) once
+		AlignedVector<float> padded;
+		float* in;
+		if (x.isContiguous())
+		{
+			in = transformInput(x.data(), x.size(), N, padded);
+		}
+		else
+		{
+			padded.assign(N, 0.0);
+			std::copy_n(x.begin(), std::min<size_t>(x.size(), N), padded.begin());
+			in = padded.data();
+		}
 
-		auto* out = reinterpret_cast<fftwf_complex*>(&X[0]);
-		const auto p = fftwf_plan_dft_r2c_1d(N, in, out, flags);
 
-		fftwf_execute(p);
+		executePlan([&] { return fftwf_plan_dft_r2c_1d(N, in, reinterpret_cast<fftwf_complex*>(X.data()), flags); }, fftwf_execute, fftwf_destroy_plan);
 
 
 		switch (mode)
@@ -472,24 +526,30 @@ namespace dsp::fft
 		auto Xconj = dsp::conj(X);
 		X.insert(X.end(), Xconj.rbegin() + 1, Xconj.rend() - 1);
 
-		fftwf_destroy_plan(p);
 		return X;
 	}
-	auto rfftw(const std::vector<long double>& x, unsigned n, unsigned flags, NormalizationMode mode)
+	auto rfftw(SignalView<long double> x, unsigned n, unsigned flags, NormalizationMode mode)
 	{
 		if (x.empty()) return std::vector<std::complex<long double>>();
 
 		unsigned N = get_fft_length(x, n);
 
 		std::vector<std::complex<long double>> X(N);
-		std::vector<long double> x_copy = x;
-		x_copy.resize(N, 0.0);
-		long double* in = &x_copy[0];
-
-		auto* out = reinterpret_cast<fftwl_complex*>(&X[0]);
-		const auto p = fftwl_plan_dft_r2c_1d(N, in, out, flags);
+		// Contiguous views are read in place, strided ones are gathered (and zero-padded) once
+		AlignedVector<long double> padded;
+		long double* in;
+		if (x.isContiguous())
+		{
+			in = transformInput(x.data(), x.size(), N, padded);
+		}
+		else
+		{
+			padded.assign(N, 0.0);
+			std::copy_n(x.begin(), std::min<size_t>(x.size(), N), padded.begin());
+			in = padded.data();
+		}
 
-		fftwl_execute(p);
+		executePlan([&] { return fftwl_plan_dft_r2c_1d(N, in, reinterpret_cast<fftwl_complex*>(X.data()), flags); }, fftwl_execute, fftwl_destroy_plan);
 
 
 		switch (mode)
@@ -509,7 +569,6 @@ namespace dsp::fft
 		auto Xconj = dsp::conj(X);
 		X.insert(X.end(), Xconj.rbegin() + 1, Xconj.rend() - 1);
 
-		fftwl_destroy_plan(p);
 		return X;
 	}
 	auto irfftw(const std::vector<std::complex<float>>& X, unsigned n, unsigned flags, NormalizationMode mode)
@@ -519,14 +578,11 @@ namespace dsp::fft
 		unsigned N = get_fft_length(X, n);
 
 		std::vector<float> x(N);
-		std::vector<std::complex<float>> X_copy = X;
+		AlignedVector<std::complex<float>> X_copy(X.begin(), X.end());
 		X_copy.resize(N, 0.0);
 		fftwf_complex* in = reinterpret_cast<fftwf_complex*>(&X_copy[0]);
 
-		auto* out = &x[0];
-		const auto p = fftwf_plan_dft_c2r_1d(N, in, out, flags);
-
-		fftwf_execute(p);
+		executePlan([&] { return fftwf_plan_dft_c2r_1d(N, in, x.data(), flags); }, fftwf_execute, fftwf_destroy_plan);
 
 
 		switch (mode)
@@ -543,7 +599,6 @@ namespace dsp::fft
 			break;
 		}
 
-		fftwf_destroy_plan(p);
 		return x;
 	}
 	auto irfftw(const std::vector<std::complex<double>>& X, unsigned n, unsigned flags, NormalizationMode mode)
@@ -553,15 +608,12 @@ namespace dsp::fft
 		unsigned N = get_fft_length(X, n);
 
 		std::vector<double> x(N);
-		std::vector<std::complex<double>> X_copy = X;
+		AlignedVector<std::complex<double>> X_copy(X.begin(), X.end());
 		X_copy.resize(N, 0.0);
 		fftw_complex* in = reinterpret_cast<fftw_complex*>(&X_copy[0]);
 
 
-		auto* out = &x[0];
-		const auto p = fftw_plan_dft_c2r_1d(N, in, out, flags);
-
-		fftw_execute(p);
+		executePlan([&] { return fftw_plan_dft_c2r_1d(N, in, x.data(), flags); }, fftw_execute, fftw_destroy_plan);
 
 
 		switch (mode)
@@ -578,7 +630,6 @@ namespace dsp::fft
 			break;
 		}
 
-		fftw_destroy_plan(p);
 		return x;
 	}
 	auto irfftw(const std::vector<std::complex<long double>>& X, unsigned n, unsigned flags, NormalizationMode mode)
@@ -588,15 +639,12 @@ namespace dsp::fft
 		unsigned N = get_fft_length(X, n);
 
 		std::vector<long double> x(N);
-		std::vector<std::complex<long double>> X_copy = X;
+		AlignedVector<std::complex<long double>> X_copy(X.begin(), X.end());
 		X_copy.resize(N, 0.0);
 		fftwl_complex* in = reinterpret_cast<fftwl_complex*>(&X_copy[0]);
 
 
-		auto* out = &x[0];
-		const auto p = fftwl_plan_dft_c2r_1d(N, in, out, flags);
-
-		fftwl_execute(p);
+		executePlan([&] { return fftwl_plan_dft_c2r_1d(N, in, x.data(), flags); }, fftwl_execute, fftwl_destroy_plan);
 
 
 		switch (mode)
@@ -613,11 +661,35 @@ namespace dsp::fft
 			break;
 		}
 
-		fftwl_destroy_plan(p);
 		return x;
 	}
 
 #endif
+
+	// Log-squared magnitude spectrum of one frame, with all temporaries in the arena. load(x, n) writes the first n
+	// samples of the frame to x.
+	template<class T, class Load>
+	size_t logSquaredMagnitudeSpectrum_(size_t length, int N_fft, double relativeCutoff, T* out, ScratchArena& arena, Load load)
+	{
+		if (length == 0) return 0;
+
+		const unsigned N = 2 << (nextpow2(N_fft) - 1);
+		const auto finalFrequencyBinIdx = static_cast<size_t>(relativeCutoff * static_cast<double>(N));
+
+		// All temporaries live in the arena until the end of this scope
+		ScratchScope scope(arena);
+		auto* x = arena.allocate<T>(N);
+		const auto n = std::min<size_t>(length, N);
+		load(x, n);
+		std::fill(x + n, x + N, T(0));
+
+		auto* X = arena.allocate<std::complex<T>>(N);
+		rfftInPlace(x, X, N);
+
+		std::transform(X, X + finalFrequencyBinIdx, out, &logSquaredMagnitude<T>);
+
+		return finalFrequencyBinIdx;
+	}
 	/// @endcond
 } // .namespace dsp::fft
 
@@ -678,6 +750,12 @@ std::vector<std::complex<T>> dsp::fft::icfft(const std::vector<std::complex<T>>&
 
 template <class T>
 std::vector<std::complex<T>> dsp::fft::rfft(const std::vector<T>& x, unsigned n, NormalizationMode mode, backend backend)
+{
+	return rfft(SignalView<T>(x), n, mode, backend);
+}
+
+template<class T>
+std::vector<std::complex<T>> dsp::fft::rfft(SignalView<T> x, unsigned n, NormalizationMode mode, backend backend)
 {
 	switch (backend)
 	{
@@ -739,19 +817,51 @@ std::vector<T> dsp::fft::logSquaredMagnitudeSpectrum(const std::vector<T>& signa
 	auto logSquaredSpectrum = std::vector<T>(finalFrequencyBinIdx);
 
 
-	std::transform(std::execution::par_unseq, spectrum.begin(), spectrum.begin() + finalFrequencyBinIdx, logSquaredSpectrum.begin(), &logSquaredMagnitude<T>);
+	std::transform(spectrum.begin(), spectrum.begin() + finalFrequencyBinIdx, logSquaredSpectrum.begin(), &logSquaredMagnitude<T>);
 
 	return logSquaredSpectrum;
 }
 
+template <class T>
+void dsp::fft::rfft(const T* x, std::complex<T>* X, unsigned N)
+{
+	if (N < 4 || (N & (N - 1)) != 0)
+	{
+		throw std::invalid_argument("FFT length must be a power of two of at least 4!");
+	}
+	rfftInPlace(x, X, N);
+}
+
+template <class T>
+size_t dsp::fft::logSquaredMagnitudeSpectrum(const T* frame, size_t length, int N_fft, double relativeCutoff, T* out,
+	ScratchArena& arena)
+{
+	return logSquaredMagnitudeSpectrum_(length, N_fft, relativeCutoff, out, arena,
+		[frame](T* x, size_t n) { std::copy(frame, frame + n, x); });
+}
+
+template <class T, class P, std::enable_if_t<dsp::pcm::is_pcm_v<P>, int>>
+size_t dsp::fft::logSquaredMagnitudeSpectrum(const P* frame, size_t length, int N_fft, double relativeCutoff, T* out,
+	ScratchArena& arena)
+{
+	return logSquaredMagnitudeSpectrum_(length, N_fft, relativeCutoff, out, arena,
+		[frame](T* x, size_t n) { pcm::decode(frame, x, n); });
+}
+
 template <class T>
 std::vector<T> dsp::fft::fftconvolution(const std::vector<T>& volume, const std::vector<T>& kernel, convolution_mode mode)
+{
+	return fftconvolution(SignalView<T>(volume), SignalView<T>(kernel), mode);
+}
+
+template <class T>
+std::vector<T> dsp::fft::fftconvolution(SignalView<T> volume, SignalView<T> kernel, convolution_mode mode)
 {
 	size_t size = static_cast<size_t>(std::pow(2, nextpow2(static_cast<unsigned>(volume.size() + kernel.size()) - 1)));
-	std::vector<T> volume_padded(volume);
-	volume_padded.resize(size);
-	std::vector<T> kernel_padded(kernel);
-	kernel_padded.resize(size);
+	std::vector<T> volume_padded(size, T(0));
+	std::copy(volume.begin(), volume.end(), volume_padded.begin());
+	std::vector<T> kernel_padded(size, T(0));
+	std::copy(kernel.begin(), kernel.end(), kernel_padded.begin());
 
 	auto X = fft(volume_padded, static_cast<unsigned>(size));
 	auto Y = fft(kernel_padded, static_cast<unsigned>(size));
@@ -792,27 +902,32 @@ std::vector<std::vector<T>> dsp::fft::spectrogram(const std::vector<T>& signal,
 	std::vector<T> a{ 1.0 };
 	auto preemph_signal = filter::filter(b, a, signal);
 
-	// Split into frames
-	auto frames = signalToFrames(signal, frameLength, static_cast<unsigned>(overlap_pct * frameLength));
-	spectrogram.resize(frames.size());
+	// Frame positions as in signalToFrames(), but the frames are never copied
+	const int frameStride = frameLength - static_cast<unsigned>(overlap_pct * frameLength);
+	const size_t numFrames = (signal.size() + frameStride - 1) / frameStride;
 
-	// Window each frame
+	const auto nFft = 2 << (nextpow2(frameLength) - 1);
+	const auto finalFrequencyBinIdx = static_cast<size_t>(relativeCutoff * static_cast<double>(nFft));
+	spectrogram.assign(numFrames, std::vector<T>(finalFrequencyBinIdx));
+
+	// Window each frame and calculate its squared magnitude spectrum in dB. The temporaries of each frame come from the
+	// scratch arena of the executing thread, so that there is no heap traffic (and no allocator contention) per frame.
 	auto window = window::get_window<T>(windowType, frameLength);
-	std::transform(std::execution::par_unseq,
-		frames.begin(), frames.end(),
-		frames.begin(),
-		[window](auto& frame)
+	ThreadPool::global().parallelFor(numFrames,
+		[&](size_t frameIdx)
 		{
-			std::transform(frame.begin(), frame.end(), window.begin(), frame.begin(), std::multiplies<>());
-			return frame;
-		});
+			auto& row = spectrogram[frameIdx];
+			const size_t startSample = frameIdx * frameStride;
+			const size_t available = std::min<size_t>(frameLength, signal.size() - startSample);
 
-	// Calculate squared magnitude spectrum in dB
-	const auto nFft = 2 << (nextpow2(frameLength) - 1);
-	std::transform(std::execution::par_unseq,
-		frames.begin(), frames.end(),
-		spectrogram.begin(),
-		[=](auto frame) {return logSquaredMagnitudeSpectrum<T>(frame, nFft, relativeCutoff); });
+			auto& arena = threadScratch();
+			ScratchScope scope(arena);
+			auto* frame = arena.allocate<T>(frameLength);
+			std::transform(signal.begin() + startSample, signal.begin() + startSample + available, window.begin(), frame, std::multiplies<>());
+			std::fill(frame + available, frame + frameLength, T(0));
+
+			logSquaredMagnitudeSpectrum(frame, frameLength, nFft, relativeCutoff, row.data(), arena);
+		});
 
 	return spectrogram;
 
@@ -906,6 +1021,9 @@ template std::vector<std::complex<long double>> dsp::fft::icfft(const std::vecto
 template std::vector<std::complex<float>> dsp::fft::rfft(const std::vector<float>& x, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
 template std::vector<std::complex<double>> dsp::fft::rfft(const std::vector<double>& x, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
 template std::vector<std::complex<long double>> dsp::fft::rfft(const std::vector<long double>& x, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
+template std::vector<std::complex<float>> dsp::fft::rfft(SignalView<float> x, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
+template std::vector<std::complex<double>> dsp::fft::rfft(SignalView<double> x, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
+template std::vector<std::complex<long double>> dsp::fft::rfft(SignalView<long double> x, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
 
 template std::vector<float> dsp::fft::irfft(const std::vector<std::complex<float>>& X, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
 template std::vector<double> dsp::fft::irfft(const std::vector<std::complex<double>>& X, unsigned n, dsp::fft::NormalizationMode mode, backend backend);
@@ -914,6 +1032,37 @@ template std::vector<long double> dsp::fft::irfft(const std::vector<std::complex
 template std::vector<float> dsp::fft::fftconvolution(const std::vector<float>& volume, const std::vector<float>& kernel, convolution_mode mode);
 template std::vector<double> dsp::fft::fftconvolution(const std::vector<double>& volume, const std::vector<double>& kernel, convolution_mode mode);
 template std::vector<long double> dsp::fft::fftconvolution(const std::vector<long double>& volume, const std::vector<long double>& kernel, convolution_mode mode);
+template std::vector<float> dsp::fft::fftconvolution(SignalView<float> volume, SignalView<float> kernel, convolution_mode mode);
+template std::vector<double> dsp::fft::fftconvolution(SignalView<double> volume, SignalView<double> kernel, convolution_mode mode);
+template std::vector<long double> dsp::fft::fftconvolution(SignalView<long double> volume, SignalView<long double> kernel, convolution_mode mode);
+
+template void dsp::fft::rfft(const float* x, std::complex<float>* X, unsigned N);
+template void dsp::fft::rfft(const double* x, std::complex<double>* X, unsigned N);
+template void dsp::fft::rfft(const long double* x, std::complex<long double>* X, unsigned N);
+
+template std::vector<float> dsp::fft::logSquaredMagnitudeSpectrum(const std::vector<float>& signal, int N_fft, double relativeCutoff);
+template std::vector<double> dsp::fft::logSquaredMagnitudeSpectrum(const std::vector<double>& signal, int N_fft, double relativeCutoff);
+template std::vector<long double> dsp::fft::logSquaredMagnitudeSpectrum(const std::vector<long double>& signal, int N_fft, double relativeCutoff);
+
+template size_t dsp::fft::logSquaredMagnitudeSpectrum(const float* frame, size_t length, int N_fft, double relativeCutoff, float* out,
+	ScratchArena& arena);
+template size_t dsp::fft::logSquaredMagnitudeSpectrum(const double* frame, size_t length, int N_fft, double relativeCutoff, double* out,
+	ScratchArena& arena);
+template size_t dsp::fft::logSquaredMagnitudeSpectrum(const long double* frame, size_t length, int N_fft, double relativeCutoff, long double* out,
+	ScratchArena& arena);
+
+#define DSP_INSTANTIATE_PCM_SPECTRUM(T, P) \
+	template size_t dsp::fft::logSquaredMagnitudeSpectrum(const dsp::pcm::P* frame, size_t length, int N_fft, double relativeCutoff, T* out, \
+		ScratchArena& arena);
+
+DSP_INSTANTIATE_PCM_SPECTRUM(float, int16)
+DSP_INSTANTIATE_PCM_SPECTRUM(float, int24)
+DSP_INSTANTIATE_PCM_SPECTRUM(float, int32)
+DSP_INSTANTIATE_PCM_SPECTRUM(double, int16)
+DSP_INSTANTIATE_PCM_SPECTRUM(double, int24)
+DSP_INSTANTIATE_PCM_SPECTRUM(double, int32)
+
+#undef DSP_INSTANTIATE_PCM_SPECTRUM
 
 template std::vector<std::vector<float>> dsp::fft::spectrogram(const std::vector<float>& signal, unsigned frameLength,
 	double overlap_pct, int samplingRate, double relativeCutoff, window::type windowType);
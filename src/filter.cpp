@@ -1,10 +1,1218 @@
 #include "filter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
 #include "dsp.h"
 
+namespace dsp::filter
+{
+	/// @cond developer-only
+
+	/// @brief Solves the linear system Ax = b by Gaussian elimination with partial pivoting (A is n x n, row-major).
+	template<class T>
+	std::vector<T> solve(std::vector<T> A, std::vector<T> b)
+	{
+		const auto n = b.size();
+		for (size_t col = 0; col < n; ++col)
+		{
+			size_t pivot = col;
+			for (size_t row = col + 1; row < n; ++row)
+			{
+				if (std::abs(A[row * n + col]) > std::abs(A[pivot * n + col])) { pivot = row; }
+			}
+			if (A[pivot * n + col] == T(0)) { throw std::runtime_error("Singular matrix in filter design!"); }
+			if (pivot != col)
+			{
+				std::swap_ranges(A.begin() + col * n, A.begin() + (col + 1) * n, A.begin() + pivot * n);
+				std::swap(b[col], b[pivot]);
+			}
+			for (size_t row = col + 1; row < n; ++row)
+			{
+				const T factor = A[row * n + col] / A[col * n + col];
+				for (size_t k = col; k < n; ++k) { A[row * n + k] -= factor * A[col * n + k]; }
+				b[row] -= factor * b[col];
+			}
+		}
+		std::vector<T> x(n);
+		for (size_t i = n; i-- > 0;)
+		{
+			T sum = b[i];
+			for (size_t k = i + 1; k < n; ++k) { sum -= A[i * n + k] * x[k]; }
+			x[i] = sum / A[i * n + i];
+		}
+		return x;
+	}
+
+	/*
+	 * Parks-McClellan algorithm, following the well-known C implementation by Jake Janovetz.
+	 * All frequencies are normalized to the sampling frequency (0 ... 0.5).
+	 */
+	struct RemezDesign
+	{
+		int r{ 0 };  // Number of extrema minus one
+		std::vector<double> grid, D, W, E;  // Dense frequency grid, desired response, weights, and error on the grid
+		std::vector<int> ext;  // Indices of the extremal frequencies on the grid
+		std::vector<double> ad, x, y;  // Lagrange interpolation parameters
+
+		// Oppenheim & Schafer, eqs. 7.131 - 7.133b
+		void calcParms()
+		{
+			for (int i = 0; i <= r; ++i) { x[i] = std::cos(2.0 * pi * grid[ext[i]]); }
+
+			const int ld = (r - 1) / 15 + 1;  // Skip around to avoid round-off errors
+			for (int i = 0; i <= r; ++i)
+			{
+				double denom = 1.0;
+				for (int j = 0; j < ld; ++j)
+				{
+					for (int k = j; k <= r; k += ld)
+					{
+						if (k != i) { denom *= 2.0 * (x[i] - x[k]); }
+					}
+				}
+				if (std::abs(denom) < 0.00001) { denom = 0.00001; }
+				ad[i] = 1.0 / denom;
+			}
+
+			double numer = 0.0;
+			double denom = 0.0;
+			double sign = 1.0;
+			for (int i = 0; i <= r; ++i)
+			{
+				numer += ad[i] * D[ext[i]];
+				denom += sign * ad[i] / W[ext[i]];
+				sign = -sign;
+			}
+			const double delta = numer / denom;
+			sign = 1.0;
+			for (int i = 0; i <= r; ++i)
+			{
+				y[i] = D[ext[i]] - sign * delta / W[ext[i]];
+				sign = -sign;
+			}
+		}
+
+		// Amplitude response at freq by barycentric Lagrange interpolation
+		double computeA(double freq) const
+		{
+			double numer = 0.0;
+			double denom = 0.0;
+			const double xc = std::cos(2.0 * pi * freq);
+			for (int i = 0; i <= r; ++i)
+			{
+				double c = xc - x[i];
+				if (std::abs(c) < 1.0e-7)
+				{
+					numer = y[i];
+					denom = 1.0;
+					break;
+				}
+				c = ad[i] / c;
+				denom += c;
+				numer += c * y[i];
+			}
+			return numer / denom;
+		}
+
+		void calcError()
+		{
+			for (size_t i = 0; i < grid.size(); ++i)
+			{
+				E[i] = W[i] * (D[i] - computeA(grid[i]));
+			}
+		}
+
+		// Finds the r + 1 extrema of the error function with alternating sign
+		void search()
+		{
+			std::vector<int> found;
+			const int n = static_cast<int>(grid.size());
+
+			if ((E[0] > 0.0 && E[0] > E[1]) || (E[0] < 0.0 && E[0] < E[1])) { found.push_back(0); }
+			for (int i = 1; i < n - 1; ++i)
+			{
+				if ((E[i] >= E[i - 1] && E[i] > E[i + 1] && E[i] > 0.0) ||
+					(E[i] <= E[i - 1] && E[i] < E[i + 1] && E[i] < 0.0))
+				{
+					found.push_back(i);
+				}
+			}
+			const int j = n - 1;
+			if ((E[j] > 0.0 && E[j] > E[j - 1]) || (E[j] < 0.0 && E[j] < E[j - 1])) { found.push_back(j); }
+
+			// Remove the superfluous extrema
+			auto extra = static_cast<int>(found.size()) - (r + 1);
+			while (extra > 0)
+			{
+				bool up = E[found[0]] > 0.0;
+				bool alternating = true;
+				size_t l = 0;
+				for (size_t k = 1; k < found.size(); ++k)
+				{
+					if (std::abs(E[found[k]]) < std::abs(E[found[l]])) { l = k; }
+					if (up && E[found[k]] < 0.0) { up = false; }
+					else if (!up && E[found[k]] > 0.0) { up = true; }
+					else
+					{
+						// Two non-alternating extrema: Delete the smallest one found so far
+						alternating = false;
+						break;
+					}
+				}
+				if (alternating && extra == 1)
+				{
+					l = std::abs(E[found.back()]) < std::abs(E[found.front()]) ? found.size() - 1 : 0;
+				}
+				found.erase(found.begin() + l);
+				--extra;
+			}
+			if (static_cast<int>(found.size()) < r + 1) { return; }  // Keep the previous set of extrema
+			std::copy(found.begin(), found.begin() + r + 1, ext.begin());
+		}
+
+		bool isDone() const
+		{
+			double min = std::abs(E[ext[0]]);
+			double max = min;
+			for (int i = 1; i <= r; ++i)
+			{
+				const double current = std::abs(E[ext[i]]);
+				min = std::min(min, current);
+				max = std::max(max, current);
+			}
+			return (max - min) / max < 0.0001;
+		}
+	};
+
+	/// @endcond
+}
+
+template <class T>
+std::vector<T> dsp::filter::firwin(unsigned numtaps, const std::vector<T>& cutoff, bool pass_zero,
+	window::type windowType, bool scale, T fs, const std::vector<T>& windowParameters)
+{
+	if (numtaps == 0) { throw std::invalid_argument("numtaps must be positive!"); }
+	if (cutoff.empty()) { throw std::invalid_argument("At least one cutoff frequency must be given!"); }
+
+	// Normalize the cutoff frequencies to the Nyquist frequency
+	const T nyquist = fs / 2;
+	std::vector<T> edges;
+	edges.reserve(cutoff.size() + 2);
+	for (const auto& c : cutoff)
+	{
+		if (c <= 0 || c >= nyquist) { throw std::invalid_argument("Cutoff frequencies must be between 0 and fs/2!"); }
+		if (!edges.empty() && c / nyquist <= edges.back()) { throw std::invalid_argument("Cutoff frequencies must be strictly increasing!"); }
+		edges.push_back(c / nyquist);
+	}
+
+	const bool pass_nyquist = (cutoff.size() % 2 == 1) != pass_zero;
+	if (pass_nyquist && numtaps % 2 == 0)
+	{
+		throw std::invalid_argument("A filter with an even number of taps cannot have a passband at the Nyquist frequency!");
+	}
+	if (pass_zero) { edges.insert(edges.begin(), T(0)); }
+	if (pass_nyquist) { edges.push_back(T(1)); }
+
+	// Sum of the ideal impulse responses of all passbands
+	const T alpha = static_cast<T>(0.5 * (numtaps - 1.0));
+	std::vector<T> h(numtaps, T(0));
+	for (size_t band = 0; band + 1 < edges.size(); band += 2)
+	{
+		const T left = edges[band];
+		const T right = edges[band + 1];
+		for (unsigned n = 0; n < numtaps; ++n)
+		{
+			const T m = static_cast<T>(n) - alpha;
+			h[n] += right * dsp::sinc(right * m) - left * dsp::sinc(left * m);
+		}
+	}
+
+	const auto win = window::get_window<T>(windowType, numtaps, true, windowParameters);
+	std::transform(h.begin(), h.end(), win.begin(), h.begin(), std::multiplies<>());
+
+	if (scale)
+	{
+		// Unity gain at DC, at the Nyquist frequency, or at the center of the first passband
+		const T left = edges[0];
+		const T right = edges[1];
+		T scaleFrequency = static_cast<T>(0.5) * (left + right);
+		if (left == T(0)) { scaleFrequency = 0; }
+		else if (right == T(1)) { scaleFrequency = 1; }
+
+		T sum = 0;
+		for (unsigned n = 0; n < numtaps; ++n)
+		{
+			sum += h[n] * static_cast<T>(std::cos(pi * (static_cast<T>(n) - alpha) * scaleFrequency));
+		}
+		std::transform(h.begin(), h.end(), h.begin(), [sum](auto x) {return x / sum; });
+	}
+
+	return h;
+}
+
+template <class T>
+std::vector<T> dsp::filter::firls(unsigned numtaps, const std::vector<T>& bands, const std::vector<T>& desired,
+	const std::vector<T>& weight, T fs)
+{
+	if (numtaps % 2 == 0) { throw std::invalid_argument("numtaps must be odd!"); }
+	if (bands.empty() || bands.size() % 2 != 0) { throw std::invalid_argument("bands must contain pairs of band edges!"); }
+	if (desired.size() != bands.size()) { throw std::invalid_argument("desired must have the same length as bands!"); }
+
+	const auto numBands = bands.size() / 2;
+	std::vector<T> w(weight);
+	if (w.empty()) { w.assign(numBands, T(1)); }
+	if (w.size() != numBands) { throw std::invalid_argument("weight must have half the length of bands!"); }
+
+	std::vector<long double> f(bands.size());
+	const long double nyquist = fs / 2.0L;
+	for (size_t i = 0; i < bands.size(); ++i)
+	{
+		f[i] = bands[i] / nyquist;
+		if (f[i] < 0 || f[i] > 1) { throw std::invalid_argument("Band edges must be between 0 and fs/2!"); }
+		if (i > 0 && f[i] < f[i - 1]) { throw std::invalid_argument("Band edges must be monotonically non-decreasing!"); }
+	}
+
+	// Solve Qa = b, where Q(k, n) = q(k - n) + q(k + n) is a sum of a Toeplitz and a Hankel matrix.
+	// With constant weight W per band, q(n) = W * f * sinc(n * f) integrated over each band [f1, f2].
+	const unsigned M = (numtaps - 1) / 2;
+	std::vector<long double> q(numtaps, 0.0L);
+	for (unsigned n = 0; n < numtaps; ++n)
+	{
+		for (size_t band = 0; band < numBands; ++band)
+		{
+			const auto f1 = f[2 * band];
+			const auto f2 = f[2 * band + 1];
+			q[n] += w[band] * (f2 * dsp::sinc(f2 * n) - f1 * dsp::sinc(f1 * n));
+		}
+	}
+
+	std::vector<long double> Q((M + 1) * (M + 1));
+	for (unsigned k = 0; k <= M; ++k)
+	{
+		for (unsigned n = 0; n <= M; ++n)
+		{
+			Q[k * (M + 1) + n] = q[k > n ? k - n : n - k] + q[k + n];
+		}
+	}
+
+	// The desired response is linear (m * f + c) in each band, so b(n) = W * integral of (m * f + c) * cos(pi * n * f) over [f1, f2]
+	std::vector<long double> b(M + 1, 0.0L);
+	for (size_t band = 0; band < numBands; ++band)
+	{
+		const auto f1 = f[2 * band];
+		const auto f2 = f[2 * band + 1];
+		const long double m = f2 > f1 ? (desired[2 * band + 1] - desired[2 * band]) / (f2 - f1) : 0.0L;
+		const long double c = desired[2 * band] - f1 * m;
+		auto antiderivative = [m, c](long double fr, unsigned n)
+		{
+			auto value = fr * (m * fr + c) * dsp::sinc(fr * n);
+			if (n == 0)
+			{
+				return value - m * fr * fr / 2;
+			}
+			const auto pn = static_cast<long double>(pi) * n;
+			return value + m * std::cos(pn * fr) / (pn * pn);
+		};
+		for (unsigned n = 0; n <= M; ++n)
+		{
+			b[n] += w[band] * (antiderivative(f2, n) - antiderivative(f1, n));
+		}
+	}
+
+	// The factor 1/2 of Q was omitted above, so the amplitude response is 2 * sum(a[n] * cos(pi * n * f))
+	auto a = solve(Q, b);
+
+	// Linear-phase (symmetric) impulse response
+	std::vector<T> h(numtaps);
+	h[M] = static_cast<T>(2 * a[0]);
+	for (unsigned n = 1; n <= M; ++n)
+	{
+		h[M - n] = static_cast<T>(a[n]);
+		h[M + n] = static_cast<T>(a[n]);
+	}
+	return h;
+}
+
+template <class T>
+std::vector<T> dsp::filter::remez(unsigned numtaps, const std::vector<T>& bands, const std::vector<T>& desired,
+	const std::vector<T>& weight, T fs, remez_type type, unsigned maxiter, unsigned grid_density)
+{
+	if (numtaps < 3) { throw std::invalid_argument("numtaps must be at least 3!"); }
+	if (bands.empty() || bands.size() % 2 != 0) { throw std::invalid_argument("bands must contain pairs of band edges!"); }
+
+	const auto numBands = bands.size() / 2;
+	if (desired.size() != numBands) { throw std::invalid_argument("desired must have half the length of bands!"); }
+	std::vector<T> w(weight);
+	if (w.empty()) { w.assign(numBands, T(1)); }
+	if (w.size() != numBands) { throw std::invalid_argument("weight must have half the length of bands!"); }
+
+	std::vector<double> edges(bands.size());
+	for (size_t i = 0; i < bands.size(); ++i)
+	{
+		edges[i] = static_cast<double>(bands[i] / fs);
+		if (edges[i] < 0 || edges[i] > 0.5) { throw std::invalid_argument("Band edges must be between 0 and fs/2!"); }
+		if (i > 0 && edges[i] < edges[i - 1]) { throw std::invalid_argument("Band edges must be monotonically increasing!"); }
+	}
+
+	const bool positive = (type == remez_type::bandpass);
+	const bool odd = numtaps % 2 == 1;
+
+	RemezDesign d;
+	d.r = static_cast<int>(numtaps / 2);
+	if (odd && positive) { ++d.r; }
+
+	// Create the dense frequency grid
+	const double delf = 0.5 / (grid_density * d.r);
+	if (!positive && delf > edges[0]) { edges[0] = delf; }
+	for (size_t band = 0; band < numBands; ++band)
+	{
+		double lowf = edges[2 * band];
+		const double highf = edges[2 * band + 1];
+		const auto k = static_cast<int>((highf - lowf) / delf + 0.5);
+		for (int i = 0; i < k; ++i)
+		{
+			d.grid.push_back(lowf);
+			d.D.push_back(static_cast<double>(desired[band]));
+			d.W.push_back(static_cast<double>(w[band]));
+			lowf += delf;
+		}
+		if (k > 0) { d.grid.back() = highf; }
+	}
+	if (!positive && odd && d.grid.back() > 0.5 - delf) { d.grid.back() = 0.5 - delf; }
+	if (static_cast<int>(d.grid.size()) < d.r + 1) { throw std::invalid_argument("Bands are too narrow for the number of taps!"); }
+
+	const auto gridsize = d.grid.size();
+	d.E.resize(gridsize);
+	d.ext.resize(d.r + 1);
+	d.ad.resize(d.r + 1);
+	d.x.resize(d.r + 1);
+	d.y.resize(d.r + 1);
+	for (int i = 0; i <= d.r; ++i)
+	{
+		d.ext[i] = static_cast<int>(i * (gridsize - 1) / d.r);
+	}
+
+	if (type == remez_type::differentiator)
+	{
+		for (size_t i = 0; i < gridsize; ++i)
+		{
+			// The desired amplitude rises linearly with frequency, and the error is weighted relative to it
+			d.D[i] *= 2.0 * pi * d.grid[i];
+			if (d.D[i] > 0.0001) { d.W[i] /= d.grid[i]; }
+		}
+	}
+
+	// Take the fixed factor of the amplitude response of types II to IV into account
+	auto factor = [positive, odd](double f)
+	{
+		if (positive) { return odd ? 1.0 : std::cos(pi * f); }
+		return odd ? std::sin(2.0 * pi * f) : std::sin(pi * f);
+	};
+	if (!(positive && odd))
+	{
+		for (size_t i = 0; i < gridsize; ++i)
+		{
+			const auto c = factor(d.grid[i]);
+			d.D[i] /= c;
+			d.W[i] *= c;
+		}
+	}
+
+	// Remez exchange
+	for (unsigned iter = 0; iter < maxiter; ++iter)
+	{
+		d.calcParms();
+		d.calcError();
+		d.search();
+		if (d.isDone()) { break; }
+	}
+	d.calcParms();
+
+	// Sample the amplitude response and obtain the impulse response by frequency sampling
+	std::vector<double> A(numtaps / 2 + 1);
+	for (unsigned i = 0; i <= numtaps / 2; ++i)
+	{
+		const double f = static_cast<double>(i) / numtaps;
+		A[i] = d.computeA(f) * factor(f);
+	}
+
+	std::vector<T> h(numtaps);
+	const double M = (numtaps - 1.0) / 2.0;
+	const unsigned K = odd ? (numtaps - 1) / 2 : numtaps / 2 - 1;
+	for (unsigned n = 0; n < numtaps; ++n)
+	{
+		const double x = 2.0 * pi * (n - M) / numtaps;
+		double value = 0.0;
+		if (positive)
+		{
+			value = A[0];
+			for (unsigned k = 1; k <= K; ++k) { value += 2.0 * A[k] * std::cos(x * k); }
+		}
+		else
+		{
+			if (!odd) { value = A[numtaps / 2] * std::sin(pi * (n - M)); }
+			for (unsigned k = 1; k <= K; ++k) { value += 2.0 * A[k] * std::sin(x * k); }
+		}
+		h[n] = static_cast<T>(value / numtaps);
+	}
+	return h;
+}
+
+namespace dsp::filter
+{
+	/// @cond developer-only
+	template<class T>
+	struct FirDesignCache
+	{
+		std::mutex mutex;
+		std::map<FirSpec<T>, std::vector<T>> coefficients;
+
+		static FirDesignCache& instance()
+		{
+			static FirDesignCache cache;
+			return cache;
+		}
+	};
+	/// @endcond
+}
+
+template <class T>
+const std::vector<T>& dsp::filter::firdesign(const FirSpec<T>& spec)
+{
+	auto& cache = FirDesignCache<T>::instance();
+	{
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		auto it = cache.coefficients.find(spec);
+		if (it != cache.coefficients.end()) { return it->second; }
+	}
+
+	// Design outside of the lock so that lookups of other specifications are not blocked
+	std::vector<T> h;
+	switch (spec.method)
+	{
+	case fir_method::firwin:
+		h = firwin<T>(spec.numtaps, spec.bands, spec.pass_zero, spec.windowType, true, spec.fs, spec.windowParameters);
+		break;
+	case fir_method::firls:
+		h = firls<T>(spec.numtaps, spec.bands, spec.desired, spec.weight, spec.fs);
+		break;
+	case fir_method::remez:
+		h = remez<T>(spec.numtaps, spec.bands, spec.desired, spec.weight, spec.fs, spec.remezType);
+		break;
+	default:
+		throw std::runtime_error("Unknown FIR design method!");
+	}
+
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	return cache.coefficients.emplace(spec, std::move(h)).first->second;
+}
+
+template <class T>
+void dsp::filter::clearFirDesignCache()
+{
+	auto& cache = FirDesignCache<T>::instance();
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	cache.coefficients.clear();
+}
+
+namespace dsp::filter
+{
+	/// @cond developer-only
+	namespace elliptic
+	{
+		// Complete elliptic integral of the first kind K(m) via the arithmetic-geometric mean
+		long double ellipk(long double m)
+		{
+			if (m >= 1) { return std::numeric_limits<long double>::infinity(); }
+			long double a = 1, b = std::sqrt(1 - m);
+			while (std::abs(a - b) > std::numeric_limits<long double>::epsilon() * a)
+			{
+				const long double an = (a + b) / 2;
+				b = std::sqrt(a * b);
+				a = an;
+			}
+			return pi / (2 * a);
+		}
+
+		// K(1 - p), accurate for small p
+		long double ellipkm1(long double p)
+		{
+			if (p <= 0) { return std::numeric_limits<long double>::infinity(); }
+			long double a = 1, b = std::sqrt(p);
+			while (std::abs(a - b) > std::numeric_limits<long double>::epsilon() * a)
+			{
+				const long double an = (a + b) / 2;
+				b = std::sqrt(a * b);
+				a = an;
+			}
+			return pi / (2 * a);
+		}
+
+		// Jacobi elliptic functions sn, cn, dn of real argument u and parameter m (descending Landen/AGM, A&S 16.4)
+		void ellipj(long double u, long double m, long double& sn, long double& cn, long double& dn)
+		{
+			if (m < 1e-12L)
+			{
+				sn = std::sin(u); cn = std::cos(u); dn = 1;
+				return;
+			}
+			if (m > 1 - 1e-12L)
+			{
+				sn = std::tanh(u); cn = 1 / std::cosh(u); dn = cn;
+				return;
+			}
+			std::vector<long double> a{ 1 }, c{ std::sqrt(m) };
+			long double b = std::sqrt(1 - m);
+			while (std::abs(c.back()) > std::numeric_limits<long double>::epsilon() && a.size() < 64)
+			{
+				const long double an = (a.back() + b) / 2;
+				c.push_back((a.back() - b) / 2);
+				b = std::sqrt(a.back() * b);
+				a.push_back(an);
+			}
+			const size_t N = a.size() - 1;
+			long double phi = std::ldexp(a[N] * u, static_cast<int>(N));
+			long double phiPrev = phi;
+			for (size_t n = N; n > 0; --n)
+			{
+				phiPrev = phi;
+				phi = (phi + std::asin(c[n] / a[n] * std::sin(phi))) / 2;
+			}
+			sn = std::sin(phi);
+			cn = std::cos(phi);
+			dn = cn / std::cos(phiPrev - phi);
+		}
+
+		// Solves the degree equation for the modulus of the elliptic filter using nomes
+		long double ellipdeg(unsigned n, long double m1)
+		{
+			const long double q1 = std::exp(-pi * ellipkm1(m1) / ellipk(m1));
+			const long double q = std::pow(q1, 1.0L / n);
+			long double num = 0, den = 0;
+			for (int i = 0; i <= 7; ++i)
+			{
+				num += std::pow(q, i * (i + 1));
+				den += std::pow(q, (i + 1) * (i + 1));
+			}
+			den = 1 + 2 * den;
+			return 16 * q * std::pow(num / den, 4);
+		}
+
+		// Inverse Jacobian elliptic sn of complex argument (Landen transformation)
+		std::complex<long double> arc_jac_sn(std::complex<long double> w, long double m)
+		{
+			auto complement = [](auto kx) { return std::sqrt((1.0L - kx) * (1.0L + kx)); };
+
+			const long double k = std::sqrt(m);
+			if (k >= 1) { return std::atanh(w); }
+
+			std::vector<long double> ks{ k };
+			while (ks.back() != 0)
+			{
+				const long double kp = complement(ks.back());
+				ks.push_back((1 - kp) / (1 + kp));
+				if (ks.size() > 10)
+				{
+					throw std::runtime_error("Landen transformation does not converge!");
+				}
+			}
+			long double K = pi / 2;
+			for (size_t i = 1; i < ks.size(); ++i) { K *= 1 + ks[i]; }
+
+			for (size_t i = 0; i + 1 < ks.size(); ++i)
+			{
+				w = 2.0L * w / ((1.0L + ks[i + 1]) * (1.0L + complement(ks[i] * w)));
+			}
+			return K * 2.0L / static_cast<long double>(pi) * std::asin(w);
+		}
+
+		// Real inverse Jacobian sc with complementary modulus: solves w = sc(z, 1 - m)
+		long double arc_jac_sc1(long double w, long double m)
+		{
+			return arc_jac_sn(std::complex<long double>(0, w), m).imag();
+		}
+	}
+
+	// Product of the negated values, i.e., the constant coefficient of the monic polynomial with these roots (up to the sign)
+	template<class T>
+	std::complex<T> negatedProduct(const std::vector<std::complex<T>>& values)
+	{
+		std::complex<T> result(1);
+		for (const auto& v : values) { result *= -v; }
+		return result;
+	}
+
+	template<class T>
+	bool isReal(const std::complex<T>& c)
+	{
+		return std::abs(c.imag()) <= 100 * std::numeric_limits<T>::epsilon() * std::abs(c);
+	}
+
+	// Returns the index of the element of from closest to target, optionally restricted to real or complex elements
+	enum class pick { any, real, complex };
+	template<class T>
+	size_t nearestIndex(const std::vector<std::complex<T>>& from, const std::complex<T>& target, pick which)
+	{
+		size_t best = from.size();
+		for (size_t i = 0; i < from.size(); ++i)
+		{
+			if (which == pick::real && !isReal(from[i])) { continue; }
+			if (which == pick::complex && isReal(from[i])) { continue; }
+			if (best == from.size() || std::abs(from[i] - target) < std::abs(from[best] - target)) { best = i; }
+		}
+		if (best == from.size())
+		{
+			throw std::logic_error("Zeros and poles cannot be paired into second-order sections!");
+		}
+		return best;
+	}
+
+	// Section with the given (up to two) zeros and poles in positive powers of z, mapped to {b0, b1, b2, a0, a1, a2}
+	template<class T>
+	std::array<T, 6> singleSection(const std::vector<std::complex<T>>& z, const std::vector<std::complex<T>>& p)
+	{
+		auto poly = [](const std::vector<std::complex<T>>& roots)
+		{
+			std::array<T, 3> c{ 0, 0, 0 };
+			if (roots.size() == 0) { c[2] = 1; }
+			else if (roots.size() == 1) { c[1] = 1; c[2] = -roots[0].real(); }
+			else
+			{
+				c[0] = 1;
+				c[1] = -(roots[0] + roots[1]).real();
+				c[2] = (roots[0] * roots[1]).real();
+			}
+			return c;
+		};
+		const auto b = poly(z);
+		const auto a = poly(p);
+		return { b[0], b[1], b[2], a[0], a[1], a[2] };
+	}
+
+	// Keeps the real values and one of each complex-conjugate pair (positive imaginary part), complex values first
+	template<class T>
+	std::vector<std::complex<T>> upperHalf(const std::vector<std::complex<T>>& values)
+	{
+		std::vector<std::complex<T>> complexValues, realValues;
+		for (const auto& v : values)
+		{
+			if (isReal(v)) { realValues.emplace_back(v.real(), 0); }
+			else if (v.imag() > 0) { complexValues.push_back(v); }
+		}
+		complexValues.insert(complexValues.end(), realValues.begin(), realValues.end());
+		return complexValues;
+	}
+
+	template<class T>
+	size_t countReal(const std::vector<std::complex<T>>& values)
+	{
+		return std::count_if(values.begin(), values.end(), [](const auto& v) { return isReal(v); });
+	}
+	/// @endcond
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::buttap(unsigned N)
+{
+	ZeroPoleGain<T> zpk;
+	for (int m = -static_cast<int>(N) + 1; m < static_cast<int>(N); m += 2)
+	{
+		zpk.poles.push_back(-std::polar(T(1), static_cast<T>(pi) * m / (2 * N)));
+	}
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::cheb1ap(unsigned N, T rp)
+{
+	ZeroPoleGain<T> zpk;
+	if (N == 0)
+	{
+		zpk.gain = std::pow(T(10), -rp / 20);
+		return zpk;
+	}
+	const T eps = std::sqrt(std::pow(T(10), rp / 10) - 1);
+	const T mu = std::asinh(1 / eps) / N;
+	for (int m = -static_cast<int>(N) + 1; m < static_cast<int>(N); m += 2)
+	{
+		const T theta = static_cast<T>(pi) * m / (2 * N);
+		zpk.poles.push_back(-std::sinh(std::complex<T>(mu, theta)));
+	}
+	zpk.gain = negatedProduct(zpk.poles).real();
+	if (N % 2 == 0)
+	{
+		zpk.gain /= std::sqrt(1 + eps * eps);
+	}
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::cheb2ap(unsigned N, T rs)
+{
+	ZeroPoleGain<T> zpk;
+	if (N == 0)
+	{
+		return zpk;
+	}
+	const T de = 1 / std::sqrt(std::pow(T(10), rs / 10) - 1);
+	const T mu = std::asinh(1 / de) / N;
+
+	for (int m = -static_cast<int>(N) + 1; m < static_cast<int>(N); m += 2)
+	{
+		// The odd-order zero at infinity is omitted
+		if (m != 0)
+		{
+			zpk.zeros.push_back(-std::conj(std::complex<T>(0, 1) / std::sin(m * static_cast<T>(pi) / (2 * N))));
+		}
+		const auto p = -std::polar(T(1), static_cast<T>(pi) * m / (2 * N));
+		zpk.poles.push_back(T(1) / std::complex<T>(std::sinh(mu) * p.real(), std::cosh(mu) * p.imag()));
+	}
+	zpk.gain = (negatedProduct(zpk.poles) / negatedProduct(zpk.zeros)).real();
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::ellipap(unsigned N, T rp, T rs)
+{
+	ZeroPoleGain<T> zpk;
+	if (N == 0)
+	{
+		zpk.gain = std::pow(T(10), -rp / 20);
+		return zpk;
+	}
+	const long double eps_sq = std::pow(10.0L, rp / 10.0L) - 1;
+	if (N == 1)
+	{
+		const auto p = -std::sqrt(1 / eps_sq);
+		zpk.poles.emplace_back(static_cast<T>(p), T(0));
+		zpk.gain = static_cast<T>(-p);
+		return zpk;
+	}
+
+	const long double eps = std::sqrt(eps_sq);
+	const long double ck1_sq = eps_sq / (std::pow(10.0L, rs / 10.0L) - 1);
+	if (ck1_sq == 0)
+	{
+		throw std::invalid_argument("Cannot design a filter with the given ripple specifications!");
+	}
+	const long double m = elliptic::ellipdeg(N, ck1_sq);
+	const long double capk = elliptic::ellipk(m);
+	const long double r = elliptic::arc_jac_sc1(1 / eps, ck1_sq);
+	const long double v0 = capk * r / (N * elliptic::ellipk(ck1_sq));
+	long double sv, cv, dv;
+	elliptic::ellipj(v0, 1 - m, sv, cv, dv);
+
+	for (unsigned j = 1 - N % 2; j < N; j += 2)
+	{
+		long double s, c, d;
+		elliptic::ellipj(j * capk / N, m, s, c, d);
+		if (std::abs(s) > std::numeric_limits<long double>::epsilon())
+		{
+			const auto z = std::complex<long double>(0, 1 / (std::sqrt(m) * s));
+			zpk.zeros.emplace_back(static_cast<T>(z.real()), static_cast<T>(z.imag()));
+			zpk.zeros.emplace_back(static_cast<T>(z.real()), static_cast<T>(-z.imag()));
+		}
+		const auto p = -std::complex<long double>(c * d * sv * cv, s * dv) / (1 - (d * sv) * (d * sv));
+		zpk.poles.emplace_back(static_cast<T>(p.real()), static_cast<T>(p.imag()));
+		if (std::abs(p.imag()) > std::numeric_limits<long double>::epsilon() * std::abs(p))
+		{
+			zpk.poles.emplace_back(static_cast<T>(p.real()), static_cast<T>(-p.imag()));
+		}
+	}
+
+	zpk.gain = (negatedProduct(zpk.poles) / negatedProduct(zpk.zeros)).real();
+	if (N % 2 == 0)
+	{
+		zpk.gain /= static_cast<T>(std::sqrt(1 + eps_sq));
+	}
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::lp2lp_zpk(const ZeroPoleGain<T>& prototype, T wo)
+{
+	ZeroPoleGain<T> zpk = prototype;
+	for (auto& z : zpk.zeros) { z *= wo; }
+	for (auto& p : zpk.poles) { p *= wo; }
+	const auto degree = static_cast<int>(zpk.poles.size()) - static_cast<int>(zpk.zeros.size());
+	zpk.gain *= std::pow(wo, static_cast<T>(degree));
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::lp2hp_zpk(const ZeroPoleGain<T>& prototype, T wo)
+{
+	ZeroPoleGain<T> zpk;
+	for (const auto& z : prototype.zeros) { zpk.zeros.push_back(wo / z); }
+	for (const auto& p : prototype.poles) { zpk.poles.push_back(wo / p); }
+	// Zeros at infinity move to the origin
+	zpk.zeros.resize(zpk.poles.size() > zpk.zeros.size() ? zpk.poles.size() : zpk.zeros.size(), std::complex<T>(0));
+	zpk.gain = prototype.gain * (negatedProduct(prototype.zeros) / negatedProduct(prototype.poles)).real();
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::lp2bp_zpk(const ZeroPoleGain<T>& prototype, T wo, T bw)
+{
+	ZeroPoleGain<T> zpk;
+	auto transform = [wo, bw](const std::vector<std::complex<T>>& roots, std::vector<std::complex<T>>& out)
+	{
+		for (const auto& root : roots)
+		{
+			const auto r = root * bw / T(2);
+			out.push_back(r + std::sqrt(r * r - wo * wo));
+		}
+		for (const auto& root : roots)
+		{
+			const auto r = root * bw / T(2);
+			out.push_back(r - std::sqrt(r * r - wo * wo));
+		}
+	};
+	transform(prototype.zeros, zpk.zeros);
+	transform(prototype.poles, zpk.poles);
+	const auto degree = prototype.poles.size() - prototype.zeros.size();
+	// Zeros at infinity are split between the origin and infinity
+	zpk.zeros.resize(zpk.zeros.size() + degree, std::complex<T>(0));
+	zpk.gain = prototype.gain * std::pow(bw, static_cast<T>(degree));
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::lp2bs_zpk(const ZeroPoleGain<T>& prototype, T wo, T bw)
+{
+	ZeroPoleGain<T> zpk;
+	auto transform = [wo, bw](const std::vector<std::complex<T>>& roots, std::vector<std::complex<T>>& out)
+	{
+		for (const auto& root : roots)
+		{
+			const auto r = bw / T(2) / root;
+			out.push_back(r + std::sqrt(r * r - wo * wo));
+		}
+		for (const auto& root : roots)
+		{
+			const auto r = bw / T(2) / root;
+			out.push_back(r - std::sqrt(r * r - wo * wo));
+		}
+	};
+	transform(prototype.zeros, zpk.zeros);
+	transform(prototype.poles, zpk.poles);
+	// Zeros at infinity move to the center frequency
+	const auto degree = prototype.poles.size() - prototype.zeros.size();
+	zpk.zeros.insert(zpk.zeros.end(), degree, std::complex<T>(0, wo));
+	zpk.zeros.insert(zpk.zeros.end(), degree, std::complex<T>(0, -wo));
+	zpk.gain = prototype.gain * (negatedProduct(prototype.zeros) / negatedProduct(prototype.poles)).real();
+	return zpk;
+}
+
+template <class T>
+dsp::filter::ZeroPoleGain<T> dsp::filter::bilinear_zpk(const ZeroPoleGain<T>& analog, T fs)
+{
+	const T fs2 = 2 * fs;
+	ZeroPoleGain<T> zpk;
+	std::complex<T> num(1), den(1);
+	for (const auto& z : analog.zeros)
+	{
+		zpk.zeros.push_back((fs2 + z) / (fs2 - z));
+		num *= fs2 - z;
+	}
+	for (const auto& p : analog.poles)
+	{
+		zpk.poles.push_back((fs2 + p) / (fs2 - p));
+		den *= fs2 - p;
+	}
+	// Zeros at infinity move to the Nyquist frequency
+	zpk.zeros.resize(zpk.poles.size() > zpk.zeros.size() ? zpk.poles.size() : zpk.zeros.size(), std::complex<T>(-1));
+	zpk.gain = analog.gain * (num / den).real();
+	return zpk;
+}
+
+template <class T>
+dsp::filter::SecondOrderSections<T> dsp::filter::zpk2sos(const ZeroPoleGain<T>& zpk)
+{
+	if (zpk.zeros.empty() && zpk.poles.empty())
+	{
+		return { { zpk.gain, 0, 0, 1, 0, 0 } };
+	}
+
+	auto z = zpk.zeros;
+	auto p = zpk.poles;
+	const auto order = z.size() > p.size() ? z.size() : p.size();
+	z.resize(order, std::complex<T>(0));
+	p.resize(order, std::complex<T>(0));
+	if (order % 2 == 1)
+	{
+		z.emplace_back(0);
+		p.emplace_back(0);
+	}
+	const auto nSections = p.size() / 2;
+	z = upperHalf(z);
+	p = upperHalf(p);
+
+	SecondOrderSections<T> sos(nSections);
+	// Build the cascade from the back so that the poles closest to the unit circle end up in the last sections
+	for (auto si = nSections; si-- > 0;)
+	{
+		auto worst = std::min_element(p.begin(), p.end(), [](const auto& a, const auto& b)
+			{
+				return std::abs(1 - std::abs(a)) < std::abs(1 - std::abs(b));
+			});
+		const auto p1 = *worst;
+		p.erase(worst);
+
+		auto takeZero = [&z, &p1](pick which)
+		{
+			const auto idx = nearestIndex(z, p1, which);
+			const auto zero = z[idx];
+			z.erase(z.begin() + idx);
+			return zero;
+		};
+
+		if (isReal(p1) && countReal(p) == 0)
+		{
+			// The last remaining real pole is paired with the nearest real zero
+			const auto z1 = takeZero(pick::real);
+			sos[si] = singleSection<T>({ z1 }, { p1 });
+		}
+		else if (p.size() + 1 == z.size() && !isReal(p1) && countReal(p) == 1 && countReal(z) == 1)
+		{
+			// One real pole and one real zero remain, so this complex pole must take a complex zero
+			const auto z1 = takeZero(pick::complex);
+			sos[si] = singleSection<T>({ z1, std::conj(z1) }, { p1, std::conj(p1) });
+		}
+		else
+		{
+			auto p2 = std::conj(p1);
+			if (isReal(p1))
+			{
+				auto second = p.end();
+				for (auto it = p.begin(); it != p.end(); ++it)
+				{
+					if (isReal(*it) && (second == p.end() || std::abs(std::abs(*it) - 1) < std::abs(std::abs(*second) - 1)))
+					{
+						second = it;
+					}
+				}
+				p2 = *second;
+				p.erase(second);
+			}
+
+			if (z.empty())
+			{
+				sos[si] = singleSection<T>({}, { p1, p2 });
+			}
+			else
+			{
+				const auto z1 = takeZero(pick::any);
+				if (!isReal(z1))
+				{
+					sos[si] = singleSection<T>({ z1, std::conj(z1) }, { p1, p2 });
+				}
+				else if (!z.empty())
+				{
+					const auto z2 = takeZero(pick::real);
+					sos[si] = singleSection<T>({ z1, z2 }, { p1, p2 });
+				}
+				else
+				{
+					sos[si] = singleSection<T>({ z1 }, { p1, p2 });
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		sos[0][i] *= zpk.gain;
+	}
+	return sos;
+}
+
+template <class T>
+dsp::filter::SecondOrderSections<T> dsp::filter::iirfilter(unsigned N, const std::vector<T>& Wn, filter_type btype,
+	iir_type ftype, T rp, T rs, T fs)
+{
+	using D = long double;
+
+	const bool isBand = btype == filter_type::bandpass || btype == filter_type::bandstop;
+	if (Wn.size() != (isBand ? 2u : 1u))
+	{
+		throw std::invalid_argument(isBand ? "Bandpass and bandstop filters need two critical frequencies!" :
+			"Lowpass and highpass filters need exactly one critical frequency!");
+	}
+	if (N == 0)
+	{
+		throw std::invalid_argument("Filter order must be at least 1!");
+	}
+
+	// Pre-warp the normalized critical frequencies for the bilinear transform with fs = 2
+	std::vector<D> warped;
+	for (const auto& w : Wn)
+	{
+		const D normalized = 2 * static_cast<D>(w) / fs;
+		if (normalized <= 0 || normalized >= 1)
+		{
+			throw std::invalid_argument("Critical frequencies must be between 0 and the Nyquist frequency!");
+		}
+		warped.push_back(4 * std::tan(static_cast<D>(pi) * normalized / 2));
+	}
+	if (isBand && warped[0] >= warped[1])
+	{
+		throw std::invalid_argument("Band edges must be in ascending order!");
+	}
+
+	ZeroPoleGain<D> zpk;
+	switch (ftype)
+	{
+	case iir_type::butter:
+		zpk = buttap<D>(N);
+		break;
+	case iir_type::cheby1:
+		if (rp <= 0) { throw std::invalid_argument("Passband ripple must be positive!"); }
+		zpk = cheb1ap<D>(N, rp);
+		break;
+	case iir_type::cheby2:
+		if (rs <= 0) { throw std::invalid_argument("Stopband attenuation must be positive!"); }
+		zpk = cheb2ap<D>(N, rs);
+		break;
+	case iir_type::ellip:
+		if (rp <= 0 || rs <= 0) { throw std::invalid_argument("Passband ripple and stopband attenuation must be positive!"); }
+		zpk = ellipap<D>(N, rp, rs);
+		break;
+	default:
+		throw std::runtime_error("Unknown IIR filter type!");
+	}
+
+	switch (btype)
+	{
+	case filter_type::lowpass:
+		zpk = lp2lp_zpk<D>(zpk, warped[0]);
+		break;
+	case filter_type::highpass:
+		zpk = lp2hp_zpk<D>(zpk, warped[0]);
+		break;
+	case filter_type::bandpass:
+		zpk = lp2bp_zpk<D>(zpk, std::sqrt(warped[0] * warped[1]), warped[1] - warped[0]);
+		break;
+	case filter_type::bandstop:
+		zpk = lp2bs_zpk<D>(zpk, std::sqrt(warped[0] * warped[1]), warped[1] - warped[0]);
+		break;
+	}
+	zpk = bilinear_zpk<D>(zpk, 2);
+
+	const auto sosD = zpk2sos<D>(zpk);
+	SecondOrderSections<T> sos(sosD.size());
+	for (size_t i = 0; i < sos.size(); ++i)
+	{
+		for (size_t j = 0; j < 6; ++j)
+		{
+			sos[i][j] = static_cast<T>(sosD[i][j]);
+		}
+	}
+	return sos;
+}
+
+template <class T>
+dsp::filter::SosFilter<T>::SosFilter(const SecondOrderSections<T>& sos)
+	: coefficients_(sos.size()), state_(sos.size(), { 0, 0 })
+{
+	for (size_t i = 0; i < sos.size(); ++i)
+	{
+		const auto a0 = sos[i][3];
+		if (a0 == 0)
+		{
+			throw std::invalid_argument("Leading denominator coefficient of a section must not be zero!");
+		}
+		coefficients_[i] = { sos[i][0] / a0, sos[i][1] / a0, sos[i][2] / a0, sos[i][4] / a0, sos[i][5] / a0 };
+	}
+}
+
+template <class T>
+void dsp::filter::SosFilter<T>::process(const T* in, T* out, size_t n)
+{
+	if (coefficients_.empty())
+	{
+		std::copy(in, in + n, out);
+		return;
+	}
+
+	// Section-major order: each biquad runs over the whole block with its coefficients and state in registers
+	runSection(0, [in](size_t i) { return in[i]; }, out, n);
+	for (size_t s = 1; s < coefficients_.size(); ++s)
+	{
+		runSection(s, [out](size_t i) { return out[i]; }, out, n);
+	}
+}
+
+template <class T>
+template <class P, std::enable_if_t<dsp::pcm::is_pcm_v<P>, int>>
+void dsp::filter::SosFilter<T>::process(const P* in, T* out, size_t n)
+{
+	if (coefficients_.empty())
+	{
+		pcm::decode(in, out, n);
+		return;
+	}
+
+	// The first section converts while loading, so no intermediate floating-point copy of the block is needed
+	runSection(0, [in](size_t i) { return pcm::toFloat<T>(in[i]); }, out, n);
+	for (size_t s = 1; s < coefficients_.size(); ++s)
+	{
+		runSection(s, [out](size_t i) { return out[i]; }, out, n);
+	}
+}
+
+template <class T>
+template <class Load>
+void dsp::filter::SosFilter<T>::runSection(size_t s, Load load, T* out, size_t n)
+{
+	const auto [b0, b1, b2, a1, a2] = coefficients_[s];
+	T z1 = state_[s][0];
+	T z2 = state_[s][1];
+	for (size_t i = 0; i < n; ++i)
+	{
+		const T x = load(i);
+		const T y = b0 * x + z1;
+		z1 = b1 * x - a1 * y + z2;
+		z2 = b2 * x - a2 * y;
+		out[i] = y;
+	}
+	state_[s] = { z1, z2 };
+}
+
+template <class T>
+std::vector<T> dsp::filter::SosFilter<T>::process(const std::vector<T>& x)
+{
+	std::vector<T> y(x.size());
+	process(x.data(), y.data(), x.size());
+	return y;
+}
+
+template <class T>
+void dsp::filter::SosFilter<T>::reset()
+{
+	std::fill(state_.begin(), state_.end(), std::array<T, 2>{ 0, 0 });
+}
+
+template <class T>
+std::vector<T> dsp::filter::sosfilt(const SecondOrderSections<T>& sos, const std::vector<T>& x)
+{
+	return SosFilter<T>(sos).process(x);
+}
+
 template <class T>
 std::vector<T> dsp::filter::filter(std::vector<T> b,
 	std::vector<T> a, const std::vector<T>& x)
+{
+	return filter(std::move(b), std::move(a), SignalView<T>(x));
+}
+
+template<class T>
+std::vector<T> dsp::filter::filter(std::vector<T> b, std::vector<T> a, SignalView<T> x)
 {
 	// Normalize filter coefficients
 	auto a0 = a[0];
@@ -20,7 +1228,7 @@ std::vector<T> dsp::filter::filter(std::vector<T> b,
 	if (a.size() == 1)
 	{
 		// This is the simple case without a denominator in the transfer function
-		return dsp::convolve(x, b);
+		return dsp::convolve(x, SignalView<T>(b));
 	}
 
 	// This is the more complicated case with both numerator and denominator
@@ -47,45 +1255,400 @@ std::vector<T> dsp::filter::filter(std::vector<T> b,
 template<class T>
 std::vector<T> dsp::filter::lpc(const std::vector<T>& x, unsigned N)
 {
-	std::vector<T> r;
-	auto numCoefficients = N + 1;
-	r.resize(numCoefficients);
+	LpcResult<T> result;
+	LpcAnalyzer<T>(N).analyze(x.data(), x.size(), result);
+	return std::move(result.coefficients);
+}
+
+template <class T>
+dsp::filter::LpcAnalyzer<T>::LpcAnalyzer(unsigned order, autocorrelation_method method)
+	: order_(order), method_(method), r_(order + 1), alpha_(order + 1), scratch_(order + 1)
+{
+}
+
+template <class T>
+dsp::filter::autocorrelation_method dsp::filter::LpcAnalyzer<T>::selectMethod(size_t length) const
+{
+	if (method_ != autocorrelation_method::automatic) { return method_; }
+
+	// Rough operation counts: the direct methods need length * (order + 1) multiply-adds, the FFT method two
+	// real transforms of the zero-padded frame.
+	size_t nfft = 1;
+	while (nfft < length + order_) { nfft <<= 1; }
+	const double directCost = static_cast<double>(length) * (order_ + 1);
+	const double fftCost = 4.0 * nfft * std::log2(static_cast<double>(nfft));
+	if (directCost > fftCost) { return autocorrelation_method::fft; }
+	return order_ >= 3 ? autocorrelation_method::vectorized : autocorrelation_method::direct;
+}
+
+template <class T>
+void dsp::filter::LpcAnalyzer<T>::autocorrelate(const T* x, size_t length)
+{
+	std::fill(r_.begin(), r_.end(), T(0));
+	const size_t maxLag = std::min<size_t>(order_, length > 0 ? length - 1 : 0);
+	if (length == 0) { return; }
+
+	switch (selectMethod(length))
+	{
+	case autocorrelation_method::fft:
+	{
+		// The buffers keep their capacity, so frames of the same length do not allocate
+		size_t nfft = 4;
+		while (nfft < length + order_) { nfft <<= 1; }
+		padded_.assign(nfft, T(0));
+		std::copy(x, x + length, padded_.begin());
+		spectrum_.resize(nfft);
+		fft::rfft(padded_.data(), spectrum_.data(), static_cast<unsigned>(nfft));
 
-	for (size_t i = 0; i <= N; i++)
+		// The power spectrum is real and even, so its inverse transform is its forward transform divided by nfft
+		for (size_t k = 0; k < nfft; ++k) { padded_[k] = std::norm(spectrum_[k]); }
+		fft::rfft(padded_.data(), spectrum_.data(), static_cast<unsigned>(nfft));
+		for (size_t lag = 0; lag <= maxLag; ++lag) { r_[lag] = spectrum_[lag].real() / static_cast<T>(nfft); }
+		break;
+	}
+	case autocorrelation_method::vectorized:
 	{
-		r[i] = 0.0;
-		for (size_t j = 0; j < x.size() - i; ++j)
+		// Four lags per pass over the frame: the inner loop has four independent accumulators and only one load of x[j]
+		size_t lag = 0;
+		for (; lag + 3 <= maxLag; lag += 4)
+		{
+			T r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+			const size_t n = length - lag - 3;
+			for (size_t j = 0; j < n; ++j)
+			{
+				const T xj = x[j];
+				r0 += xj * x[j + lag];
+				r1 += xj * x[j + lag + 1];
+				r2 += xj * x[j + lag + 2];
+				r3 += xj * x[j + lag + 3];
+			}
+			// Tails of the shorter lags
+			for (size_t j = n; j < length - lag; ++j) { r0 += x[j] * x[j + lag]; }
+			for (size_t j = n; j < length - lag - 1; ++j) { r1 += x[j] * x[j + lag + 1]; }
+			for (size_t j = n; j < length - lag - 2; ++j) { r2 += x[j] * x[j + lag + 2]; }
+			r_[lag] = r0;
+			r_[lag + 1] = r1;
+			r_[lag + 2] = r2;
+			r_[lag + 3] = r3;
+		}
+		for (; lag <= maxLag; ++lag)
+		{
+			T sum = 0;
+			for (size_t j = 0; j < length - lag; ++j) { sum += x[j] * x[j + lag]; }
+			r_[lag] = sum;
+		}
+		break;
+	}
+	default:
+		for (size_t lag = 0; lag <= maxLag; ++lag)
 		{
-			r[i] += x[j] * x[j + i];
+			T sum = 0;
+			for (size_t j = 0; j < length - lag; ++j) { sum += x[j] * x[j + lag]; }
+			r_[lag] = sum;
 		}
+		break;
 	}
+}
+
+template <class T>
+void dsp::filter::LpcAnalyzer<T>::analyze(const T* frame, size_t length, LpcResult<T>& result)
+{
+	autocorrelate(frame, length);
 
 	// Levinson-Durbin
-	T E = r[0];
-	std::vector<T> alpha(numCoefficients, 0);
-	alpha[0] = 1.0;
-	std::vector<T> beta(numCoefficients, 0);
-	std::vector<T> z(numCoefficients, 0);
+	result.reflection.resize(order_);
+	std::fill(alpha_.begin(), alpha_.end(), T(0));
+	alpha_[0] = 1;
+	T E = r_[0];
+	for (unsigned p = 1; p <= order_; ++p)
+	{
+		T q = 0;
+		for (unsigned i = 0; i < p; ++i) { q += alpha_[i] * r_[p - i]; }
+		if (E == 0) { E = static_cast<T>(0.0001); }
+		const T k = -q / E;
+		result.reflection[p - 1] = k;
+
+		std::copy(alpha_.begin(), alpha_.begin() + p + 1, scratch_.begin());
+		for (unsigned i = 1; i <= p; ++i) { alpha_[i] = scratch_[i] + k * scratch_[p - i]; }
+
+		E = E * (1 - k * k);
+	}
+	result.error = E;
+
+	result.coefficients.resize(order_ + 1);
+	result.coefficients[0] = 1;
+	for (unsigned i = 1; i <= order_; ++i) { result.coefficients[i] = -alpha_[i]; }
+}
+
+template <class T>
+dsp::filter::LpcResult<T> dsp::filter::LpcAnalyzer<T>::analyze(const std::vector<T>& frame)
+{
+	LpcResult<T> result;
+	analyze(frame.data(), frame.size(), result);
+	return result;
+}
+
+template <class T>
+std::vector<dsp::filter::LpcResult<T>> dsp::filter::lpc(const std::vector<std::vector<T>>& frames, unsigned N,
+	autocorrelation_method method)
+{
+	std::vector<LpcResult<T>> results(frames.size());
+	LpcAnalyzer<T> analyzer(N, method);
+	for (size_t i = 0; i < frames.size(); ++i)
+	{
+		analyzer.analyze(frames[i].data(), frames[i].size(), results[i]);
+	}
+	return results;
+}
+
+template <class T>
+void dsp::filter::lpcResidual(const T* x, T* residual, size_t length, const T* coeff, unsigned N)
+{
+	std::copy(x, x + length, residual);
+	// One contiguous multiply-subtract per predictor tap, which the compiler can vectorize
+	for (size_t j = 1; j <= N && j < length; ++j)
+	{
+		const T c = coeff[j];
+		for (size_t i = j; i < length; ++i)
+		{
+			residual[i] -= c * x[i - j];
+		}
+	}
+}
+
+template <class T>
+std::vector<T> dsp::filter::lpcResidual(const std::vector<T>& x, const std::vector<T>& coeff)
+{
+	if (coeff.empty()) { return x; }
+	std::vector<T> residual(x.size());
+	lpcResidual(x.data(), residual.data(), x.size(), coeff.data(), static_cast<unsigned>(coeff.size() - 1));
+	return residual;
+}
+
+template <class T>
+std::vector<std::vector<T>> dsp::filter::lpcResidual(const std::vector<std::vector<T>>& frames, const std::vector<std::vector<T>>& coeffs)
+{
+	if (frames.size() != coeffs.size())
+	{
+		throw std::invalid_argument("Number of frames and coefficient sets must be equal!");
+	}
+	std::vector<std::vector<T>> residuals(frames.size());
+	for (size_t f = 0; f < frames.size(); ++f)
+	{
+		residuals[f] = lpcResidual(frames[f], coeffs[f]);
+	}
+	return residuals;
+}
+
+template <class T>
+void dsp::filter::lpcSynthesis(const T* residual, T* x, size_t length, const T* coeff, unsigned N)
+{
+	for (size_t i = 0; i < length; ++i)
+	{
+		T sum = residual[i];
+		const size_t J = std::min<size_t>(N, i);
+		for (size_t j = 1; j <= J; ++j)
+		{
+			sum += coeff[j] * x[i - j];
+		}
+		x[i] = sum;
+	}
+}
+
+template <class T>
+std::vector<T> dsp::filter::lpcSynthesis(const std::vector<T>& residual, const std::vector<T>& coeff)
+{
+	if (coeff.empty()) { return residual; }
+	std::vector<T> x(residual.size());
+	lpcSynthesis(residual.data(), x.data(), residual.size(), coeff.data(), static_cast<unsigned>(coeff.size() - 1));
+	return x;
+}
+
+template <class T>
+std::vector<std::vector<T>> dsp::filter::lpcSynthesis(const std::vector<std::vector<T>>& residuals, const std::vector<std::vector<T>>& coeffs)
+{
+	if (residuals.size() != coeffs.size())
+	{
+		throw std::invalid_argument("Number of frames and coefficient sets must be equal!");
+	}
+	std::vector<std::vector<T>> frames(residuals.size());
+	for (size_t f = 0; f < residuals.size(); ++f)
+	{
+		frames[f] = lpcSynthesis(residuals[f], coeffs[f]);
+	}
+	return frames;
+}
+
+template <class T>
+void dsp::filter::lpcToPolynomial(const T* lpcCoefficients, T* polynomial, unsigned N)
+{
+	polynomial[0] = lpcCoefficients[0];
+	for (unsigned i = 1; i <= N; ++i)
+	{
+		polynomial[i] = -lpcCoefficients[i];
+	}
+}
+
+template <class T>
+std::vector<T> dsp::filter::lpcToPolynomial(const std::vector<T>& lpcCoefficients)
+{
+	if (lpcCoefficients.empty()) { return {}; }
+	std::vector<T> polynomial(lpcCoefficients.size());
+	lpcToPolynomial(lpcCoefficients.data(), polynomial.data(), static_cast<unsigned>(lpcCoefficients.size() - 1));
+	return polynomial;
+}
+
+template <class T>
+void dsp::filter::polynomialRoots(const T* a, unsigned N, std::complex<T>* roots, unsigned maxIterations)
+{
+	if (N == 0) { return; }
+	if (a[0] == T(0))
+	{
+		throw std::invalid_argument("The leading coefficient of the polynomial must not be zero!");
+	}
+
+	// The iteration runs on the monic polynomial, so that the accuracy bounds and the singularity threshold do not depend
+	// on the scale of the coefficients. An odd degree is raised by one, i.e., the polynomial is multiplied by x.
+	const T scale = 1 / a[0];
+	auto coefficient = [a, N, scale](unsigned i) { return i <= N ? a[i] * scale : T(0); };
+	const unsigned degree = N + N % 2;
+	const unsigned M = degree / 2;
 
-	for (unsigned p = 1; p <= N; ++p)
+	// Quadratic factor j is x^2 + beta_j * x + gamma_j with (beta_j, gamma_j) = roots[j]. The angle of its starting
+	// value on the unit circle is kept in roots[M + j].
+	auto beta = [roots](unsigned j) -> T& { return reinterpret_cast<T*>(roots + j)[0]; };
+	auto gamma = [roots](unsigned j) -> T& { return reinterpret_cast<T*>(roots + j)[1]; };
+	auto startAngle = [roots, M](unsigned j) -> T& { return reinterpret_cast<T*>(roots + M + j)[0]; };
+
+	// Start with the complex roots of unity
+	for (unsigned m = 0; m + 1 < M; ++m)
+	{
+		startAngle(m) = static_cast<T>(pi) * (m + 1) / M;
+		beta(m) = 2 * std::cos(startAngle(m));
+		gamma(m) = 1;
+	}
+	startAngle(M - 1) = 0;
+	beta(M - 1) = 0;
+	gamma(M - 1) = -1;
+
+	// Relative accuracy bounds. The legacy implementation used 1e-4, which only gives about three correct digits; the
+	// iteration now runs down to the precision of T (bounded by maxIterations).
+	const T singular = static_cast<T>(0.0001);
+	const T epsilon = 10 * std::numeric_limits<T>::epsilon();
+	T epsilon1 = 2 * epsilon;
+	T epsilon2 = 2 * epsilon;
+	T E1 = 0;
+	T E2 = 0;
+	unsigned numRestarts = 0;
+
+	bool done = false;
+	for (unsigned l = 1; l <= maxIterations && !done; ++l)
 	{
-		T q = 0.0;
-		for (unsigned i = 0; i < p; ++i) { q += alpha[i] * r[p - i]; }
-		if (E == 0.0) { E = static_cast<T>(0.0001); }
-		z[p] = -q / E;
-		alpha[p] = 0.0;
-		for (unsigned i = 0; i <= p; ++i) { beta[i] = alpha[i] + z[p] * alpha[p - i]; }
-		for (unsigned i = 0; i <= p; ++i) { alpha[i] = beta[i]; }
+		unsigned numCorrected = 0;
+		unsigned j = 0;
+		while (j < M)
+		{
+			const T p = beta(j);
+			const T q = gamma(j);
+
+			// Two-row Horner scheme for the remainder c[0] * x + c[1] of the division by the quadratic factor
+			T c0 = coefficient(0);
+			T c1 = coefficient(1) - p * coefficient(0);
+			for (unsigned i = 2; i <= degree; ++i)
+			{
+				const T temp = c1;
+				c1 = coefficient(i) - p * c1 - q * c0;
+				c0 = temp;
+			}
+			c1 = c1 + p * c0;
+
+			if (l == 1) { E2 += std::abs(c0) + std::abs(c1); }
 
-		E = E * (static_cast<T>(1.0) - z[p] * z[p]);
+			if (std::abs(c0) + std::abs(c1) < epsilon2)
+			{
+				++j;
+				continue;
+			}
+
+			// Product of the other factors at the roots of this one, as S + v * T
+			const T u = -p / 2;
+			const T w = u * u - q;
+			T S = coefficient(0);
+			T Tv = 0;
+			for (unsigned m = 0; m < M; ++m)
+			{
+				if (m == j) { continue; }
+				const T Tm = beta(m) - p;
+				const T Sm = u * Tm + gamma(m) - q;
+				const T SNew = S * Sm + w * Tv * Tm;
+				const T TNew = S * Tm + Tv * Sm;
+				S = SNew;
+				Tv = TNew;
+			}
+
+			const T D = S * S - Tv * Tv * w;
+			if (std::abs(D) < singular)
+			{
+				// Nearly singular: move the starting value a little along the unit circle and try again. The restarts have
+				// the same budget as the corrections, since a factor that stays singular would otherwise never be left.
+				if (++numRestarts > maxIterations * M)
+				{
+					throw std::runtime_error("Polynomial root finding did not converge (singular corrections)!");
+				}
+				startAngle(j) += static_cast<T>(0.012345);
+				beta(j) = 2 * std::cos(startAngle(j));
+				gamma(j) = 1;
+				continue;
+			}
+
+			const T h = (c0 * (S - u * Tv) - Tv * c1) / D;
+			const T k = (c1 * (S + u * Tv) + c0 * Tv * q) / D;
+			beta(j) += h;
+			gamma(j) += k;
+
+			if (std::abs(h) + std::abs(k) >= epsilon1) { ++numCorrected; }
+
+			if (l == 1)
+			{
+				E1 += std::abs(h) + std::abs(k);
+				epsilon1 = (epsilon * E1) / M;
+				epsilon2 = (epsilon * E2) / M;
+			}
+			++j;
+		}
+		done = numCorrected == 0;
 	}
 
-	std::vector<T> coeff;
-	coeff.resize(N + 1);
-	coeff[0] = 1;
-	for (unsigned i = 1; i <= N; ++i) { coeff[i] = -alpha[i]; }
+	// Roots of the quadratic factors. Going backwards, factor j is read before roots 2j and 2j + 1 overwrite it.
+	for (unsigned j = M; j-- > 0;)
+	{
+		const T b = beta(j);
+		const T g = gamma(j);
+		const T re = -b / 2;
+		const T discriminant = b * b / 4 - g;
+		if (discriminant <= 0)
+		{
+			const T im = std::sqrt(-discriminant);
+			roots[2 * j] = { re, im };
+			roots[2 * j + 1] = { re, -im };
+		}
+		else
+		{
+			const T root = std::sqrt(discriminant);
+			roots[2 * j] = { re + root, 0 };
+			roots[2 * j + 1] = { re - root, 0 };
+		}
+	}
+}
 
-	return coeff;
+template <class T>
+std::vector<std::complex<T>> dsp::filter::polynomialRoots(const std::vector<T>& a, unsigned maxIterations)
+{
+	if (a.size() < 2) { return {}; }
+	const auto N = static_cast<unsigned>(a.size() - 1);
+	std::vector<std::complex<T>> roots(N + N % 2);
+	polynomialRoots(a.data(), N, roots.data(), maxIterations);
+	return roots;
 }
 
 template <class T>
@@ -120,15 +1683,168 @@ template std::vector<double> dsp::filter::filter(std::vector<double> b,
 	std::vector<double> a, const std::vector<double>& x);
 template std::vector<long double> dsp::filter::filter(std::vector<long double> b,
 	std::vector<long double> a, const std::vector<long double>& x);
+template std::vector<float> dsp::filter::filter(std::vector<float> b, std::vector<float> a, SignalView<float> x);
+template std::vector<double> dsp::filter::filter(std::vector<double> b, std::vector<double> a, SignalView<double> x);
+template std::vector<long double> dsp::filter::filter(std::vector<long double> b, std::vector<long double> a, SignalView<long double> x);
 
 template std::vector<float> dsp::filter::lpc(const std::vector<float>& x, unsigned N);
 template std::vector<double> dsp::filter::lpc(const std::vector<double>& x, unsigned N);
 template std::vector<long double> dsp::filter::lpc(const std::vector<long double>& x, unsigned N);
 
+template class dsp::filter::LpcAnalyzer<float>;
+template class dsp::filter::LpcAnalyzer<double>;
+template class dsp::filter::LpcAnalyzer<long double>;
+
+template std::vector<dsp::filter::LpcResult<float>> dsp::filter::lpc(const std::vector<std::vector<float>>& frames, unsigned N,
+	autocorrelation_method method);
+template std::vector<dsp::filter::LpcResult<double>> dsp::filter::lpc(const std::vector<std::vector<double>>& frames, unsigned N,
+	autocorrelation_method method);
+template std::vector<dsp::filter::LpcResult<long double>> dsp::filter::lpc(const std::vector<std::vector<long double>>& frames, unsigned N,
+	autocorrelation_method method);
+
 template std::vector<float> dsp::filter::medianfilter(const std::vector<float>& x, size_t kernel_size);
 template std::vector<double> dsp::filter::medianfilter(const std::vector<double>& x, size_t kernel_size);
 template std::vector<long double> dsp::filter::medianfilter(const std::vector<long double>& x, size_t kernel_size);
 
 template dsp::Signal<float> dsp::filter::medianfilter(const dsp::Signal<float>& x, Signal<float>::size_type kernel_size);
 template dsp::Signal<double> dsp::filter::medianfilter(const dsp::Signal<double>& x, Signal<double>::size_type kernel_size);
-template dsp::Signal<long double> dsp::filter::medianfilter(const dsp::Signal<long double>& x, Signal<long double>::size_type kernel_size);
\ No newline at end of file
+template dsp::Signal<long double> dsp::filter::medianfilter(const dsp::Signal<long double>& x, Signal<long double>::size_type kernel_size);
+
+template std::vector<float> dsp::filter::firwin(unsigned numtaps, const std::vector<float>& cutoff, bool pass_zero,
+	window::type windowType, bool scale, float fs, const std::vector<float>& windowParameters);
+template std::vector<double> dsp::filter::firwin(unsigned numtaps, const std::vector<double>& cutoff, bool pass_zero,
+	window::type windowType, bool scale, double fs, const std::vector<double>& windowParameters);
+template std::vector<long double> dsp::filter::firwin(unsigned numtaps, const std::vector<long double>& cutoff, bool pass_zero,
+	window::type windowType, bool scale, long double fs, const std::vector<long double>& windowParameters);
+
+template std::vector<float> dsp::filter::firls(unsigned numtaps, const std::vector<float>& bands, const std::vector<float>& desired,
+	const std::vector<float>& weight, float fs);
+template std::vector<double> dsp::filter::firls(unsigned numtaps, const std::vector<double>& bands, const std::vector<double>& desired,
+	const std::vector<double>& weight, double fs);
+template std::vector<long double> dsp::filter::firls(unsigned numtaps, const std::vector<long double>& bands, const std::vector<long double>& desired,
+	const std::vector<long double>& weight, long double fs);
+
+template std::vector<float> dsp::filter::remez(unsigned numtaps, const std::vector<float>& bands, const std::vector<float>& desired,
+	const std::vector<float>& weight, float fs, remez_type type, unsigned maxiter, unsigned grid_density);
+template std::vector<double> dsp::filter::remez(unsigned numtaps, const std::vector<double>& bands, const std::vector<double>& desired,
+	const std::vector<double>& weight, double fs, remez_type type, unsigned maxiter, unsigned grid_density);
+template std::vector<long double> dsp::filter::remez(unsigned numtaps, const std::vector<long double>& bands, const std::vector<long double>& desired,
+	const std::vector<long double>& weight, long double fs, remez_type type, unsigned maxiter, unsigned grid_density);
+
+template const std::vector<float>& dsp::filter::firdesign(const FirSpec<float>& spec);
+template const std::vector<double>& dsp::filter::firdesign(const FirSpec<double>& spec);
+template const std::vector<long double>& dsp::filter::firdesign(const FirSpec<long double>& spec);
+
+template void dsp::filter::clearFirDesignCache<float>();
+template void dsp::filter::clearFirDesignCache<double>();
+template void dsp::filter::clearFirDesignCache<long double>();
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::buttap(unsigned N);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::buttap(unsigned N);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::buttap(unsigned N);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::cheb1ap(unsigned N, float rp);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::cheb1ap(unsigned N, double rp);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::cheb1ap(unsigned N, long double rp);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::cheb2ap(unsigned N, float rs);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::cheb2ap(unsigned N, double rs);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::cheb2ap(unsigned N, long double rs);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::ellipap(unsigned N, float rp, float rs);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::ellipap(unsigned N, double rp, double rs);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::ellipap(unsigned N, long double rp, long double rs);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::lp2lp_zpk(const ZeroPoleGain<float>& prototype, float wo);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::lp2lp_zpk(const ZeroPoleGain<double>& prototype, double wo);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::lp2lp_zpk(const ZeroPoleGain<long double>& prototype, long double wo);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::lp2hp_zpk(const ZeroPoleGain<float>& prototype, float wo);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::lp2hp_zpk(const ZeroPoleGain<double>& prototype, double wo);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::lp2hp_zpk(const ZeroPoleGain<long double>& prototype, long double wo);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::lp2bp_zpk(const ZeroPoleGain<float>& prototype, float wo, float bw);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::lp2bp_zpk(const ZeroPoleGain<double>& prototype, double wo, double bw);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::lp2bp_zpk(const ZeroPoleGain<long double>& prototype, long double wo, long double bw);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::lp2bs_zpk(const ZeroPoleGain<float>& prototype, float wo, float bw);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::lp2bs_zpk(const ZeroPoleGain<double>& prototype, double wo, double bw);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::lp2bs_zpk(const ZeroPoleGain<long double>& prototype, long double wo, long double bw);
+
+template dsp::filter::ZeroPoleGain<float> dsp::filter::bilinear_zpk(const ZeroPoleGain<float>& analog, float fs);
+template dsp::filter::ZeroPoleGain<double> dsp::filter::bilinear_zpk(const ZeroPoleGain<double>& analog, double fs);
+template dsp::filter::ZeroPoleGain<long double> dsp::filter::bilinear_zpk(const ZeroPoleGain<long double>& analog, long double fs);
+
+template dsp::filter::SecondOrderSections<float> dsp::filter::zpk2sos(const ZeroPoleGain<float>& zpk);
+template dsp::filter::SecondOrderSections<double> dsp::filter::zpk2sos(const ZeroPoleGain<double>& zpk);
+template dsp::filter::SecondOrderSections<long double> dsp::filter::zpk2sos(const ZeroPoleGain<long double>& zpk);
+
+template dsp::filter::SecondOrderSections<float> dsp::filter::iirfilter(unsigned N, const std::vector<float>& Wn, filter_type btype,
+	iir_type ftype, float rp, float rs, float fs);
+template dsp::filter::SecondOrderSections<double> dsp::filter::iirfilter(unsigned N, const std::vector<double>& Wn, filter_type btype,
+	iir_type ftype, double rp, double rs, double fs);
+template dsp::filter::SecondOrderSections<long double> dsp::filter::iirfilter(unsigned N, const std::vector<long double>& Wn, filter_type btype,
+	iir_type ftype, long double rp, long double rs, long double fs);
+
+template class dsp::filter::SosFilter<float>;
+template class dsp::filter::SosFilter<double>;
+template class dsp::filter::SosFilter<long double>;
+
+#define DSP_INSTANTIATE_SOS_PCM(T, P) \
+	template void dsp::filter::SosFilter<T>::process(const dsp::pcm::P* in, T* out, size_t n);
+
+DSP_INSTANTIATE_SOS_PCM(float, int16)
+DSP_INSTANTIATE_SOS_PCM(float, int24)
+DSP_INSTANTIATE_SOS_PCM(float, int32)
+DSP_INSTANTIATE_SOS_PCM(double, int16)
+DSP_INSTANTIATE_SOS_PCM(double, int24)
+DSP_INSTANTIATE_SOS_PCM(double, int32)
+DSP_INSTANTIATE_SOS_PCM(long double, int16)
+DSP_INSTANTIATE_SOS_PCM(long double, int24)
+DSP_INSTANTIATE_SOS_PCM(long double, int32)
+
+#undef DSP_INSTANTIATE_SOS_PCM
+
+template std::vector<float> dsp::filter::sosfilt(const SecondOrderSections<float>& sos, const std::vector<float>& x);
+template std::vector<double> dsp::filter::sosfilt(const SecondOrderSections<double>& sos, const std::vector<double>& x);
+template std::vector<long double> dsp::filter::sosfilt(const SecondOrderSections<long double>& sos, const std::vector<long double>& x);
+
+template void dsp::filter::lpcResidual(const float* x, float* residual, size_t length, const float* coeff, unsigned N);
+template void dsp::filter::lpcResidual(const double* x, double* residual, size_t length, const double* coeff, unsigned N);
+template void dsp::filter::lpcResidual(const long double* x, long double* residual, size_t length, const long double* coeff, unsigned N);
+
+template std::vector<float> dsp::filter::lpcResidual(const std::vector<float>& x, const std::vector<float>& coeff);
+template std::vector<double> dsp::filter::lpcResidual(const std::vector<double>& x, const std::vector<double>& coeff);
+template std::vector<long double> dsp::filter::lpcResidual(const std::vector<long double>& x, const std::vector<long double>& coeff);
+
+template std::vector<std::vector<float>> dsp::filter::lpcResidual(const std::vector<std::vector<float>>& frames, const std::vector<std::vector<float>>& coeffs);
+template std::vector<std::vector<double>> dsp::filter::lpcResidual(const std::vector<std::vector<double>>& frames, const std::vector<std::vector<double>>& coeffs);
+template std::vector<std::vector<long double>> dsp::filter::lpcResidual(const std::vector<std::vector<long double>>& frames, const std::vector<std::vector<long double>>& coeffs);
+
+template void dsp::filter::lpcSynthesis(const float* residual, float* x, size_t length, const float* coeff, unsigned N);
+template void dsp::filter::lpcSynthesis(const double* residual, double* x, size_t length, const double* coeff, unsigned N);
+template void dsp::filter::lpcSynthesis(const long double* residual, long double* x, size_t length, const long double* coeff, unsigned N);
+
+template std::vector<float> dsp::filter::lpcSynthesis(const std::vector<float>& residual, const std::vector<float>& coeff);
+template std::vector<double> dsp::filter::lpcSynthesis(const std::vector<double>& residual, const std::vector<double>& coeff);
+template std::vector<long double> dsp::filter::lpcSynthesis(const std::vector<long double>& residual, const std::vector<long double>& coeff);
+
+template std::vector<std::vector<float>> dsp::filter::lpcSynthesis(const std::vector<std::vector<float>>& residuals, const std::vector<std::vector<float>>& coeffs);
+template std::vector<std::vector<double>> dsp::filter::lpcSynthesis(const std::vector<std::vector<double>>& residuals, const std::vector<std::vector<double>>& coeffs);
+template std::vector<std::vector<long double>> dsp::filter::lpcSynthesis(const std::vector<std::vector<long double>>& residuals, const std::vector<std::vector<long double>>& coeffs);
+
+template void dsp::filter::lpcToPolynomial(const float* lpcCoefficients, float* polynomial, unsigned N);
+template void dsp::filter::lpcToPolynomial(const double* lpcCoefficients, double* polynomial, unsigned N);
+template void dsp::filter::lpcToPolynomial(const long double* lpcCoefficients, long double* polynomial, unsigned N);
+
+template std::vector<float> dsp::filter::lpcToPolynomial(const std::vector<float>& lpcCoefficients);
+template std::vector<double> dsp::filter::lpcToPolynomial(const std::vector<double>& lpcCoefficients);
+template std::vector<long double> dsp::filter::lpcToPolynomial(const std::vector<long double>& lpcCoefficients);
+
+template void dsp::filter::polynomialRoots(const float* a, unsigned N, std::complex<float>* roots, unsigned maxIterations);
+template void dsp::filter::polynomialRoots(const double* a, unsigned N, std::complex<double>* roots, unsigned maxIterations);
+template void dsp::filter::polynomialRoots(const long double* a, unsigned N, std::complex<long double>* roots, unsigned maxIterations);
+
+template std::vector<std::complex<float>> dsp::filter::polynomialRoots(const std::vector<float>& a, unsigned maxIterations);
+template std::vector<std::complex<double>> dsp::filter::polynomialRoots(const std::vector<double>& a, unsigned maxIterations);
+template std::vector<std::complex<long double>> dsp::filter::polynomialRoots(const std::vector<long double>& a, unsigned maxIterations);
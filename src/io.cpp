@@ -0,0 +1,669 @@
+#include "io.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "arena.h"
+#include "kernels.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	using dsp::io::AudioFormat;
+	using dsp::io::sample_format;
+
+	// Size of the chunks in which samples are converted while streaming
+	constexpr size_t chunkBytes = 1 << 16;
+
+	// WAVE format tags
+	constexpr std::uint16_t formatPcm = 0x0001;
+	constexpr std::uint16_t formatFloat = 0x0003;
+	constexpr std::uint16_t formatExtensible = 0xFFFE;
+
+	// Position and size of the samples in a file
+	struct Layout
+	{
+		AudioFormat format;
+		std::uint64_t dataOffset{ 0 };
+		std::uint64_t dataBytes{ 0 };
+	};
+
+	std::uint16_t le16(const unsigned char* p) { return static_cast<std::uint16_t>(p[0] | (p[1] << 8)); }
+	std::uint32_t le32(const unsigned char* p) { return le16(p) | (static_cast<std::uint32_t>(le16(p + 2)) << 16); }
+	std::uint64_t le64(const unsigned char* p) { return le32(p) | (static_cast<std::uint64_t>(le32(p + 4)) << 32); }
+
+	void put16(std::vector<char>& out, std::uint16_t value)
+	{
+		out.push_back(static_cast<char>(value));
+		out.push_back(static_cast<char>(value >> 8));
+	}
+	void put32(std::vector<char>& out, std::uint32_t value) { put16(out, static_cast<std::uint16_t>(value)); put16(out, static_cast<std::uint16_t>(value >> 16)); }
+	void put64(std::vector<char>& out, std::uint64_t value) { put32(out, static_cast<std::uint32_t>(value)); put32(out, static_cast<std::uint32_t>(value >> 32)); }
+	void putId(std::vector<char>& out, const char* id) { out.insert(out.end(), id, id + 4); }
+
+	sample_format toSampleFormat(std::uint16_t formatTag, std::uint16_t bitsPerSample)
+	{
+		if (formatTag == formatPcm && bitsPerSample == 16) return sample_format::pcm16;
+		if (formatTag == formatPcm && bitsPerSample == 24) return sample_format::pcm24;
+		if (formatTag == formatPcm && bitsPerSample == 32) return sample_format::pcm32;
+		if (formatTag == formatFloat && bitsPerSample == 32) return sample_format::float32;
+		if (formatTag == formatFloat && bitsPerSample == 64) return sample_format::float64;
+		throw std::runtime_error("Unsupported WAV sample format!");
+	}
+
+	// Parses the header of a WAV or RF64 file. read(offset, buffer, n) copies n bytes of the file starting at offset
+	// and returns false if the file ends before.
+	template<class Read>
+	Layout parseWav(Read read, std::uint64_t fileSize)
+	{
+		unsigned char riff[12];
+		if (!read(0, riff, 12) || std::memcmp(riff + 8, "WAVE", 4) != 0)
+		{
+			throw std::runtime_error("Not a WAV file!");
+		}
+		const bool rf64 = std::memcmp(riff, "RF64", 4) == 0 || std::memcmp(riff, "BW64", 4) == 0;
+		if (!rf64 && std::memcmp(riff, "RIFF", 4) != 0)
+		{
+			throw std::runtime_error("Not a WAV file!");
+		}
+
+		Layout layout;
+		bool hasFormat = false;
+		std::uint64_t ds64DataBytes = 0;
+		std::uint64_t offset = 12;
+		unsigned char header[8];
+		while (read(offset, header, 8))
+		{
+			const auto size = le32(header + 4);
+			const auto body = offset + 8;
+			if (std::memcmp(header, "ds64", 4) == 0)
+			{
+				unsigned char ds64[24];
+				if (size < 24 || !read(body, ds64, 24)) throw std::runtime_error("Invalid ds64 chunk!");
+				ds64DataBytes = le64(ds64 + 8);
+			}
+			else if (std::memcmp(header, "fmt ", 4) == 0)
+			{
+				unsigned char fmt[40]{};
+				if (size < 16 || !read(body, fmt, std::min<std::uint32_t>(size, 40))) throw std::runtime_error("Invalid fmt chunk!");
+				auto formatTag = le16(fmt);
+				if (formatTag == formatExtensible && size >= 40)
+				{
+					// The first two bytes of the subformat GUID hold the actual format tag
+					formatTag = le16(fmt + 24);
+				}
+				layout.format.numChannels = le16(fmt + 2);
+				layout.format.samplingRate_Hz = le32(fmt + 4);
+				layout.format.format = toSampleFormat(formatTag, le16(fmt + 14));
+				if (layout.format.numChannels == 0 || le16(fmt + 12) != layout.format.bytesPerFrame())
+				{
+					throw std::runtime_error("Invalid fmt chunk!");
+				}
+				hasFormat = true;
+			}
+			else if (std::memcmp(header, "data", 4) == 0)
+			{
+				if (!hasFormat) throw std::runtime_error("WAV file without fmt chunk!");
+				layout.dataOffset = body;
+				layout.dataBytes = (rf64 && size == 0xFFFFFFFF) ? ds64DataBytes : size;
+				// Files of interrupted recordings may be shorter than their header claims
+				layout.dataBytes = std::min(layout.dataBytes, fileSize - std::min(fileSize, body));
+				return layout;
+			}
+			offset = body + size + (size & 1);
+		}
+		throw std::runtime_error("WAV file without data chunk!");
+	}
+
+	Layout rawLayout(const AudioFormat& format, size_t headerBytes, std::uint64_t fileSize)
+	{
+		if (format.numChannels == 0) throw std::invalid_argument("The number of channels must be positive!");
+		return { format, headerBytes, fileSize - std::min<std::uint64_t>(fileSize, headerBytes) };
+	}
+
+	// The sample format stored as T without conversion, if any
+	template<class T>
+	constexpr bool isStoredAs(sample_format format)
+	{
+		return (std::is_same_v<T, float> && format == sample_format::float32)
+			|| (std::is_same_v<T, double> && format == sample_format::float64);
+	}
+
+	template<class T>
+	void decodeSamples(const char* in, sample_format format, T* out, size_t n)
+	{
+		switch (format)
+		{
+		case sample_format::pcm16:
+			dsp::pcm::decode(reinterpret_cast<const dsp::pcm::int16*>(in), out, n);
+			break;
+		case sample_format::pcm24:
+			dsp::pcm::decode(reinterpret_cast<const dsp::pcm::int24*>(in), out, n);
+			break;
+		case sample_format::pcm32:
+			dsp::pcm::decode(reinterpret_cast<const dsp::pcm::int32*>(in), out, n);
+			break;
+		case sample_format::float32:
+			std::copy_n(reinterpret_cast<const float*>(in), n, out);
+			break;
+		case sample_format::float64:
+			std::copy_n(reinterpret_cast<const double*>(in), n, out);
+			break;
+		}
+	}
+
+	template<class T>
+	size_t encodeSamples(const T* in, sample_format format, char* out, size_t n, dsp::pcm::Dither* dither)
+	{
+		switch (format)
+		{
+		case sample_format::pcm16:
+			return dsp::pcm::encode(in, reinterpret_cast<dsp::pcm::int16*>(out), n, dither);
+		case sample_format::pcm24:
+			return dsp::pcm::encode(in, reinterpret_cast<dsp::pcm::int24*>(out), n, dither);
+		case sample_format::pcm32:
+			return dsp::pcm::encode(in, reinterpret_cast<dsp::pcm::int32*>(out), n, dither);
+		case sample_format::float32:
+			std::copy_n(in, n, reinterpret_cast<float*>(out));
+			return 0;
+		case sample_format::float64:
+			std::copy_n(in, n, reinterpret_cast<double*>(out));
+			return 0;
+		}
+		return 0;
+	}
+
+	// Number of frames per streaming chunk
+	size_t chunkFrames(const AudioFormat& format)
+	{
+		return std::max<size_t>(1, chunkBytes / format.bytesPerFrame());
+	}
+}
+
+size_t dsp::io::bytesPerSample(sample_format format)
+{
+	switch (format)
+	{
+	case sample_format::pcm16: return 2;
+	case sample_format::pcm24: return 3;
+	case sample_format::pcm32: return 4;
+	case sample_format::float32: return 4;
+	case sample_format::float64: return 8;
+	}
+	throw std::invalid_argument("Unknown sample format!");
+}
+
+dsp::io::AudioReader::AudioReader(const std::string& path)
+	: file_(path, std::ios::binary)
+{
+	if (!file_.is_open()) throw std::runtime_error("Could not open file " + path + "!");
+
+	file_.seekg(0, std::ios::end);
+	const auto fileSize = static_cast<std::uint64_t>(file_.tellg());
+	const auto layout = parseWav([this](std::uint64_t offset, unsigned char* buffer, size_t n)
+		{
+			file_.clear();
+			file_.seekg(static_cast<std::streamoff>(offset));
+			file_.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(n));
+			return file_.gcount() == static_cast<std::streamsize>(n);
+		}, fileSize);
+
+	format_ = layout.format;
+	dataOffset_ = layout.dataOffset;
+	numFrames_ = static_cast<size_t>(layout.dataBytes / format_.bytesPerFrame());
+	seek(0);
+}
+
+dsp::io::AudioReader::AudioReader(const std::string& path, const AudioFormat& rawFormat, size_t headerBytes)
+	: file_(path, std::ios::binary)
+{
+	if (!file_.is_open()) throw std::runtime_error("Could not open file " + path + "!");
+
+	file_.seekg(0, std::ios::end);
+	const auto layout = rawLayout(rawFormat, headerBytes, static_cast<std::uint64_t>(file_.tellg()));
+
+	format_ = layout.format;
+	dataOffset_ = layout.dataOffset;
+	numFrames_ = static_cast<size_t>(layout.dataBytes / format_.bytesPerFrame());
+	seek(0);
+}
+
+void dsp::io::AudioReader::seek(size_t frame)
+{
+	if (frame > numFrames_) throw std::out_of_range("Frame index out of range!");
+	file_.clear();
+	file_.seekg(static_cast<std::streamoff>(dataOffset_ + static_cast<std::uint64_t>(frame) * format_.bytesPerFrame()));
+	position_ = frame;
+}
+
+template<class T>
+size_t dsp::io::AudioReader::read(T* interleaved, size_t numFrames)
+{
+	numFrames = std::min(numFrames, numFrames_ - position_);
+	const auto frameBytes = format_.bytesPerFrame();
+
+	if (isStoredAs<T>(format_.format))
+	{
+		// No conversion needed: read straight into the output
+		file_.read(reinterpret_cast<char*>(interleaved), static_cast<std::streamsize>(numFrames * frameBytes));
+	}
+	else
+	{
+		const auto maxFrames = chunkFrames(format_);
+		for (size_t done = 0; done < numFrames; done += maxFrames)
+		{
+			const auto n = std::min(maxFrames, numFrames - done);
+			buffer_.resize(n * frameBytes);
+			if (!file_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()))) break;
+			decodeSamples(buffer_.data(), format_.format, interleaved + done * format_.numChannels, n * format_.numChannels);
+		}
+	}
+	if (!file_) throw std::runtime_error("Could not read from file!");
+
+	position_ += numFrames;
+	return numFrames;
+}
+
+template<class T>
+size_t dsp::io::AudioReader::read(MultiSignal<T>& block)
+{
+	const auto numChannels = format_.numChannels;
+	if (block.numChannels() != numChannels)
+	{
+		throw std::invalid_argument("The block must have as many channels as the file!");
+	}
+
+	const auto numFrames = block.numFrames();
+	size_t frames = 0;
+	if (block.layout() == ChannelLayout::interleaved)
+	{
+		frames = read(block.data(), numFrames);
+		std::fill(block.data() + frames * numChannels, block.data() + block.size(), T(0));
+		return frames;
+	}
+
+	// Planar blocks are filled chunk by chunk through an interleaved scratch buffer
+	ScratchScope scope(threadScratch());
+	const auto maxFrames = std::min(numFrames, chunkFrames(format_));
+	auto* chunk = threadScratch().allocate<T>(maxFrames * numChannels);
+	std::vector<T*> channels(numChannels);
+	while (frames < numFrames)
+	{
+		const auto n = read(chunk, std::min(maxFrames, numFrames - frames));
+		if (n == 0) break;
+		for (unsigned c = 0; c < numChannels; ++c)
+		{
+			channels[c] = block.data() + c * numFrames + frames;
+		}
+		kernels::deinterleave(chunk, numChannels, channels.data(), n);
+		frames += n;
+	}
+	for (unsigned c = 0; c < numChannels; ++c)
+	{
+		std::fill(block.data() + c * numFrames + frames, block.data() + (c + 1) * numFrames, T(0));
+	}
+	return frames;
+}
+
+template<class T>
+dsp::MultiSignal<T> dsp::io::AudioReader::readAll(ChannelLayout layout)
+{
+	MultiSignal<T> signal(format_.samplingRate_Hz, format_.numChannels, numFrames_ - position_, layout);
+	read(signal);
+	return signal;
+}
+
+dsp::io::AudioWriter::AudioWriter(const std::string& path, const AudioFormat& format, container type)
+	: file_(path, std::ios::binary | std::ios::trunc), format_(format), container_(type)
+{
+	if (!file_.is_open()) throw std::runtime_error("Could not open file " + path + " for writing!");
+	if (format_.numChannels == 0) throw std::invalid_argument("The number of channels must be positive!");
+
+	// Writes a placeholder header with the final size, which is completed on closing
+	writeHeader();
+}
+
+dsp::io::AudioWriter::~AudioWriter()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+}
+
+template<class T>
+size_t dsp::io::AudioWriter::write(const T* interleaved, size_t numFrames, pcm::Dither* dither)
+{
+	if (!file_.is_open()) throw std::runtime_error("The file has already been closed!");
+
+	const auto frameBytes = format_.bytesPerFrame();
+	size_t clipped = 0;
+	if (isStoredAs<T>(format_.format))
+	{
+		file_.write(reinterpret_cast<const char*>(interleaved), static_cast<std::streamsize>(numFrames * frameBytes));
+	}
+	else
+	{
+		const auto maxFrames = chunkFrames(format_);
+		for (size_t done = 0; done < numFrames; done += maxFrames)
+		{
+			const auto n = std::min(maxFrames, numFrames - done);
+			buffer_.resize(n * frameBytes);
+			clipped += encodeSamples(interleaved + done * format_.numChannels, format_.format, buffer_.data(), n * format_.numChannels, dither);
+			file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+		}
+	}
+	if (!file_) throw std::runtime_error("Could not write to file!");
+
+	numFrames_ += numFrames;
+	return clipped;
+}
+
+template<class T>
+size_t dsp::io::AudioWriter::write(const MultiSignal<T>& block, pcm::Dither* dither)
+{
+	const auto numChannels = format_.numChannels;
+	if (block.numChannels() != numChannels)
+	{
+		throw std::invalid_argument("The block must have as many channels as the file!");
+	}
+	if (block.layout() == ChannelLayout::interleaved)
+	{
+		return write(block.data(), block.numFrames(), dither);
+	}
+
+	// Planar blocks are written chunk by chunk through an interleaved scratch buffer
+	const auto numFrames = block.numFrames();
+	ScratchScope scope(threadScratch());
+	const auto maxFrames = std::min(numFrames, chunkFrames(format_));
+	auto* chunk = threadScratch().allocate<T>(maxFrames * numChannels);
+	std::vector<const T*> channels(numChannels);
+	size_t clipped = 0;
+	for (size_t done = 0; done < numFrames; done += maxFrames)
+	{
+		const auto n = std::min(maxFrames, numFrames - done);
+		for (unsigned c = 0; c < numChannels; ++c)
+		{
+			channels[c] = block.data() + c * numFrames + done;
+		}
+		kernels::interleave(channels.data(), numChannels, chunk, n);
+		clipped += write(chunk, n, dither);
+	}
+	return clipped;
+}
+
+void dsp::io::AudioWriter::close()
+{
+	if (!file_.is_open()) return;
+
+	if (container_ != container::raw)
+	{
+		// Chunks have an even size
+		if ((numFrames_ * format_.bytesPerFrame()) % 2 != 0)
+		{
+			file_.put(0);
+		}
+		file_.seekp(0);
+		writeHeader();
+	}
+	file_.close();
+	if (file_.fail()) throw std::runtime_error("Could not write to file!");
+}
+
+void dsp::io::AudioWriter::writeHeader()
+{
+	if (container_ == container::raw) return;
+
+	// PCM16 with up to two channels is written as plain WAVE_FORMAT_PCM; everything else as WAVE_FORMAT_EXTENSIBLE. Both
+	// headers have a multiple of eight bytes, so that memory-mapped samples are aligned.
+	const bool extensible = format_.format != sample_format::pcm16 || format_.numChannels > 2;
+	const std::uint32_t fmtBytes = extensible ? 40 : 16;
+	const std::uint64_t dataBytes = static_cast<std::uint64_t>(numFrames_) * format_.bytesPerFrame();
+	const std::uint64_t riffBytes = 4 + (8 + 28) + (8 + fmtBytes) + 8 + dataBytes + (dataBytes & 1);
+	const bool rf64 = container_ == container::rf64 || riffBytes > 0xFFFFFFFF;
+
+	std::vector<char> header;
+	putId(header, rf64 ? "RF64" : "RIFF");
+	put32(header, rf64 ? 0xFFFFFFFF : static_cast<std::uint32_t>(riffBytes));
+	putId(header, "WAVE");
+
+	// A JUNK chunk reserves the space of the ds64 chunk, so that a WAV file can be turned into RF64 on closing
+	putId(header, rf64 ? "ds64" : "JUNK");
+	put32(header, 28);
+	put64(header, rf64 ? riffBytes : 0);
+	put64(header, rf64 ? dataBytes : 0);
+	put64(header, rf64 ? numFrames_ : 0);
+	put32(header, 0);
+
+	const auto bits = static_cast<std::uint16_t>(8 * bytesPerSample(format_.format));
+	const bool isFloat = format_.format == sample_format::float32 || format_.format == sample_format::float64;
+	putId(header, "fmt ");
+	put32(header, fmtBytes);
+	put16(header, extensible ? formatExtensible : formatPcm);
+	put16(header, static_cast<std::uint16_t>(format_.numChannels));
+	put32(header, format_.samplingRate_Hz);
+	put32(header, static_cast<std::uint32_t>(format_.samplingRate_Hz * format_.bytesPerFrame()));
+	put16(header, static_cast<std::uint16_t>(format_.bytesPerFrame()));
+	put16(header, bits);
+	if (extensible)
+	{
+		put16(header, 22);
+		put16(header, bits);
+		put32(header, 0);  // No speaker positions
+		// KSDATAFORMAT_SUBTYPE_PCM or KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+		put32(header, isFloat ? formatFloat : formatPcm);
+		put16(header, 0x0000);
+		put16(header, 0x0010);
+		const unsigned char guidTail[8] = { 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+		header.insert(header.end(), guidTail, guidTail + 8);
+	}
+
+	putId(header, "data");
+	put32(header, rf64 ? 0xFFFFFFFF : static_cast<std::uint32_t>(dataBytes));
+
+	file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+	if (!file_) throw std::runtime_error("Could not write to file!");
+	file_.seekp(0, std::ios::end);
+}
+
+dsp::io::MappedAudioFile::MappedAudioFile(const std::string& path)
+{
+	map(path);
+	try
+	{
+		const auto layout = parseWav([this](std::uint64_t offset, unsigned char* buffer, size_t n)
+			{
+				if (offset > mappingSize_ || n > mappingSize_ - offset) return false;
+				std::memcpy(buffer, mapping_ + offset, n);
+				return true;
+			}, mappingSize_);
+		format_ = layout.format;
+		numFrames_ = static_cast<size_t>(layout.dataBytes / format_.bytesPerFrame());
+		data_ = mapping_ + layout.dataOffset;
+	}
+	catch (...)
+	{
+		unmap();
+		throw;
+	}
+}
+
+dsp::io::MappedAudioFile::MappedAudioFile(const std::string& path, const AudioFormat& rawFormat, size_t headerBytes)
+{
+	map(path);
+	try
+	{
+		const auto layout = rawLayout(rawFormat, headerBytes, mappingSize_);
+		format_ = layout.format;
+		numFrames_ = static_cast<size_t>(layout.dataBytes / format_.bytesPerFrame());
+		data_ = mapping_ + std::min<size_t>(headerBytes, mappingSize_);
+	}
+	catch (...)
+	{
+		unmap();
+		throw;
+	}
+}
+
+dsp::io::MappedAudioFile::MappedAudioFile(MappedAudioFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+dsp::io::MappedAudioFile& dsp::io::MappedAudioFile::operator=(MappedAudioFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		unmap();
+		format_ = other.format_;
+		numFrames_ = std::exchange(other.numFrames_, 0);
+		mapping_ = std::exchange(other.mapping_, nullptr);
+		mappingSize_ = std::exchange(other.mappingSize_, 0);
+		data_ = std::exchange(other.data_, nullptr);
+#if defined(_WIN32)
+		fileHandle_ = std::exchange(other.fileHandle_, nullptr);
+		mappingHandle_ = std::exchange(other.mappingHandle_, nullptr);
+#endif
+	}
+	return *this;
+}
+
+dsp::io::MappedAudioFile::~MappedAudioFile()
+{
+	unmap();
+}
+
+template<class T>
+dsp::SignalView<T> dsp::io::MappedAudioFile::samples() const
+{
+	constexpr auto stored = std::is_same_v<T, pcm::int16> ? sample_format::pcm16
+		: std::is_same_v<T, pcm::int24> ? sample_format::pcm24
+		: std::is_same_v<T, pcm::int32> ? sample_format::pcm32
+		: std::is_same_v<T, float> ? sample_format::float32
+		: sample_format::float64;
+	if (format_.format != stored)
+	{
+		throw std::invalid_argument("The sample type does not match the format of the file!");
+	}
+	if (reinterpret_cast<std::uintptr_t>(data_) % alignof(T) != 0)
+	{
+		throw std::runtime_error("The samples in the file are not aligned for zero-copy access!");
+	}
+	return { reinterpret_cast<const T*>(data_), numFrames_ * format_.numChannels, 1, format_.samplingRate_Hz };
+}
+
+template<class T>
+dsp::SignalView<T> dsp::io::MappedAudioFile::channel(unsigned channel) const
+{
+	if (channel >= format_.numChannels)
+	{
+		throw std::out_of_range("Channel index out of range!");
+	}
+	const auto all = samples<T>();
+	return { all.data() + channel, numFrames_, static_cast<std::ptrdiff_t>(format_.numChannels), format_.samplingRate_Hz };
+}
+
+void dsp::io::MappedAudioFile::map(const std::string& path)
+{
+#if defined(_WIN32)
+	fileHandle_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle_ == INVALID_HANDLE_VALUE)
+	{
+		fileHandle_ = nullptr;
+		throw std::runtime_error("Could not open file " + path + "!");
+	}
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(fileHandle_, &size) && size.QuadPart > 0)
+	{
+		mappingHandle_ = CreateFileMappingA(fileHandle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+	if (mappingHandle_ != nullptr)
+	{
+		mapping_ = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+	}
+	if (mapping_ == nullptr)
+	{
+		unmap();
+		throw std::runtime_error("Could not map file " + path + "!");
+	}
+	mappingSize_ = static_cast<size_t>(size.QuadPart);
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw std::runtime_error("Could not open file " + path + "!");
+
+	struct stat status;
+	void* mapping = MAP_FAILED;
+	if (::fstat(fd, &status) == 0 && status.st_size > 0)
+	{
+		mapping = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	// The mapping stays valid after closing the file descriptor
+	::close(fd);
+	if (mapping == MAP_FAILED) throw std::runtime_error("Could not map file " + path + "!");
+
+	mapping_ = static_cast<const unsigned char*>(mapping);
+	mappingSize_ = static_cast<size_t>(status.st_size);
+#endif
+}
+
+void dsp::io::MappedAudioFile::unmap()
+{
+#if defined(_WIN32)
+	if (mapping_ != nullptr) UnmapViewOfFile(mapping_);
+	if (mappingHandle_ != nullptr) CloseHandle(mappingHandle_);
+	if (fileHandle_ != nullptr) CloseHandle(fileHandle_);
+	mappingHandle_ = nullptr;
+	fileHandle_ = nullptr;
+#else
+	if (mapping_ != nullptr) ::munmap(const_cast<unsigned char*>(mapping_), mappingSize_);
+#endif
+	mapping_ = nullptr;
+	mappingSize_ = 0;
+	data_ = nullptr;
+}
+
+// Explicit template instantiation
+template size_t dsp::io::AudioReader::read(float* interleaved, size_t numFrames);
+template size_t dsp::io::AudioReader::read(double* interleaved, size_t numFrames);
+template size_t dsp::io::AudioReader::read(MultiSignal<float>& block);
+template size_t dsp::io::AudioReader::read(MultiSignal<double>& block);
+template dsp::MultiSignal<float> dsp::io::AudioReader::readAll(ChannelLayout layout);
+template dsp::MultiSignal<double> dsp::io::AudioReader::readAll(ChannelLayout layout);
+
+template size_t dsp::io::AudioWriter::write(const float* interleaved, size_t numFrames, pcm::Dither* dither);
+template size_t dsp::io::AudioWriter::write(const double* interleaved, size_t numFrames, pcm::Dither* dither);
+template size_t dsp::io::AudioWriter::write(const MultiSignal<float>& block, pcm::Dither* dither);
+template size_t dsp::io::AudioWriter::write(const MultiSignal<double>& block, pcm::Dither* dither);
+
+template dsp::SignalView<dsp::pcm::int16> dsp::io::MappedAudioFile::samples() const;
+template dsp::SignalView<dsp::pcm::int24> dsp::io::MappedAudioFile::samples() const;
+template dsp::SignalView<dsp::pcm::int32> dsp::io::MappedAudioFile::samples() const;
+template dsp::SignalView<float> dsp::io::MappedAudioFile::samples() const;
+template dsp::SignalView<double> dsp::io::MappedAudioFile::samples() const;
+
+template dsp::SignalView<dsp::pcm::int16> dsp::io::MappedAudioFile::channel(unsigned channel) const;
+template dsp::SignalView<dsp::pcm::int24> dsp::io::MappedAudioFile::channel(unsigned channel) const;
+template dsp::SignalView<dsp::pcm::int32> dsp::io::MappedAudioFile::channel(unsigned channel) const;
+template dsp::SignalView<float> dsp::io::MappedAudioFile::channel(unsigned channel) const;
+template dsp::SignalView<double> dsp::io::MappedAudioFile::channel(unsigned channel) const;
@@ -0,0 +1,700 @@
+#include "kernels.h"
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+
+#include "allocators.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DSP_KERNELS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DSP_KERNELS_SSE2
+#endif
+
+namespace
+{
+	// SIMD register traits. Only specialized for the types (and instruction sets) that have a vector unit.
+	template<class T>
+	struct Simd;
+
+#if defined(DSP_KERNELS_AVX)
+	template<>
+	struct Simd<float>
+	{
+		using reg = __m256;
+		static constexpr size_t width = 8;
+		static reg load(const float* p) { return _mm256_loadu_ps(p); }
+		static void store(float* p, reg r) { _mm256_storeu_ps(p, r); }
+		static reg loadAligned(const float* p) { return _mm256_load_ps(p); }
+		static void storeAligned(float* p, reg r) { _mm256_store_ps(p, r); }
+		static reg broadcast(float value) { return _mm256_set1_ps(value); }
+		static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+		static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+		static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+		static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+		// {a0, b0, a1, b1, ...} from {a0, a1, ...} and {b0, b1, ...}
+		static void zip(reg a, reg b, reg& lo, reg& hi)
+		{
+			const auto l = _mm256_unpacklo_ps(a, b);
+			const auto h = _mm256_unpackhi_ps(a, b);
+			lo = _mm256_permute2f128_ps(l, h, 0x20);
+			hi = _mm256_permute2f128_ps(l, h, 0x31);
+		}
+		// Inverse of zip()
+		static void unzip(reg lo, reg hi, reg& a, reg& b)
+		{
+			const auto l = _mm256_permute2f128_ps(lo, hi, 0x20);
+			const auto h = _mm256_permute2f128_ps(lo, hi, 0x31);
+			a = _mm256_shuffle_ps(l, h, _MM_SHUFFLE(2, 0, 2, 0));
+			b = _mm256_shuffle_ps(l, h, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+	};
+
+	template<>
+	struct Simd<double>
+	{
+		using reg = __m256d;
+		static constexpr size_t width = 4;
+		static reg load(const double* p) { return _mm256_loadu_pd(p); }
+		static void store(double* p, reg r) { _mm256_storeu_pd(p, r); }
+		static reg loadAligned(const double* p) { return _mm256_load_pd(p); }
+		static void storeAligned(double* p, reg r) { _mm256_store_pd(p, r); }
+		static reg broadcast(double value) { return _mm256_set1_pd(value); }
+		static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+		static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+		static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+		static void zip(reg a, reg b, reg& lo, reg& hi)
+		{
+			const auto l = _mm256_unpacklo_pd(a, b);
+			const auto h = _mm256_unpackhi_pd(a, b);
+			lo = _mm256_permute2f128_pd(l, h, 0x20);
+			hi = _mm256_permute2f128_pd(l, h, 0x31);
+		}
+		static void unzip(reg lo, reg hi, reg& a, reg& b)
+		{
+			const auto l = _mm256_permute2f128_pd(lo, hi, 0x20);
+			const auto h = _mm256_permute2f128_pd(lo, hi, 0x31);
+			a = _mm256_unpacklo_pd(l, h);
+			b = _mm256_unpackhi_pd(l, h);
+		}
+	};
+#elif defined(DSP_KERNELS_SSE2)
+	template<>
+	struct Simd<float>
+	{
+		using reg = __m128;
+		static constexpr size_t width = 4;
+		static reg load(const float* p) { return _mm_loadu_ps(p); }
+		static void store(float* p, reg r) { _mm_storeu_ps(p, r); }
+		static reg loadAligned(const float* p) { return _mm_load_ps(p); }
+		static void storeAligned(float* p, reg r) { _mm_store_ps(p, r); }
+		static reg broadcast(float value) { return _mm_set1_ps(value); }
+		static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+		static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+		static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+		static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+		// {a0, b0, a1, b1, ...} from {a0, a1, ...} and {b0, b1, ...}
+		static void zip(reg a, reg b, reg& lo, reg& hi)
+		{
+			lo = _mm_unpacklo_ps(a, b);
+			hi = _mm_unpackhi_ps(a, b);
+		}
+		// Inverse of zip()
+		static void unzip(reg lo, reg hi, reg& a, reg& b)
+		{
+			a = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+			b = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+	};
+
+	template<>
+	struct Simd<double>
+	{
+		using reg = __m128d;
+		static constexpr size_t width = 2;
+		static reg load(const double* p) { return _mm_loadu_pd(p); }
+		static void store(double* p, reg r) { _mm_storeu_pd(p, r); }
+		static reg loadAligned(const double* p) { return _mm_load_pd(p); }
+		static void storeAligned(double* p, reg r) { _mm_store_pd(p, r); }
+		static reg broadcast(double value) { return _mm_set1_pd(value); }
+		static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+		static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+		static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+		static void zip(reg a, reg b, reg& lo, reg& hi)
+		{
+			lo = _mm_unpacklo_pd(a, b);
+			hi = _mm_unpackhi_pd(a, b);
+		}
+		static void unzip(reg lo, reg hi, reg& a, reg& b)
+		{
+			a = _mm_unpacklo_pd(lo, hi);
+			b = _mm_unpackhi_pd(lo, hi);
+		}
+	};
+#endif
+
+	template<class T, class = void>
+	struct has_simd : std::false_type {};
+
+	template<class T>
+	struct has_simd<T, std::void_t<decltype(Simd<T>::width)>> : std::true_type {};
+
+	// The four arithmetic operations, both for scalars and for SIMD registers
+	struct Plus
+	{
+		template<class T> static T apply(const T& a, const T& b) { return a + b; }
+		template<class S, class R> static R simd(R a, R b) { return S::add(a, b); }
+	};
+
+	struct Minus
+	{
+		template<class T> static T apply(const T& a, const T& b) { return a - b; }
+		template<class S, class R> static R simd(R a, R b) { return S::sub(a, b); }
+	};
+
+	struct Multiplies
+	{
+		template<class T> static T apply(const T& a, const T& b) { return a * b; }
+		template<class S, class R> static R simd(R a, R b) { return S::mul(a, b); }
+	};
+
+	struct Divides
+	{
+		template<class T> static T apply(const T& a, const T& b) { return a / b; }
+		template<class S, class R> static R simd(R a, R b) { return S::div(a, b); }
+	};
+
+	// Loads and stores, aligned or unaligned
+	template<class S, bool Aligned>
+	struct Memory
+	{
+		template<class T>
+		static auto load(const T* p)
+		{
+			if constexpr (Aligned) { return S::loadAligned(p); }
+			else { return S::load(p); }
+		}
+
+		template<class T, class R>
+		static void store(T* p, R r)
+		{
+			if constexpr (Aligned) { S::storeAligned(p, r); }
+			else { S::store(p, r); }
+		}
+	};
+
+	// Returns true if all pointers are aligned to the register width of S
+	template<class S, class... Pointers>
+	bool registerAligned(const Pointers*... p)
+	{
+		return (dsp::isAligned(p, sizeof(typename S::reg)) && ...);
+	}
+
+	// Vectorized part of elementwise(). Returns the number of processed elements.
+	template<class Op, bool Aligned, class T>
+	size_t elementwiseSimd(T* x, const T* y, size_t n)
+	{
+		using S = Simd<T>;
+		using M = Memory<S, Aligned>;
+		size_t i = 0;
+		// Two independent registers per iteration hide the latency of the arithmetic units
+		for (; i + 2 * S::width <= n; i += 2 * S::width)
+		{
+			auto a0 = M::load(x + i);
+			auto a1 = M::load(x + i + S::width);
+			auto b0 = M::load(y + i);
+			auto b1 = M::load(y + i + S::width);
+			M::store(x + i, Op::template simd<S>(a0, b0));
+			M::store(x + i + S::width, Op::template simd<S>(a1, b1));
+		}
+		return i;
+	}
+
+	// x[i] = op(x[i], y[i])
+	template<class Op, class T>
+	void elementwise(T* x, const T* y, size_t n)
+	{
+		size_t i = 0;
+		if constexpr (has_simd<T>::value)
+		{
+			// Buffers from AlignedAllocator or MemoryPool take the aligned path
+			i = registerAligned<Simd<T>>(x, y) ? elementwiseSimd<Op, true>(x, y, n) : elementwiseSimd<Op, false>(x, y, n);
+		}
+		else
+		{
+			for (; i + 4 <= n; i += 4)
+			{
+				x[i] = Op::apply(x[i], y[i]);
+				x[i + 1] = Op::apply(x[i + 1], y[i + 1]);
+				x[i + 2] = Op::apply(x[i + 2], y[i + 2]);
+				x[i + 3] = Op::apply(x[i + 3], y[i + 3]);
+			}
+		}
+		for (; i < n; ++i)
+		{
+			x[i] = Op::apply(x[i], y[i]);
+		}
+	}
+
+	// Vectorized part of broadcast(). Returns the number of processed elements.
+	template<class Op, bool Aligned, class T>
+	size_t broadcastSimd(T* x, const T& value, size_t n)
+	{
+		using S = Simd<T>;
+		using M = Memory<S, Aligned>;
+		const auto v = S::broadcast(value);
+		size_t i = 0;
+		for (; i + 2 * S::width <= n; i += 2 * S::width)
+		{
+			auto a0 = M::load(x + i);
+			auto a1 = M::load(x + i + S::width);
+			M::store(x + i, Op::template simd<S>(a0, v));
+			M::store(x + i + S::width, Op::template simd<S>(a1, v));
+		}
+		return i;
+	}
+
+	// x[i] = op(x[i], value)
+	template<class Op, class T>
+	void broadcast(T* x, const T& value, size_t n)
+	{
+		// Copy the value before the first write, since it may refer to an element of x (e.g., s *= s[0])
+		const T v = value;
+		size_t i = 0;
+		if constexpr (has_simd<T>::value)
+		{
+			i = registerAligned<Simd<T>>(x) ? broadcastSimd<Op, true>(x, v, n) : broadcastSimd<Op, false>(x, v, n);
+		}
+		else
+		{
+			for (; i + 4 <= n; i += 4)
+			{
+				x[i] = Op::apply(x[i], v);
+				x[i + 1] = Op::apply(x[i + 1], v);
+				x[i + 2] = Op::apply(x[i + 2], v);
+				x[i + 3] = Op::apply(x[i + 3], v);
+			}
+		}
+		for (; i < n; ++i)
+		{
+			x[i] = Op::apply(x[i], v);
+		}
+	}
+
+	// Number of frames that interleave() and deinterleave() convert at once, so that the reads and writes of all channels
+	// stay in the cache
+	constexpr size_t interleaveBlockSize = 256;
+
+	// Vectorized stereo interleave. Returns the number of processed frames.
+	template<class T>
+	size_t interleaveStereoSimd(const T* left, const T* right, T* out, size_t n)
+	{
+		using S = Simd<T>;
+		size_t i = 0;
+		for (; i + S::width <= n; i += S::width)
+		{
+			typename S::reg lo, hi;
+			S::zip(S::load(left + i), S::load(right + i), lo, hi);
+			S::store(out + 2 * i, lo);
+			S::store(out + 2 * i + S::width, hi);
+		}
+		return i;
+	}
+
+	// Vectorized stereo deinterleave. Returns the number of processed frames.
+	template<class T>
+	size_t deinterleaveStereoSimd(const T* in, T* left, T* right, size_t n)
+	{
+		using S = Simd<T>;
+		size_t i = 0;
+		for (; i + S::width <= n; i += S::width)
+		{
+			typename S::reg a, b;
+			S::unzip(S::load(in + 2 * i), S::load(in + 2 * i + S::width), a, b);
+			S::store(left + i, a);
+			S::store(right + i, b);
+		}
+		return i;
+	}
+
+	// Vectorized part of multiplyAdd(). Returns the number of processed elements.
+	template<bool Aligned, class T>
+	size_t multiplyAddSimd(T* y, const T* x, const T& a, size_t n)
+	{
+		using S = Simd<T>;
+		using M = Memory<S, Aligned>;
+		const auto v = S::broadcast(a);
+		size_t i = 0;
+		for (; i + 2 * S::width <= n; i += 2 * S::width)
+		{
+			auto y0 = M::load(y + i);
+			auto y1 = M::load(y + i + S::width);
+			auto x0 = M::load(x + i);
+			auto x1 = M::load(x + i + S::width);
+			M::store(y + i, S::add(y0, S::mul(v, x0)));
+			M::store(y + i + S::width, S::add(y1, S::mul(v, x1)));
+		}
+		return i;
+	}
+
+	// The maps of the reduction kernels, both for scalars and for SIMD registers
+	struct Identity
+	{
+		template<class T> static T apply(const T& x) { return x; }
+		template<class S, class R> static R simd(R x) { return x; }
+	};
+
+	struct Square
+	{
+		template<class T> static T apply(const T& x) { return x * x; }
+		template<class S, class R> static R simd(R x) { return S::mul(x, x); }
+	};
+
+	// Pairwise summation sums blocks of at most this many samples naively
+	constexpr size_t pairwiseBlockSize = 256;
+
+	// Returns the sum of the lanes of a register
+	template<class S, class T>
+	T horizontalSum(typename S::reg r)
+	{
+		T lanes[S::width];
+		S::store(lanes, r);
+		T sum = 0;
+		for (size_t l = 0; l < S::width; ++l)
+		{
+			sum += lanes[l];
+		}
+		return sum;
+	}
+
+	// Sum of map(x[i]) with two running sums per SIMD lane
+	template<class Map, class T>
+	T naiveSum(const T* x, size_t n)
+	{
+		size_t i = 0;
+		T sum = 0;
+		if constexpr (has_simd<T>::value)
+		{
+			using S = Simd<T>;
+			auto s0 = S::broadcast(T(0));
+			auto s1 = s0;
+			for (; i + 2 * S::width <= n; i += 2 * S::width)
+			{
+				s0 = S::add(s0, Map::template simd<S>(S::load(x + i)));
+				s1 = S::add(s1, Map::template simd<S>(S::load(x + i + S::width)));
+			}
+			sum = horizontalSum<S, T>(S::add(s0, s1));
+		}
+		for (; i < n; ++i)
+		{
+			sum += Map::apply(x[i]);
+		}
+		return sum;
+	}
+
+	template<class Map, class T>
+	T pairwiseSum(const T* x, size_t n)
+	{
+		if (n <= pairwiseBlockSize) return naiveSum<Map>(x, n);
+
+		// Split at a multiple of the block size, so that all leaves but the last are full blocks
+		const auto half = (n / 2 + pairwiseBlockSize - 1) / pairwiseBlockSize * pairwiseBlockSize;
+		return pairwiseSum<Map>(x, half) + pairwiseSum<Map>(x + half, n - half);
+	}
+
+	// Kahan summation of map(x[i]) with one compensated running sum per SIMD lane
+	template<class Map, class T>
+	T kahanSum(const T* x, size_t n)
+	{
+		T sum = 0;
+		T compensation = 0;
+		const auto add = [&](T value)
+		{
+			const T y = value - compensation;
+			const T t = sum + y;
+			compensation = (t - sum) - y;
+			sum = t;
+		};
+
+		size_t i = 0;
+		if constexpr (has_simd<T>::value)
+		{
+			using S = Simd<T>;
+			auto s = S::broadcast(T(0));
+			auto c = s;
+			for (; i + S::width <= n; i += S::width)
+			{
+				const auto y = S::sub(Map::template simd<S>(S::load(x + i)), c);
+				const auto t = S::add(s, y);
+				c = S::sub(S::sub(t, s), y);
+				s = t;
+			}
+
+			// Each lane holds s - c
+			T sums[S::width];
+			T compensations[S::width];
+			S::store(sums, s);
+			S::store(compensations, c);
+			for (size_t l = 0; l < S::width; ++l)
+			{
+				add(sums[l]);
+				add(-compensations[l]);
+			}
+		}
+		for (; i < n; ++i)
+		{
+			add(Map::apply(x[i]));
+		}
+		return sum;
+	}
+
+	// Sum of map(x[i]) of float samples, converted to double before they are mapped
+	template<class Map>
+	double widenedSum(const float* x, size_t n)
+	{
+		size_t i = 0;
+		double sum = 0;
+#if defined(DSP_KERNELS_AVX) || defined(DSP_KERNELS_SSE2)
+		using S = Simd<double>;
+		auto s0 = S::broadcast(0.0);
+		auto s1 = s0;
+#if defined(DSP_KERNELS_AVX)
+		for (; i + 8 <= n; i += 8)
+		{
+			s0 = S::add(s0, Map::template simd<S>(_mm256_cvtps_pd(_mm_loadu_ps(x + i))));
+			s1 = S::add(s1, Map::template simd<S>(_mm256_cvtps_pd(_mm_loadu_ps(x + i + 4))));
+		}
+#else
+		for (; i + 4 <= n; i += 4)
+		{
+			const auto v = _mm_loadu_ps(x + i);
+			s0 = S::add(s0, Map::template simd<S>(_mm_cvtps_pd(v)));
+			s1 = S::add(s1, Map::template simd<S>(_mm_cvtps_pd(_mm_movehl_ps(v, v))));
+		}
+#endif
+		sum = horizontalSum<S, double>(S::add(s0, s1));
+#endif
+		for (; i < n; ++i)
+		{
+			sum += Map::apply(static_cast<double>(x[i]));
+		}
+		return sum;
+	}
+
+	template<class Map, class T>
+	dsp::kernels::accumulator_t<T> reduce(const T* x, size_t n, dsp::kernels::summation_method method)
+	{
+		using dsp::kernels::summation_method;
+		switch (method)
+		{
+		case summation_method::naive:
+			return naiveSum<Map>(x, n);
+		case summation_method::pairwise:
+			return pairwiseSum<Map>(x, n);
+		case summation_method::widened:
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return widenedSum<Map>(x, n);
+			}
+			else
+			{
+				return kahanSum<Map>(x, n);
+			}
+		default:
+			return kahanSum<Map>(x, n);
+		}
+	}
+}
+
+template<class T>
+void dsp::kernels::plus(T* x, const T* y, size_t n)
+{
+	elementwise<Plus>(x, y, n);
+}
+
+template<class T>
+void dsp::kernels::plus(T* x, const T& value, size_t n)
+{
+	broadcast<Plus>(x, value, n);
+}
+
+template<class T>
+void dsp::kernels::minus(T* x, const T* y, size_t n)
+{
+	elementwise<Minus>(x, y, n);
+}
+
+template<class T>
+void dsp::kernels::minus(T* x, const T& value, size_t n)
+{
+	broadcast<Minus>(x, value, n);
+}
+
+template<class T>
+void dsp::kernels::multiplies(T* x, const T* y, size_t n)
+{
+	elementwise<Multiplies>(x, y, n);
+}
+
+template<class T>
+void dsp::kernels::multiplies(T* x, const T& value, size_t n)
+{
+	broadcast<Multiplies>(x, value, n);
+}
+
+template<class T>
+void dsp::kernels::divides(T* x, const T* y, size_t n)
+{
+	elementwise<Divides>(x, y, n);
+}
+
+template<class T>
+void dsp::kernels::divides(T* x, const T& value, size_t n)
+{
+	broadcast<Divides>(x, value, n);
+}
+
+template<class T>
+void dsp::kernels::multiplyAdd(T* y, const T* x, const T& a, size_t n)
+{
+	// Copy the factor before the first write, since it may refer to an element of y
+	const T v = a;
+	size_t i = 0;
+	if constexpr (has_simd<T>::value)
+	{
+		i = registerAligned<Simd<T>>(y, x) ? multiplyAddSimd<true>(y, x, v, n) : multiplyAddSimd<false>(y, x, v, n);
+	}
+	else
+	{
+		for (; i + 4 <= n; i += 4)
+		{
+			y[i] += v * x[i];
+			y[i + 1] += v * x[i + 1];
+			y[i + 2] += v * x[i + 2];
+			y[i + 3] += v * x[i + 3];
+		}
+	}
+	for (; i < n; ++i)
+	{
+		y[i] += v * x[i];
+	}
+}
+
+template<class T>
+void dsp::kernels::interleave(const T* const* channels, size_t numChannels, T* out, size_t n)
+{
+	size_t i = 0;
+	if constexpr (has_simd<T>::value)
+	{
+		if (numChannels == 2)
+		{
+			i = interleaveStereoSimd(channels[0], channels[1], out, n);
+		}
+	}
+	for (; i < n; i += interleaveBlockSize)
+	{
+		const auto blockEnd = std::min(n, i + interleaveBlockSize);
+		for (size_t c = 0; c < numChannels; ++c)
+		{
+			const T* channel = channels[c];
+			for (size_t j = i; j < blockEnd; ++j)
+			{
+				out[j * numChannels + c] = channel[j];
+			}
+		}
+	}
+}
+
+template<class T>
+void dsp::kernels::deinterleave(const T* in, size_t numChannels, T* const* channels, size_t n)
+{
+	size_t i = 0;
+	if constexpr (has_simd<T>::value)
+	{
+		if (numChannels == 2)
+		{
+			i = deinterleaveStereoSimd(in, channels[0], channels[1], n);
+		}
+	}
+	for (; i < n; i += interleaveBlockSize)
+	{
+		const auto blockEnd = std::min(n, i + interleaveBlockSize);
+		for (size_t c = 0; c < numChannels; ++c)
+		{
+			T* channel = channels[c];
+			for (size_t j = i; j < blockEnd; ++j)
+			{
+				channel[j] = in[j * numChannels + c];
+			}
+		}
+	}
+}
+
+template<class T>
+dsp::kernels::accumulator_t<T> dsp::kernels::sum(const T* x, size_t n, summation_method method)
+{
+	return reduce<Identity>(x, n, method);
+}
+
+template<class T>
+dsp::kernels::accumulator_t<T> dsp::kernels::sumOfSquares(const T* x, size_t n, summation_method method)
+{
+	return reduce<Square>(x, n, method);
+}
+
+const char* dsp::kernels::instructionSet()
+{
+#if defined(DSP_KERNELS_AVX)
+	return "AVX";
+#elif defined(DSP_KERNELS_SSE2)
+	return "SSE2";
+#else
+	return "none";
+#endif
+}
+
+// Explicit instantiations for all sample types of Signal
+#define DSP_INSTANTIATE_KERNELS(T) \
+	template void dsp::kernels::plus(T* x, const T* y, size_t n); \
+	template void dsp::kernels::plus(T* x, const T& value, size_t n); \
+	template void dsp::kernels::minus(T* x, const T* y, size_t n); \
+	template void dsp::kernels::minus(T* x, const T& value, size_t n); \
+	template void dsp::kernels::multiplies(T* x, const T* y, size_t n); \
+	template void dsp::kernels::multiplies(T* x, const T& value, size_t n); \
+	template void dsp::kernels::divides(T* x, const T* y, size_t n); \
+	template void dsp::kernels::divides(T* x, const T& value, size_t n); \
+	template void dsp::kernels::multiplyAdd(T* y, const T* x, const T& a, size_t n); \
+	template void dsp::kernels::interleave(const T* const* channels, size_t numChannels, T* out, size_t n); \
+	template void dsp::kernels::deinterleave(const T* in, size_t numChannels, T* const* channels, size_t n);
+
+DSP_INSTANTIATE_KERNELS(short int)
+DSP_INSTANTIATE_KERNELS(unsigned short int)
+DSP_INSTANTIATE_KERNELS(int)
+DSP_INSTANTIATE_KERNELS(unsigned int)
+DSP_INSTANTIATE_KERNELS(long int)
+DSP_INSTANTIATE_KERNELS(unsigned long int)
+DSP_INSTANTIATE_KERNELS(long long int)
+DSP_INSTANTIATE_KERNELS(unsigned long long int)
+DSP_INSTANTIATE_KERNELS(float)
+DSP_INSTANTIATE_KERNELS(std::complex<float>)
+DSP_INSTANTIATE_KERNELS(double)
+DSP_INSTANTIATE_KERNELS(std::complex<double>)
+DSP_INSTANTIATE_KERNELS(long double)
+DSP_INSTANTIATE_KERNELS(std::complex<long double>)
+
+#undef DSP_INSTANTIATE_KERNELS
+
+#define DSP_INSTANTIATE_REDUCTIONS(T) \
+	template dsp::kernels::accumulator_t<T> dsp::kernels::sum(const T* x, size_t n, summation_method method); \
+	template dsp::kernels::accumulator_t<T> dsp::kernels::sumOfSquares(const T* x, size_t n, summation_method method);
+
+DSP_INSTANTIATE_REDUCTIONS(float)
+DSP_INSTANTIATE_REDUCTIONS(double)
+DSP_INSTANTIATE_REDUCTIONS(long double)
+
+#undef DSP_INSTANTIATE_REDUCTIONS
@@ -0,0 +1,272 @@
+#include "pcm.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DSP_PCM_SSE2
+#endif
+
+namespace
+{
+	using dsp::pcm::int16;
+	using dsp::pcm::int24;
+	using dsp::pcm::int32;
+	using dsp::pcm::traits;
+
+	// Scale factor from PCM to floating point
+	template<class T, class P>
+	constexpr T decodeScale()
+	{
+		return static_cast<T>(1.0 / static_cast<double>(1LL << (traits<P>::bits - 1)));
+	}
+
+	// Scale factor from floating point to PCM
+	template<class T, class P>
+	constexpr T encodeScale()
+	{
+		return static_cast<T>(static_cast<double>(1LL << (traits<P>::bits - 1)));
+	}
+
+	// Scales, dithers, rounds, and saturates one sample. Clipping is tracked in double precision, so that it also works
+	// for int32, whose limits are not representable as float.
+	template<class P, class T>
+	P encodeSample(T x, double noise, size_t& clipped)
+	{
+		const double scaled = static_cast<double>(x) * encodeScale<double, P>() + noise;
+		if (scaled >= static_cast<double>(traits<P>::max))
+		{
+			clipped += scaled >= static_cast<double>(traits<P>::max) + 0.5;
+			return P(traits<P>::max);
+		}
+		if (scaled <= static_cast<double>(traits<P>::min))
+		{
+			clipped += scaled < static_cast<double>(traits<P>::min) - 0.5;
+			return P(traits<P>::min);
+		}
+		return P(static_cast<std::int32_t>(std::lrint(scaled)));
+	}
+
+#if defined(DSP_PCM_SSE2)
+	// Number of set bits in a four-bit movemask
+	constexpr unsigned char popcount4[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+	// Sign-extends eight int16 samples to two registers of four int32 each
+	inline void widen(__m128i x, __m128i& lo, __m128i& hi)
+	{
+		lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+		hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+	}
+
+	// Vectorized part of decode(). Returns the number of processed samples.
+	size_t decodeSimd(const int16* in, float* out, size_t n)
+	{
+		const auto scale = _mm_set1_ps(decodeScale<float, int16>());
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			__m128i lo, hi;
+			widen(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), lo, hi);
+			_mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+			_mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+		}
+		return i;
+	}
+
+	size_t decodeSimd(const int16* in, double* out, size_t n)
+	{
+		const auto scale = _mm_set1_pd(decodeScale<double, int16>());
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			__m128i lo, hi;
+			widen(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), lo, hi);
+			_mm_storeu_pd(out + i, _mm_mul_pd(_mm_cvtepi32_pd(lo), scale));
+			_mm_storeu_pd(out + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(lo, 8)), scale));
+			_mm_storeu_pd(out + i + 4, _mm_mul_pd(_mm_cvtepi32_pd(hi), scale));
+			_mm_storeu_pd(out + i + 6, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(hi, 8)), scale));
+		}
+		return i;
+	}
+
+	size_t decodeSimd(const int32* in, float* out, size_t n)
+	{
+		const auto scale = _mm_set1_ps(decodeScale<float, int32>());
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			_mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(x), scale));
+		}
+		return i;
+	}
+
+	size_t decodeSimd(const int32* in, double* out, size_t n)
+	{
+		const auto scale = _mm_set1_pd(decodeScale<double, int32>());
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			_mm_storeu_pd(out + i, _mm_mul_pd(_mm_cvtepi32_pd(x), scale));
+			_mm_storeu_pd(out + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(x, 8)), scale));
+		}
+		return i;
+	}
+
+	// Scales and clamps four floats to the int16 range and counts the clipped ones
+	inline __m128i encode4(__m128 x, __m128 scale, size_t& clipped)
+	{
+		const auto upper = _mm_set1_ps(32767.0f);
+		const auto lower = _mm_set1_ps(-32768.0f);
+		const auto scaled = _mm_mul_ps(x, scale);
+		const auto outside = _mm_or_ps(_mm_cmpge_ps(scaled, _mm_set1_ps(32767.5f)), _mm_cmplt_ps(scaled, _mm_set1_ps(-32768.5f)));
+		clipped += popcount4[_mm_movemask_ps(outside)];
+		return _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(scaled, upper), lower));
+	}
+
+	// Vectorized part of encode() without dither. Returns the number of processed samples.
+	size_t encodeSimd(const float* in, int16* out, size_t n, size_t& clipped)
+	{
+		const auto scale = _mm_set1_ps(encodeScale<float, int16>());
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto lo = encode4(_mm_loadu_ps(in + i), scale, clipped);
+			const auto hi = encode4(_mm_loadu_ps(in + i + 4), scale, clipped);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+		}
+		return i;
+	}
+
+	// Scales and clamps two doubles to the range of P (int16 or int32) and counts the clipped ones. The results are in
+	// the lower half. Both limits of int32 are exact in double precision.
+	template<class P>
+	inline __m128i encode2(__m128d x, __m128d scale, size_t& clipped)
+	{
+		const auto upper = _mm_set1_pd(static_cast<double>(traits<P>::max));
+		const auto lower = _mm_set1_pd(static_cast<double>(traits<P>::min));
+		const auto scaled = _mm_mul_pd(x, scale);
+		const auto outside = _mm_or_pd(_mm_cmpge_pd(scaled, _mm_add_pd(upper, _mm_set1_pd(0.5))),
+			_mm_cmplt_pd(scaled, _mm_sub_pd(lower, _mm_set1_pd(0.5))));
+		clipped += popcount4[_mm_movemask_pd(outside)];
+		return _mm_cvtpd_epi32(_mm_max_pd(_mm_min_pd(scaled, upper), lower));
+	}
+
+	size_t encodeSimd(const double* in, int16* out, size_t n, size_t& clipped)
+	{
+		const auto scale = _mm_set1_pd(encodeScale<double, int16>());
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto lo = _mm_unpacklo_epi64(encode2<int16>(_mm_loadu_pd(in + i), scale, clipped), encode2<int16>(_mm_loadu_pd(in + i + 2), scale, clipped));
+			const auto hi = _mm_unpacklo_epi64(encode2<int16>(_mm_loadu_pd(in + i + 4), scale, clipped), encode2<int16>(_mm_loadu_pd(in + i + 6), scale, clipped));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+		}
+		return i;
+	}
+
+	// Floats are widened to double before scaling to int32, like encodeSample() does
+	size_t encodeSimd(const float* in, int32* out, size_t n, size_t& clipped)
+	{
+		const auto scale = _mm_set1_pd(encodeScale<double, int32>());
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const auto x = _mm_loadu_ps(in + i);
+			const auto lo = encode2<int32>(_mm_cvtps_pd(x), scale, clipped);
+			const auto hi = encode2<int32>(_mm_cvtps_pd(_mm_movehl_ps(x, x)), scale, clipped);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi64(lo, hi));
+		}
+		return i;
+	}
+
+	size_t encodeSimd(const double* in, int32* out, size_t n, size_t& clipped)
+	{
+		const auto scale = _mm_set1_pd(encodeScale<double, int32>());
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const auto lo = encode2<int32>(_mm_loadu_pd(in + i), scale, clipped);
+			const auto hi = encode2<int32>(_mm_loadu_pd(in + i + 2), scale, clipped);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi64(lo, hi));
+		}
+		return i;
+	}
+#endif
+
+	template<class T, class P>
+	size_t decodeVectorized(const P* in, T* out, size_t n)
+	{
+#if defined(DSP_PCM_SSE2)
+		if constexpr (!std::is_same_v<P, int24> && !std::is_same_v<T, long double>)
+		{
+			return decodeSimd(in, out, n);
+		}
+#endif
+		return 0;
+	}
+
+	template<class T, class P>
+	size_t encodeVectorized(const T* in, P* out, size_t n, size_t& clipped)
+	{
+#if defined(DSP_PCM_SSE2)
+		if constexpr ((std::is_same_v<P, int16> || std::is_same_v<P, int32>) && !std::is_same_v<T, long double>)
+		{
+			return encodeSimd(in, out, n, clipped);
+		}
+#endif
+		return 0;
+	}
+}
+
+template<class T, class P>
+void dsp::pcm::decode(const P* in, T* out, size_t n)
+{
+	size_t i = decodeVectorized(in, out, n);
+	for (; i < n; ++i)
+	{
+		out[i] = toFloat<T>(in[i]);
+	}
+}
+
+template<class T, class P>
+size_t dsp::pcm::encode(const T* in, P* out, size_t n, Dither* dither)
+{
+	size_t clipped = 0;
+	size_t i = 0;
+	if (dither == nullptr || dither->type() == dither_type::none)
+	{
+		i = encodeVectorized(in, out, n, clipped);
+		for (; i < n; ++i)
+		{
+			out[i] = encodeSample<P>(in[i], 0.0, clipped);
+		}
+	}
+	else
+	{
+		for (; i < n; ++i)
+		{
+			out[i] = encodeSample<P>(in[i], dither->next(), clipped);
+		}
+	}
+	return clipped;
+}
+
+// Explicit template instantiation
+#define DSP_INSTANTIATE_PCM(T, P) \
+	template void dsp::pcm::decode(const P* in, T* out, size_t n); \
+	template size_t dsp::pcm::encode(const T* in, P* out, size_t n, Dither* dither);
+
+DSP_INSTANTIATE_PCM(float, int16)
+DSP_INSTANTIATE_PCM(float, int24)
+DSP_INSTANTIATE_PCM(float, int32)
+DSP_INSTANTIATE_PCM(double, int16)
+DSP_INSTANTIATE_PCM(double, int24)
+DSP_INSTANTIATE_PCM(double, int32)
+DSP_INSTANTIATE_PCM(long double, int16)
+DSP_INSTANTIATE_PCM(long double, int24)
+DSP_INSTANTIATE_PCM(long double, int32)
+
+#undef DSP_INSTANTIATE_PCM
@@ -0,0 +1,301 @@
+#include "resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+#include "filter.h"
+
+namespace dsp::resample
+{
+	/// @cond developer-only
+	template<class T>
+	struct FilterBankCache
+	{
+		using Key = std::tuple<unsigned, unsigned, window::type, std::vector<T>>;
+
+		std::mutex mutex;
+		std::map<Key, std::shared_ptr<const PolyphaseFilterBank<T>>> banks;
+
+		static FilterBankCache& instance()
+		{
+			static FilterBankCache cache;
+			return cache;
+		}
+	};
+
+	// Computes the output samples [first, first + count) of the polyphase filter for the input x[0, N), which is zero outside.
+	template<class T>
+	void polyphase(const PolyphaseFilterBank<T>& bank, const T* x, size_t N, size_t first, size_t count, T* y)
+	{
+		const auto L = bank.phaseLength;
+		size_t t = first * bank.down;
+		size_t i = t / bank.up;
+		size_t p = t % bank.up;
+		for (size_t n = 0; n < count; ++n)
+		{
+			const T* taps = bank.taps.data() + p * L;
+			T sum = 0;
+			if (i + 1 >= L && i < N)
+			{
+				const T* xi = x + (i + 1 - L);
+				for (size_t k = 0; k < L; ++k) { sum += taps[k] * xi[k]; }
+			}
+			else
+			{
+				// Partial overlap at the edges: x[i - L + 1 + k] for the valid k only
+				const size_t kBegin = i + 1 >= L ? 0 : L - 1 - i;
+				const size_t kEnd = i < N ? L : (i < N + L - 1 ? N + L - 1 - i : 0);
+				for (size_t k = kBegin; k < kEnd; ++k) { sum += taps[k] * x[i + 1 - L + k]; }
+			}
+			y[n] = sum;
+
+			p += bank.down;
+			i += p / bank.up;
+			p %= bank.up;
+		}
+	}
+
+	inline std::pair<unsigned, unsigned> reduce(unsigned up, unsigned down)
+	{
+		if (up == 0 || down == 0)
+		{
+			throw std::invalid_argument("Resampling factors must be positive!");
+		}
+		const auto g = std::gcd(up, down);
+		return { up / g, down / g };
+	}
+	/// @endcond
+}
+
+template <class T>
+dsp::resample::PolyphaseFilterBank<T>::PolyphaseFilterBank(const std::vector<T>& h, unsigned up, unsigned down, size_t delay)
+	: up(up), down(down), phaseLength((h.size() + up - 1) / up), delay(delay), taps(up * phaseLength, T(0))
+{
+	if (up == 0 || down == 0)
+	{
+		throw std::invalid_argument("Resampling factors must be positive!");
+	}
+	if (h.empty())
+	{
+		throw std::invalid_argument("Filter must have at least one coefficient!");
+	}
+	for (size_t p = 0; p < up; ++p)
+	{
+		for (size_t j = 0; p + j * up < h.size(); ++j)
+		{
+			taps[p * phaseLength + phaseLength - 1 - j] = h[p + j * up];
+		}
+	}
+}
+
+template <class T>
+std::vector<T> dsp::resample::upfirdn(const std::vector<T>& h, const std::vector<T>& x, unsigned up, unsigned down)
+{
+	const PolyphaseFilterBank<T> bank(h, up, down);
+	if (x.empty()) { return {}; }
+	std::vector<T> y(((x.size() - 1) * up + h.size() - 1) / down + 1);
+	polyphase(bank, x.data(), x.size(), 0, y.size(), y.data());
+	return y;
+}
+
+template <class T>
+std::shared_ptr<const dsp::resample::PolyphaseFilterBank<T>> dsp::resample::filterbank(unsigned up, unsigned down,
+	window::type windowType, const std::vector<T>& windowParameters)
+{
+	const auto key = typename FilterBankCache<T>::Key(up, down, windowType, windowParameters);
+	auto& cache = FilterBankCache<T>::instance();
+	{
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		auto it = cache.banks.find(key);
+		if (it != cache.banks.end()) { return it->second; }
+	}
+
+	// Windowed-sinc lowpass with its cutoff at the lower Nyquist frequency. The gain 'up' compensates the energy lost by upsampling.
+	const unsigned maxRate = std::max(up, down);
+	const unsigned halfLength = 10 * maxRate;
+	auto h = filter::firwin<T>(2 * halfLength + 1, { T(1) / maxRate }, true, windowType, true, 2, windowParameters);
+	for (auto& c : h) { c *= up; }
+
+	// Pre-pad the filter so that an output sample falls exactly on the filter's center
+	const unsigned prePad = down - halfLength % down;
+	h.insert(h.begin(), prePad, T(0));
+	const auto bank = std::make_shared<const PolyphaseFilterBank<T>>(h, up, down, (halfLength + prePad) / down);
+
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	return cache.banks.emplace(key, bank).first->second;
+}
+
+template <class T>
+void dsp::resample::clearFilterBankCache()
+{
+	auto& cache = FilterBankCache<T>::instance();
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	cache.banks.clear();
+}
+
+template <class T>
+std::vector<T> dsp::resample::resample_poly(const std::vector<T>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<T>& windowParameters)
+{
+	std::tie(up, down) = reduce(up, down);
+	if (up == 1 && down == 1) { return x; }
+
+	const auto bank = filterbank<T>(up, down, windowType, windowParameters);
+	std::vector<T> y((x.size() * up + down - 1) / down);
+	polyphase(*bank, x.data(), x.size(), bank->delay, y.size(), y.data());
+	return y;
+}
+
+template <class T>
+dsp::Signal<T> dsp::resample::resample_poly(const Signal<T>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<T>& windowParameters)
+{
+	const auto rate = static_cast<unsigned>(std::llround(static_cast<double>(x.getSamplingRate_Hz()) * up / down));
+	return Signal<T>(rate, resample_poly<T>(x.getSamples(), up, down, windowType, windowParameters));
+}
+
+template <class T>
+dsp::Signal<T> dsp::resample::resample(const Signal<T>& x, unsigned newSamplingRate_Hz,
+	window::type windowType, const std::vector<T>& windowParameters)
+{
+	return resample_poly<T>(x, newSamplingRate_Hz, x.getSamplingRate_Hz(), windowType, windowParameters);
+}
+
+template <class T>
+dsp::resample::PolyphaseResampler<T>::PolyphaseResampler(unsigned up, unsigned down,
+	window::type windowType, const std::vector<T>& windowParameters)
+{
+	std::tie(up, down) = reduce(up, down);
+	bank_ = filterbank<T>(up, down, windowType, windowParameters);
+	reset();
+}
+
+template <class T>
+void dsp::resample::PolyphaseResampler<T>::process(const T* in, size_t n, std::vector<T>& out)
+{
+	const auto& bank = *bank_;
+	const auto L = bank.phaseLength;
+	const auto history = L - 1;
+
+	buffer_.insert(buffer_.end(), in, in + n);
+	inputCount_ += n;
+
+	// Output sample m needs the input samples up to index (m * down) / up. The buffer starts at input index inputCount_ - n - history.
+	const size_t available = inputCount_ * bank.up;
+	const size_t end = available > 0 ? (available - 1) / bank.down + 1 : 0;
+	if (end > outputIndex_)
+	{
+		const size_t skip = outputIndex_ < bank.delay ? std::min(bank.delay, end) - outputIndex_ : 0;
+		const size_t count = end - outputIndex_ - skip;
+		const size_t offset = out.size();
+		out.resize(offset + count);
+
+		size_t t = (outputIndex_ + skip) * bank.down;
+		size_t i = t / bank.up - (inputCount_ - n);
+		size_t p = t % bank.up;
+		for (size_t m = 0; m < count; ++m)
+		{
+			const T* taps = bank.taps.data() + p * L;
+			const T* xi = buffer_.data() + i;
+			T sum = 0;
+			for (size_t k = 0; k < L; ++k) { sum += taps[k] * xi[k]; }
+			out[offset + m] = sum;
+
+			p += bank.down;
+			i += p / bank.up;
+			p %= bank.up;
+		}
+		outputIndex_ = end;
+		emitted_ += count;
+	}
+
+	buffer_.erase(buffer_.begin(), buffer_.end() - history);
+}
+
+template <class T>
+std::vector<T> dsp::resample::PolyphaseResampler<T>::process(const std::vector<T>& x)
+{
+	std::vector<T> y;
+	process(x.data(), x.size(), y);
+	return y;
+}
+
+template <class T>
+std::vector<T> dsp::resample::PolyphaseResampler<T>::flush()
+{
+	const auto& bank = *bank_;
+	const size_t expected = (inputCount_ * bank.up + bank.down - 1) / bank.down;
+	std::vector<T> y;
+	if (expected > emitted_)
+	{
+		// Feed zeros until the last expected output sample (delayed by the filter) becomes available
+		const size_t lastInput = ((bank.delay + expected - 1) * bank.down) / bank.up;
+		const size_t zeros = lastInput + 1 > inputCount_ ? lastInput + 1 - inputCount_ : 0;
+		const size_t remaining = expected - emitted_;
+		const std::vector<T> padding(zeros, T(0));
+		process(padding.data(), padding.size(), y);
+		y.resize(remaining);
+	}
+	reset();
+	return y;
+}
+
+template <class T>
+void dsp::resample::PolyphaseResampler<T>::reset()
+{
+	buffer_.assign(bank_->phaseLength - 1, T(0));
+	inputCount_ = 0;
+	outputIndex_ = 0;
+	emitted_ = 0;
+}
+
+
+// Explicit template instantiation
+template struct dsp::resample::PolyphaseFilterBank<float>;
+template struct dsp::resample::PolyphaseFilterBank<double>;
+template struct dsp::resample::PolyphaseFilterBank<long double>;
+
+template std::vector<float> dsp::resample::upfirdn(const std::vector<float>& h, const std::vector<float>& x, unsigned up, unsigned down);
+template std::vector<double> dsp::resample::upfirdn(const std::vector<double>& h, const std::vector<double>& x, unsigned up, unsigned down);
+template std::vector<long double> dsp::resample::upfirdn(const std::vector<long double>& h, const std::vector<long double>& x, unsigned up, unsigned down);
+
+template std::shared_ptr<const dsp::resample::PolyphaseFilterBank<float>> dsp::resample::filterbank(unsigned up, unsigned down,
+	window::type windowType, const std::vector<float>& windowParameters);
+template std::shared_ptr<const dsp::resample::PolyphaseFilterBank<double>> dsp::resample::filterbank(unsigned up, unsigned down,
+	window::type windowType, const std::vector<double>& windowParameters);
+template std::shared_ptr<const dsp::resample::PolyphaseFilterBank<long double>> dsp::resample::filterbank(unsigned up, unsigned down,
+	window::type windowType, const std::vector<long double>& windowParameters);
+
+template void dsp::resample::clearFilterBankCache<float>();
+template void dsp::resample::clearFilterBankCache<double>();
+template void dsp::resample::clearFilterBankCache<long double>();
+
+template std::vector<float> dsp::resample::resample_poly(const std::vector<float>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<float>& windowParameters);
+template std::vector<double> dsp::resample::resample_poly(const std::vector<double>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<double>& windowParameters);
+template std::vector<long double> dsp::resample::resample_poly(const std::vector<long double>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<long double>& windowParameters);
+
+template dsp::Signal<float> dsp::resample::resample_poly(const Signal<float>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<float>& windowParameters);
+template dsp::Signal<double> dsp::resample::resample_poly(const Signal<double>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<double>& windowParameters);
+template dsp::Signal<long double> dsp::resample::resample_poly(const Signal<long double>& x, unsigned up, unsigned down,
+	window::type windowType, const std::vector<long double>& windowParameters);
+
+template dsp::Signal<float> dsp::resample::resample(const Signal<float>& x, unsigned newSamplingRate_Hz,
+	window::type windowType, const std::vector<float>& windowParameters);
+template dsp::Signal<double> dsp::resample::resample(const Signal<double>& x, unsigned newSamplingRate_Hz,
+	window::type windowType, const std::vector<double>& windowParameters);
+template dsp::Signal<long double> dsp::resample::resample(const Signal<long double>& x, unsigned newSamplingRate_Hz,
+	window::type windowType, const std::vector<long double>& windowParameters);
+
+template class dsp::resample::PolyphaseResampler<float>;
+template class dsp::resample::PolyphaseResampler<double>;
+template class dsp::resample::PolyphaseResampler<long double>;
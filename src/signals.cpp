@@ -7,6 +7,7 @@ dsp::Signal<T> dsp::signals::sin(unsigned frequency_Hz, double length_s, unsigne
 {
 	Signal<T> sineSignal(samplingRate_Hz);
 	const auto numSamples = length_s * samplingRate_Hz;
+	sineSignal.reserve(static_cast<size_t>(std::ceil(numSamples)));
 	for (unsigned k = 0; k < numSamples; ++k)
 	{
 		sineSignal.push_back(static_cast<T>(amplitude * std::sin(2.0 * dsp::pi * frequency_Hz * k * 1.0 / samplingRate_Hz + phase)));
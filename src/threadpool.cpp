@@ -0,0 +1,240 @@
+#include "threadpool.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+	// Depth of the tasks and parallel loops that the current thread is running
+	thread_local unsigned parallelDepth = 0;
+
+	// Pool and index of the worker running on the current thread, if any
+	thread_local const dsp::ThreadPool* currentPool = nullptr;
+	thread_local size_t currentWorker = 0;
+
+	struct DepthScope
+	{
+		DepthScope() { ++parallelDepth; }
+		~DepthScope() { --parallelDepth; }
+	};
+
+	void pinCurrentThread(int cpu)
+	{
+		if (cpu < 0) return;
+#if defined(_WIN32)
+		// Processor groups are not handled, so only the first 64 logical processors can be used
+		if (cpu < 64)
+		{
+			SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu);
+		}
+#elif defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+	}
+
+	// Shared state of one parallelFor() call. Helper tasks that start after the loop has finished find no index left
+	// and never touch the loop body, which may be gone by then.
+	struct Loop
+	{
+		Loop(size_t n, const std::function<void(size_t)>& f) : n(n), f(&f) {}
+
+		// Runs iterations until none are left
+		void run()
+		{
+			DepthScope depth;
+			for (size_t i = next++; i < n; i = next++)
+			{
+				try
+				{
+					(*f)(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!error) error = std::current_exception();
+				}
+				if (++done == n)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					finished.notify_all();
+				}
+			}
+		}
+
+		const size_t n;
+		const std::function<void(size_t)>* f;
+		std::atomic<size_t> next{ 0 };
+		std::atomic<size_t> done{ 0 };
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::exception_ptr error;
+	};
+
+	std::mutex globalMutex;
+	std::unique_ptr<dsp::ThreadPool> globalPool;
+}
+
+dsp::ThreadPool::ThreadPool(unsigned numThreads, std::vector<unsigned> cpus)
+{
+	if (numThreads == 0)
+	{
+		const auto hardwareThreads = std::thread::hardware_concurrency();
+		numThreads = hardwareThreads > 2 ? hardwareThreads - 1 : 1;
+	}
+
+	workers_.reserve(numThreads);
+	for (unsigned i = 0; i < numThreads; ++i)
+	{
+		workers_.push_back(std::make_unique<Worker>());
+	}
+	for (unsigned i = 0; i < numThreads; ++i)
+	{
+		const int cpu = cpus.empty() ? -1 : static_cast<int>(cpus[i % cpus.size()]);
+		workers_[i]->thread = std::thread([this, i, cpu] { work(i, cpu); });
+	}
+}
+
+dsp::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		stop_ = true;
+	}
+	wake_.notify_all();
+	for (auto& worker : workers_)
+	{
+		worker->thread.join();
+	}
+}
+
+void dsp::ThreadPool::parallelFor(size_t n, const std::function<void(size_t)>& f)
+{
+	if (n == 0) return;
+	if (n == 1 || inParallelRegion() || workers_.empty())
+	{
+		DepthScope depth;
+		for (size_t i = 0; i < n; ++i)
+		{
+			f(i);
+		}
+		return;
+	}
+
+	auto loop = std::make_shared<Loop>(n, f);
+	const auto numHelpers = std::min(n - 1, workers_.size());
+	for (size_t h = 0; h < numHelpers; ++h)
+	{
+		push([loop] { loop->run(); });
+	}
+	loop->run();
+
+	std::unique_lock<std::mutex> lock(loop->mutex);
+	loop->finished.wait(lock, [&] { return loop->done == n; });
+	if (loop->error)
+	{
+		std::rethrow_exception(loop->error);
+	}
+}
+
+bool dsp::ThreadPool::inParallelRegion()
+{
+	return parallelDepth > 0;
+}
+
+dsp::ThreadPool& dsp::ThreadPool::global()
+{
+	std::lock_guard<std::mutex> lock(globalMutex);
+	if (!globalPool)
+	{
+		globalPool = std::make_unique<ThreadPool>();
+	}
+	return *globalPool;
+}
+
+void dsp::ThreadPool::setGlobal(unsigned numThreads, std::vector<unsigned> cpus)
+{
+	auto pool = std::make_unique<ThreadPool>(numThreads, std::move(cpus));
+	std::lock_guard<std::mutex> lock(globalMutex);
+	globalPool.swap(pool);
+}
+
+void dsp::ThreadPool::push(std::function<void()> task)
+{
+	// Workers queue their own tasks (e.g., of nested submits), others distribute them round robin
+	// The task is counted before it becomes visible, so that the count never drops below zero
+	const auto target = currentPool == this ? currentWorker : nextWorker_++ % workers_.size();
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		++queued_;
+	}
+	{
+		std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+		workers_[target]->tasks.push_back(std::move(task));
+	}
+	wake_.notify_one();
+}
+
+bool dsp::ThreadPool::runOne(size_t self)
+{
+	std::function<void()> task;
+	for (size_t k = 0; k < workers_.size() && !task; ++k)
+	{
+		// The own queue is used as a stack (most recent task first), the others are stolen from in order
+		auto& worker = *workers_[(self + k) % workers_.size()];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.tasks.empty()) continue;
+		if (k == 0)
+		{
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+		}
+	}
+	if (!task) return false;
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		--queued_;
+	}
+	DepthScope depth;
+	task();
+	return true;
+}
+
+void dsp::ThreadPool::work(size_t index, int cpu)
+{
+	pinCurrentThread(cpu);
+	currentPool = this;
+	currentWorker = index;
+
+	while (true)
+	{
+		if (runOne(index)) continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		if (stop_ && queued_ == 0) return;
+		wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+		if (stop_ && queued_ == 0) return;
+	}
+}
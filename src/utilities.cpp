@@ -1,27 +1,88 @@
 #include "utilities.h"
 
 #include <chrono>
+#include <cmath>
 #include <stdexcept>
 
 #include "fft.h"
+#include "kernels.h"
 #include "Signal.h"
 
 namespace dsp
 {
 	template<class T>
-	std::vector<T> direct_convolution(const std::vector<T>& in1, const std::vector<T>& in2,
-		convolution_mode mode)
+	std::vector<T> direct_convolution(SignalView<T> in1, SignalView<T> in2,
+		convolution_mode mode, const ExecutionContext& context)
 	{
-		throw std::runtime_error("Direct convolution not yet implemented!");
-		return {};
+		if (in1.empty() || in2.empty()) return {};
+
+		// The kernel needs contiguous samples, so only a strided in1 is copied
+		std::vector<T> contiguous;
+		const T* x = in1.data();
+		if (!in1.isContiguous())
+		{
+			contiguous = in1.toVector();
+			x = contiguous.data();
+		}
+
+		// Accumulate one scaled copy of in1 per kernel coefficient (contiguous inner loop). Chunks of the output are
+		// independent, and every output sample adds the coefficients in the same order, so the result does not depend
+		// on the execution policy.
+		const auto fullSize = in1.size() + in2.size() - 1;
+		std::vector<T> full(fullSize, T(0));
+		const auto chunkSize = std::max<size_t>(context.grainSize / std::max<size_t>(in2.size(), 1), 1024);
+		detail::forEachChunk(fullSize, chunkSize, context, [&](size_t lo, size_t hi)
+			{
+				for (size_t k = 0; k < in2.size(); ++k)
+				{
+					// Outputs k to k + in1.size() - 1 depend on coefficient k
+					const auto first = std::max(lo, k);
+					const auto last = std::min(hi, k + in1.size());
+					if (first < last)
+					{
+						kernels::multiplyAdd(full.data() + first, x + (first - k), in2[k], last - first);
+					}
+				}
+			});
+
+		switch (mode)
+		{
+		case convolution_mode::full:
+			return full;
+		case convolution_mode::valid:
+			return centered(full, std::max(in1.size(), in2.size()) - std::min(in1.size(), in2.size()) + 1);
+		case convolution_mode::same:
+			return centered(full, in1.size());
+		default:
+			throw std::runtime_error("Unknown convolution mode!");
+		}
 	}
 
-	/// @brief Reverse and conjugate a vector
+	/// @brief Predicts the faster convolution method for inputs of the given lengths
+	convolution_method predict_conv_method(size_t size1, size_t size2)
+	{
+		if (size1 == 0 || size2 == 0)
+		{
+			return convolution_method::direct;
+		}
+
+		// Compare the number of multiplications of the direct method with a rough operation count of the three FFTs
+		const auto directOps = static_cast<double>(size1) * static_cast<double>(size2);
+		const auto fftLength = std::pow(2.0, nextpow2(static_cast<unsigned>(size1 + size2 - 1)));
+		const auto fftOps = 3.0 * fftLength * std::log2(fftLength) + fftLength;
+		if (directOps < fftOps)
+		{
+			return convolution_method::direct;
+		}
+		return convolution_method::fft;
+	}
+
+	/// @brief Reverse and conjugate a (possibly strided) view
 	template<class T>
-	std::vector<T> _reverse_and_conj(const std::vector<T>& vec)
+	std::vector<T> _reverse_and_conj(SignalView<T> x)
 	{
-		std::vector<T> reversed_copy(vec.size());
-		std::reverse_copy(vec.begin(), vec.end(), reversed_copy.begin());
+		std::vector<T> reversed_copy(x.size());
+		std::reverse_copy(x.begin(), x.end(), reversed_copy.begin());
 		return dsp::conj(reversed_copy);
 	}
 
@@ -33,28 +94,16 @@ namespace dsp
 }
 
 template <class T>
-T dsp::calculateEnergy(typename std::vector<T>::iterator start,
-	typename std::vector<T>::iterator end)
-{
-	return std::inner_product(start, end, start, T(0));
-}
-
-template <class T>
-T dsp::calculateMeanPower(typename std::vector<T>::iterator start,
-	typename std::vector<T>::iterator end)
+std::vector<T> dsp::centered(const std::vector<T>& vec, size_t newSize)
 {
-	auto energy = calculateEnergy<T>(start, end);
-	auto numSamples = std::distance(start, end);
-	return energy / numSamples;
+	return centered(SignalView<T>(vec), newSize);
 }
 
 template <class T>
-std::vector<T> dsp::centered(const std::vector<T>& vec, size_t newSize)
+std::vector<T> dsp::centered(SignalView<T> x, size_t newSize)
 {
-	auto currentSize = vec.size();
-	auto firstIndex = (currentSize - newSize) / 2;
-	auto lastIndex = firstIndex + newSize;
-	return { vec.begin() + firstIndex, vec.begin() + lastIndex };
+	const auto firstIndex = (x.size() - newSize) / 2;
+	return x.subview(firstIndex, newSize).toVector();
 }
 
 
@@ -69,29 +118,31 @@ std::pair<dsp::convolution_method, std::map<dsp::convolution_method, double>> ds
 		throw std::runtime_error("Not implemented yet!");
 	}
 
-	// TODO: Calculate if FFT-based method is actually faster than direct method
-	return { convolution_method::fft, times };
+	return { predict_conv_method(in1.size(), in2.size()), times };
 }
 
 template <class T>
 std::vector<T> dsp::convolve(const std::vector<T>& in1, const std::vector<T>& in2,
-	convolution_mode mode, convolution_method method)
+	convolution_mode mode, convolution_method method, const ExecutionContext& context)
 {
-	auto volume = in1;
-	auto kernel = in2;
+	return convolve(SignalView<T>(in1), SignalView<T>(in2), mode, method, context);
+}
 
+template <class T>
+std::vector<T> dsp::convolve(SignalView<T> in1, SignalView<T> in2,
+	convolution_mode mode, convolution_method method, const ExecutionContext& context)
+{
 	if (method == convolution_method::automatic)
 	{
-		auto [chosen_method, timing] = choose_conv_method(volume, kernel, mode);
-		method = chosen_method;
+		method = predict_conv_method(in1.size(), in2.size());
 	}
 
 	switch (method)
 	{
 	case convolution_method::direct:
-		return direct_convolution(volume, kernel, mode);
+		return direct_convolution(in1, in2, mode, context);
 	case convolution_method::fft:
-		return fft::fftconvolution(volume, kernel, mode);
+		return fft::fftconvolution(in1, in2, mode);
 	default:
 		throw std::runtime_error("Unknown convolution method!");
 	}
@@ -100,16 +151,21 @@ std::vector<T> dsp::convolve(const std::vector<T>& in1, const std::vector<T>& in
 
 template <class T>
 std::vector<T> dsp::correlate(const std::vector<T>& in1, const std::vector<T>& in2,
-	convolution_mode mode, convolution_method method)
+	convolution_mode mode, convolution_method method, const ExecutionContext& context)
+{
+	return correlate(SignalView<T>(in1), SignalView<T>(in2), mode, method, context);
+}
+
+template <class T>
+std::vector<T> dsp::correlate(SignalView<T> in1, SignalView<T> in2,
+	convolution_mode mode, convolution_method method, const ExecutionContext& context)
 {
 	switch (method)
 	{
 	case convolution_method::automatic:
-		// Fall through to fft method
 	case convolution_method::fft:
-		return convolve(in1, _reverse_and_conj(in2), mode, method);
 	case convolution_method::direct:
-		throw std::runtime_error("Direct correlation method not yet implemented!");
+		return convolve(in1, SignalView<T>(_reverse_and_conj(in2)), mode, method, context);
 	default:
 		throw std::runtime_error("Unknown correlation method!");
 	}
@@ -117,6 +173,12 @@ std::vector<T> dsp::correlate(const std::vector<T>& in1, const std::vector<T>& i
 
 template <class T>
 std::vector<std::vector<T>> dsp::signalToFrames(const std::vector<T>& signal, unsigned frameLength, unsigned overlap)
+{
+	return signalToFrames(SignalView<T>(signal), frameLength, overlap);
+}
+
+template <class T>
+std::vector<std::vector<T>> dsp::signalToFrames(SignalView<T> signal, unsigned frameLength, unsigned overlap)
 {
 	std::vector<std::vector<T>> framedSignal;
 	const auto numSamples = signal.size();
@@ -125,7 +187,7 @@ std::vector<std::vector<T>> dsp::signalToFrames(const std::vector<T>& signal, un
 	for (size_t startSample = 0; startSample < numSamples; startSample += frameStride)
 	{
 		const size_t finalSample = std::min(startSample + frameLength, signal.size());
-		std::vector<T> frame{ signal.begin() + startSample, signal.begin() + finalSample };
+		std::vector<T> frame(signal.begin() + static_cast<std::ptrdiff_t>(startSample), signal.begin() + static_cast<std::ptrdiff_t>(finalSample));
 		frame.resize(frameLength, 0);  // Make sure the frame is padded to the frame length with zeros
 		framedSignal.push_back(frame);
 	}
@@ -147,35 +209,46 @@ std::pair<unsigned, bool> dsp::window::utilities::extend(unsigned N, bool sym)
 template std::vector<float> dsp::centered(const std::vector<float>& vec, size_t newSize);
 template std::vector<double> dsp::centered(const std::vector<double>& vec, size_t newSize);
 template std::vector<long double> dsp::centered(const std::vector<long double>& vec, size_t newSize);
+template std::vector<float> dsp::centered(SignalView<float> x, size_t newSize);
+template std::vector<double> dsp::centered(SignalView<double> x, size_t newSize);
+template std::vector<long double> dsp::centered(SignalView<long double> x, size_t newSize);
 
 template std::vector<float> dsp::convolve(const std::vector<float>& in1, const std::vector<float>& in2,
-	convolution_mode mode, convolution_method method);
+	convolution_mode mode, convolution_method method, const ExecutionContext& context);
 template std::vector<double> dsp::convolve(const std::vector<double>& in1, const std::vector<double>& in2,
-	convolution_mode mode, convolution_method method);
+	convolution_mode mode, convolution_method method, const ExecutionContext& context);
 template std::vector<long double> dsp::convolve(const std::vector<long double>& in1, const std::vector<long double>& in2,
-	convolution_mode mode, convolution_method method);
+	convolution_mode mode, convolution_method method, const ExecutionContext& context);
+template std::vector<float> dsp::convolve(SignalView<float> in1, SignalView<float> in2,
+	convolution_mode mode, convolution_method method, const ExecutionContext& context);
+template std::vector<double> dsp::convolve(SignalView<double> in1, SignalView<double> in2,
+	convolution_mode mode, convolution_method method, const ExecutionContext& context);
+template std::vector<long double> dsp::convolve(SignalView<long double> in1, SignalView<long double> in2,
+	convolution_mode mode, convolution_method method, const ExecutionContext& context);
+
+template std::pair<dsp::convolution_method, std::map<dsp::convolution_method, double>> dsp::choose_conv_method(
+	const std::vector<float>& in1, const std::vector<float>& in2, convolution_mode mode, bool measure);
+template std::pair<dsp::convolution_method, std::map<dsp::convolution_method, double>> dsp::choose_conv_method(
+	const std::vector<double>& in1, const std::vector<double>& in2, convolution_mode mode, bool measure);
+template std::pair<dsp::convolution_method, std::map<dsp::convolution_method, double>> dsp::choose_conv_method(
+	const std::vector<long double>& in1, const std::vector<long double>& in2, convolution_mode mode, bool measure);
 
 template std::vector<float> dsp::correlate(const std::vector<float>& in1, const std::vector<float>& in2,
-	correlation_mode mode, correlation_method method);
+	correlation_mode mode, correlation_method method, const ExecutionContext& context);
 template std::vector<double> dsp::correlate(const std::vector<double>& in1, const std::vector<double>& in2,
-	correlation_mode mode, correlation_method method);
+	correlation_mode mode, correlation_method method, const ExecutionContext& context);
 template std::vector<long double> dsp::correlate(const std::vector<long double>& in1, const std::vector<long double>& in2,
-	correlation_mode mode, correlation_method method);
-
-template float dsp::calculateEnergy(std::vector<float>::iterator start,
-	std::vector<float>::iterator end);
-template double dsp::calculateEnergy(std::vector<double>::iterator start,
-	std::vector<double>::iterator end);
-template long double dsp::calculateEnergy(std::vector<long double>::iterator start,
-	std::vector<long double>::iterator end);
-
-template float dsp::calculateMeanPower(typename std::vector<float>::iterator start,
-	typename std::vector<float>::iterator end);
-template double dsp::calculateMeanPower(typename std::vector<double>::iterator start,
-	typename std::vector<double>::iterator end);
-template long double dsp::calculateMeanPower(typename std::vector<long double>::iterator start,
-	typename std::vector<long double>::iterator end);
+	correlation_mode mode, correlation_method method, const ExecutionContext& context);
+template std::vector<float> dsp::correlate(SignalView<float> in1, SignalView<float> in2,
+	correlation_mode mode, correlation_method method, const ExecutionContext& context);
+template std::vector<double> dsp::correlate(SignalView<double> in1, SignalView<double> in2,
+	correlation_mode mode, correlation_method method, const ExecutionContext& context);
+template std::vector<long double> dsp::correlate(SignalView<long double> in1, SignalView<long double> in2,
+	correlation_mode mode, correlation_method method, const ExecutionContext& context);
 
 template std::vector<std::vector<float>> dsp::signalToFrames(const std::vector<float>& signal, unsigned frameLength, unsigned overlap);
 template std::vector<std::vector<double>> dsp::signalToFrames(const std::vector<double>& signal, unsigned frameLength, unsigned overlap);
 template std::vector<std::vector<long double>> dsp::signalToFrames(const std::vector<long double>& signal, unsigned frameLength, unsigned overlap);
+template std::vector<std::vector<float>> dsp::signalToFrames(SignalView<float> signal, unsigned frameLength, unsigned overlap);
+template std::vector<std::vector<double>> dsp::signalToFrames(SignalView<double> signal, unsigned frameLength, unsigned overlap);
+template std::vector<std::vector<long double>> dsp::signalToFrames(SignalView<long double> signal, unsigned frameLength, unsigned overlap);
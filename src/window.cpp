@@ -1,8 +1,10 @@
 #include "window.h"
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <numeric>
+#include <stdexcept>
 
 #include "fft.h"
 #include "Signal.h"
@@ -82,6 +84,24 @@ namespace dsp::window
 		}
 	}
 
+	template<class T>
+	std::vector<T> apply(SignalView<T> x, const std::vector<T>& w)
+	{
+		if (x.size() != w.size())
+		{
+			throw std::invalid_argument("The window must have the same length as the samples!");
+		}
+		std::vector<T> windowed(x.size());
+		std::transform(x.begin(), x.end(), w.begin(), windowed.begin(), std::multiplies<>());
+		return windowed;
+	}
+
+	template<class T>
+	std::vector<T> apply(type type, SignalView<T> x, bool sym, const std::vector<T>& parameters)
+	{
+		return window::apply(x, get_window<T>(type, static_cast<unsigned>(x.size()), sym, parameters));
+	}
+
 	template<class T>
 	std::vector<T> boxcar(unsigned N, bool sym)
 	{
@@ -516,6 +536,13 @@ namespace dsp::window
 	template std::vector<float> get_window(type type, unsigned N, bool sym, const std::vector<float>& parameters);
 	template std::vector<double> get_window(type type, unsigned N, bool sym, const std::vector<double>& parameters);
 	template std::vector<long double> get_window(type type, unsigned N, bool sym, const std::vector<long double>& parameters);
+
+	template std::vector<float> apply(SignalView<float> x, const std::vector<float>& w);
+	template std::vector<double> apply(SignalView<double> x, const std::vector<double>& w);
+	template std::vector<long double> apply(SignalView<long double> x, const std::vector<long double>& w);
+	template std::vector<float> apply(type type, SignalView<float> x, bool sym, const std::vector<float>& parameters);
+	template std::vector<double> apply(type type, SignalView<double> x, bool sym, const std::vector<double>& parameters);
+	template std::vector<long double> apply(type type, SignalView<long double> x, bool sym, const std::vector<long double>& parameters);
 	
 	template std::vector<float> boxcar(unsigned N, bool sym);
 	template std::vector<double> boxcar(unsigned N, bool sym);
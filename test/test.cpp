@@ -1,15 +1,75 @@
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <numeric>
 #include <iostream>
+#include <list>
 #include <fstream>
 #include <chrono>
 #include <random>
+#include <thread>
+#include <filesystem>
 
 
 #include "dsp.h"
 #include "dct_ref_data.h"
 
+// Counts heap allocations so that tests and benchmarks can report temporaries
+namespace allocations
+{
+	std::atomic<size_t> count{ 0 };
+	std::atomic<size_t> bytes{ 0 };
+
+	void* allocate(std::size_t size)
+	{
+		++count;
+		bytes += size;
+		if (void* p = std::malloc(size > 0 ? size : 1)) { return p; }
+		throw std::bad_alloc();
+	}
+
+	// Over-allocates with malloc() and keeps the pointer returned by it in front of the aligned block
+	void* allocate(std::size_t size, std::align_val_t alignment)
+	{
+		const auto a = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+		++count;
+		bytes += size;
+		auto* raw = static_cast<char*>(std::malloc(size + a));
+		if (raw == nullptr) { throw std::bad_alloc(); }
+		auto* p = raw + a - reinterpret_cast<std::uintptr_t>(raw) % a;
+		reinterpret_cast<void**>(p)[-1] = raw;
+		return p;
+	}
+
+	void deallocate(void* p) noexcept
+	{
+		std::free(p);
+	}
+
+	void deallocate(void* p, std::align_val_t) noexcept
+	{
+		if (p != nullptr) { std::free(reinterpret_cast<void**>(p)[-1]); }
+	}
+}
+
+void* operator new(std::size_t size) { return allocations::allocate(size); }
+void* operator new[](std::size_t size) { return allocations::allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocations::allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocations::allocate(size, alignment); }
+
+void operator delete(void* p) noexcept { allocations::deallocate(p); }
+void operator delete[](void* p) noexcept { allocations::deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { allocations::deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { allocations::deallocate(p); }
+void operator delete(void* p, std::align_val_t alignment) noexcept { allocations::deallocate(p, alignment); }
+void operator delete[](void* p, std::align_val_t alignment) noexcept { allocations::deallocate(p, alignment); }
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept { allocations::deallocate(p, alignment); }
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept { allocations::deallocate(p, alignment); }
+
 struct DspTest : ::testing::Test
 {
 
@@ -351,6 +411,1463 @@ TEST_F(DspTest, FilterTest)
 	}
 }
 
+TEST_F(DspTest, FirDesign)
+{
+	// Magnitude of the frequency response at the normalized frequency f (1 = Nyquist)
+	auto magnitude = [](const std::vector<double>& h, double f)
+	{
+		std::complex<double> H{ 0.0, 0.0 };
+		for (size_t n = 0; n < h.size(); ++n)
+		{
+			H += h[n] * std::exp(std::complex<double>(0.0, -dsp::pi * f * n));
+		}
+		return std::abs(H);
+	};
+
+	auto h_win = dsp::filter::firwin<double>(51, { 0.3 });
+	ASSERT_EQ(h_win.size(), 51);
+	EXPECT_NEAR(magnitude(h_win, 0.0), 1.0, 1e-12);
+	EXPECT_LT(magnitude(h_win, 0.6), 0.01);
+	EXPECT_NEAR(h_win.front(), h_win.back(), 1e-15);
+
+	auto h_hp = dsp::filter::firwin<double>(51, { 4000.0 }, false, dsp::window::type::hann, true, 16000.0);
+	EXPECT_NEAR(magnitude(h_hp, 1.0), 1.0, 1e-12);
+	EXPECT_LT(magnitude(h_hp, 0.1), 0.01);
+	EXPECT_THROW(dsp::filter::firwin<double>(50, { 0.3 }, false), std::invalid_argument);
+
+	auto h_ls = dsp::filter::firls<double>(51, { 0.0, 0.3, 0.4, 1.0 }, { 1.0, 1.0, 0.0, 0.0 });
+	EXPECT_NEAR(magnitude(h_ls, 0.0), 1.0, 0.01);
+	EXPECT_LT(magnitude(h_ls, 0.6), 0.01);
+
+	auto h_pm = dsp::filter::remez<double>(51, { 0.0, 0.15, 0.2, 0.5 }, { 1.0, 0.0 });
+	for (double f = 0.0; f <= 0.3; f += 0.01)
+	{
+		EXPECT_NEAR(magnitude(h_pm, f), 1.0, 0.01);
+	}
+	for (double f = 0.4; f <= 1.0; f += 0.01)
+	{
+		EXPECT_LT(magnitude(h_pm, f), 0.01);
+	}
+
+	// Cached designs are shared between equal specifications
+	dsp::filter::FirSpec<double> spec;
+	spec.method = dsp::filter::fir_method::firwin;
+	spec.numtaps = 51;
+	spec.bands = { 0.3 };
+	const auto& h1 = dsp::filter::firdesign(spec);
+	const auto& h2 = dsp::filter::firdesign(spec);
+	EXPECT_EQ(&h1, &h2);
+	EXPECT_EQ(h1, h_win);
+
+	// The Remez filter type is part of the specification
+	dsp::filter::FirSpec<double> hilbertSpec;
+	hilbertSpec.method = dsp::filter::fir_method::remez;
+	hilbertSpec.numtaps = 31;
+	hilbertSpec.bands = { 0.05, 0.45 };
+	hilbertSpec.desired = { 1.0 };
+	hilbertSpec.fs = 1;
+	hilbertSpec.remezType = dsp::filter::remez_type::hilbert;
+	const auto& h_hilbert = dsp::filter::firdesign(hilbertSpec);
+	EXPECT_EQ(h_hilbert, dsp::filter::remez<double>(31, { 0.05, 0.45 }, { 1.0 }, {}, 1, dsp::filter::remez_type::hilbert));
+	EXPECT_NEAR(h_hilbert[0], -h_hilbert[30], 1e-12);  // Antisymmetric
+	hilbertSpec.remezType = dsp::filter::remez_type::bandpass;
+	EXPECT_NE(&dsp::filter::firdesign(hilbertSpec), &h_hilbert);
+
+	// The coefficients can be applied with the direct and the FFT convolution engines
+	auto x = dsp::signals::sin<double>(100, 0.02, 8000).getSamples();
+	auto y_direct = dsp::convolve(x, h1, dsp::convolution_mode::full, dsp::convolution_method::direct);
+	auto y_fft = dsp::convolve(x, h1, dsp::convolution_mode::full, dsp::convolution_method::fft);
+	ASSERT_EQ(y_direct.size(), x.size() + h1.size() - 1);
+	for (size_t i = 0; i < y_direct.size(); ++i)
+	{
+		EXPECT_NEAR(y_direct[i], y_fft[i], 1e-9);
+	}
+	dsp::filter::clearFirDesignCache<double>();
+}
+
+TEST_F(DspTest, IirDesign)
+{
+	// Magnitude in dB of a cascade of second-order sections at the normalized frequency f (1 = Nyquist)
+	auto magnitude_dB = [](const auto& sos, double f)
+	{
+		const auto z = std::polar(1.0, dsp::pi * f);
+		std::complex<double> H{ 1.0, 0.0 };
+		for (const auto& s : sos)
+		{
+			H *= (double(s[0]) * z * z + double(s[1]) * z + double(s[2])) / (double(s[3]) * z * z + double(s[4]) * z + double(s[5]));
+		}
+		return 20.0 * std::log10(std::abs(H));
+	};
+
+	auto butter = dsp::filter::butter<double>(4, { 1000.0 }, dsp::filter::filter_type::lowpass, 8000.0);
+	ASSERT_EQ(butter.size(), 2);
+	EXPECT_NEAR(magnitude_dB(butter, 0.0), 0.0, 1e-9);
+	EXPECT_NEAR(magnitude_dB(butter, 0.25), -3.0103, 1e-3);
+
+	auto cheby1 = dsp::filter::cheby1<double>(5, 1.0, { 0.3 });
+	EXPECT_NEAR(magnitude_dB(cheby1, 0.3), -1.0, 1e-6);
+	EXPECT_LT(magnitude_dB(cheby1, 0.5), -40.0);
+
+	auto cheby2 = dsp::filter::cheby2<double>(4, 40.0, { 0.2, 0.4 }, dsp::filter::filter_type::bandstop);
+	EXPECT_NEAR(magnitude_dB(cheby2, 0.0), 0.0, 1e-6);
+	EXPECT_NEAR(magnitude_dB(cheby2, 0.2), -40.0, 1e-6);
+	EXPECT_LT(magnitude_dB(cheby2, 0.3), -40.0);
+
+	auto ellip = dsp::filter::ellip<double>(5, 1.0, 60.0, { 0.2, 0.4 }, dsp::filter::filter_type::bandpass);
+	ASSERT_EQ(ellip.size(), 5);
+	for (double f = 0.2; f <= 0.4; f += 0.01)
+	{
+		EXPECT_GT(magnitude_dB(ellip, f), -1.0 - 1e-6);
+	}
+	EXPECT_LT(magnitude_dB(ellip, 0.1), -60.0 + 1e-6);
+	EXPECT_LT(magnitude_dB(ellip, 0.6), -60.0 + 1e-6);
+	EXPECT_THROW(dsp::filter::butter<double>(4, { 0.2 }, dsp::filter::filter_type::bandpass), std::invalid_argument);
+
+	// A high-order, narrow elliptic filter stays stable in single precision
+	auto sos = dsp::filter::ellip<float>(12, 0.1f, 100.0f, { 0.05f });
+	std::vector<float> impulse(20000, 0.0f);
+	impulse[0] = 1.0f;
+	auto response = dsp::filter::sosfilt(sos, impulse);
+	EXPECT_LT(*std::max_element(response.begin(), response.end()), 1.0f);
+	EXPECT_LT(std::abs(response.back()), 1e-10f);
+
+	// Block-wise processing gives the same result as filtering the whole signal
+	auto x = dsp::signals::sin<double>(440, 0.125, 8000).getSamples();
+	dsp::filter::SosFilter<double> stream(butter);
+	std::vector<double> y(x.size());
+	stream.process(x.data(), y.data(), 300);
+	stream.process(x.data() + 300, y.data() + 300, x.size() - 300);
+	auto y_full = dsp::filter::sosfilt(butter, x);
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(y[i], y_full[i]);
+	}
+}
+
+TEST_F(DspTest, Resample)
+{
+	// upfirdn matches zero-stuffing, filtering and decimating
+	std::vector<double> h{ 0.1, 0.5, -0.3, 0.2, 0.7, 0.05, 1.0 };
+	std::vector<double> x{ 1.0, 2.0, 3.0, -1.0, 0.5, 4.0, 2.0 };
+	std::vector<double> stuffed((x.size() - 1) * 3 + 1, 0.0);
+	for (size_t i = 0; i < x.size(); ++i) { stuffed[i * 3] = x[i]; }
+	auto full = dsp::convolve(stuffed, h, dsp::convolution_mode::full, dsp::convolution_method::direct);
+	auto y = dsp::resample::upfirdn(h, x, 3, 2);
+	ASSERT_EQ(y.size(), (full.size() + 1) / 2);
+	for (size_t i = 0; i < y.size(); ++i)
+	{
+		EXPECT_NEAR(y[i], full[2 * i], 1e-12);
+	}
+
+	// 44.1 kHz to 16 kHz keeps a 440 Hz tone in place
+	auto signal = dsp::signals::sin<double>(440, 0.1, 44100);
+	auto resampled = dsp::resample::resample(signal, 16000);
+	EXPECT_EQ(resampled.getSamplingRate_Hz(), 16000);
+	ASSERT_EQ(resampled.getSamples().size(), 1600);
+	for (size_t n = 400; n < 1200; ++n)
+	{
+		EXPECT_NEAR(resampled.getSamples()[n], std::sin(2.0 * dsp::pi * 440.0 * n / 16000.0), 5e-3);
+	}
+
+	// Filter banks are shared
+	EXPECT_EQ(dsp::resample::filterbank<double>(160, 441), dsp::resample::filterbank<double>(160, 441));
+
+	// Streaming in odd block sizes gives the same samples as the offline resampler
+	const auto& samples = signal.getSamples();
+	dsp::resample::PolyphaseResampler<double> resampler(16000, 44100);
+	std::vector<double> streamed;
+	for (size_t pos = 0, block = 1; pos < samples.size(); pos += block, block = block * 3 + 1)
+	{
+		resampler.process(samples.data() + pos, std::min(block, samples.size() - pos), streamed);
+	}
+	auto tail = resampler.flush();
+	streamed.insert(streamed.end(), tail.begin(), tail.end());
+	ASSERT_EQ(streamed.size(), resampled.getSamples().size());
+	for (size_t n = 0; n < streamed.size(); ++n)
+	{
+		EXPECT_DOUBLE_EQ(streamed[n], resampled.getSamples()[n]);
+	}
+	dsp::resample::clearFilterBankCache<double>();
+}
+
+TEST_F(DspTest, LpcBatch)
+{
+	auto x = dsp::signals::sin<double>(100, 0.2, 8000).getSamples();
+	for (size_t i = 0; i < x.size(); ++i) { x[i] += 0.5 * std::sin(0.37 * i + 1.0); }
+	auto frames = dsp::signalToFrames(x, 320, 160);
+
+	auto reference = dsp::filter::lpc(frames, 16, dsp::filter::autocorrelation_method::direct);
+	ASSERT_EQ(reference.size(), frames.size());
+	for (auto method : { dsp::filter::autocorrelation_method::vectorized, dsp::filter::autocorrelation_method::fft,
+		dsp::filter::autocorrelation_method::automatic })
+	{
+		auto results = dsp::filter::lpc(frames, 16, method);
+		ASSERT_EQ(results.size(), frames.size());
+		for (size_t f = 0; f < frames.size(); ++f)
+		{
+			ASSERT_EQ(results[f].coefficients.size(), 17);
+			ASSERT_EQ(results[f].reflection.size(), 16);
+			for (size_t i = 0; i <= 16; ++i)
+			{
+				EXPECT_NEAR(results[f].coefficients[i], reference[f].coefficients[i], 1e-8);
+			}
+			EXPECT_NEAR(results[f].error, reference[f].error, 1e-8);
+		}
+	}
+
+	// The batched analysis agrees with lpc() on single frames, and the prediction error follows from the reflection coefficients
+	auto single = dsp::filter::lpc(frames[3], 16);
+	auto energy = std::inner_product(frames[3].begin(), frames[3].end(), frames[3].begin(), 0.0);
+	for (auto k : reference[3].reflection)
+	{
+		EXPECT_LT(std::abs(k), 1.0);
+		energy *= 1.0 - k * k;
+	}
+	EXPECT_EQ(single, reference[3].coefficients);
+	EXPECT_NEAR(reference[3].error, energy, 1e-9);
+
+	// An analyzer reuses its FFT buffers for frames of changing lengths
+	dsp::filter::LpcAnalyzer<double> fftAnalyzer(16, dsp::filter::autocorrelation_method::fft);
+	dsp::filter::LpcAnalyzer<double> directAnalyzer(16, dsp::filter::autocorrelation_method::direct);
+	dsp::filter::LpcResult<double> fftResult, directResult;
+	for (size_t length : { 320, 64, 320, 17 })
+	{
+		fftAnalyzer.analyze(x.data(), length, fftResult);
+		directAnalyzer.analyze(x.data(), length, directResult);
+		for (size_t i = 0; i <= 16; ++i)
+		{
+			EXPECT_NEAR(fftResult.coefficients[i], directResult.coefficients[i], 1e-8);
+		}
+	}
+}
+
+TEST_F(DspTest, LpcResidualAndRoots)
+{
+	auto x = dsp::signals::sin<double>(300, 0.05, 8000).getSamples();
+	for (size_t i = 0; i < x.size(); ++i) { x[i] += 0.3 * std::cos(0.9 * i); }
+	auto a = dsp::filter::lpc(x, 8);
+
+	// The residual is the output of the inverse filter, and the synthesis filter restores the signal
+	auto residual = dsp::filter::lpcResidual(x, a);
+	auto A = dsp::filter::lpcToPolynomial(a);
+	auto inverse = dsp::filter::filter<double>(A, { 1.0 }, x);
+	ASSERT_EQ(residual.size(), x.size());
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		EXPECT_NEAR(residual[i], inverse[i], 1e-12);
+	}
+	auto y = dsp::filter::lpcSynthesis(residual, a);
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		EXPECT_NEAR(y[i], x[i], 1e-9);
+	}
+
+	// Batched frames in single precision
+	auto frames = dsp::signalToFrames(std::vector<float>(x.begin(), x.end()), 100, 50);
+	std::vector<std::vector<float>> coeffs;
+	for (const auto& frame : frames) { coeffs.push_back(dsp::filter::lpc(frame, 8)); }
+	auto resynthesized = dsp::filter::lpcSynthesis(dsp::filter::lpcResidual(frames, coeffs), coeffs);
+	ASSERT_EQ(resynthesized.size(), frames.size());
+	for (size_t f = 0; f < frames.size(); ++f)
+	{
+		for (size_t i = 0; i < frames[f].size(); ++i)
+		{
+			EXPECT_NEAR(resynthesized[f][i], frames[f][i], 1e-3f);
+		}
+	}
+
+	// Roots of (x - 0.5)(x + 0.7)(x^2 - 1.6x + 0.89); the odd-degree case adds a root at 0
+	auto roots = dsp::filter::polynomialRoots<double>({ 1.0, -1.4, 0.22, 0.738, -0.3115 });
+	ASSERT_EQ(roots.size(), 4);
+	std::sort(roots.begin(), roots.end(), [](const auto& u, const auto& v) { return std::arg(u) < std::arg(v); });
+	EXPECT_NEAR(std::abs(roots[0] - std::complex<double>(0.8, -0.5)), 0.0, 1e-9);
+	EXPECT_NEAR(std::abs(roots[1] - std::complex<double>(0.5, 0.0)), 0.0, 1e-9);
+	EXPECT_NEAR(std::abs(roots[2] - std::complex<double>(0.8, 0.5)), 0.0, 1e-9);
+	EXPECT_NEAR(std::abs(roots[3] - std::complex<double>(-0.7, 0.0)), 0.0, 1e-9);
+	EXPECT_EQ(dsp::filter::polynomialRoots<double>({ 1.0, -0.5, 0.0, 0.0 }).size(), 4);
+
+	// Badly scaled coefficients give the same roots (and terminate)
+	for (double scale : { 1e-6, 1e6 })
+	{
+		std::vector<double> scaled{ 1.0, -1.4, 0.22, 0.738, -0.3115 };
+		for (auto& c : scaled) { c *= scale; }
+		auto scaledRoots = dsp::filter::polynomialRoots(scaled);
+		std::sort(scaledRoots.begin(), scaledRoots.end(), [](const auto& u, const auto& v) { return std::arg(u) < std::arg(v); });
+		for (size_t i = 0; i < roots.size(); ++i)
+		{
+			EXPECT_NEAR(std::abs(scaledRoots[i] - roots[i]), 0.0, 1e-9);
+		}
+	}
+	EXPECT_THROW(dsp::filter::polynomialRoots<double>({ 0.0, 1.0, 2.0 }), std::invalid_argument);
+
+	// The poles of a stable LPC model lie inside the unit circle
+	for (const auto& root : dsp::filter::polynomialRoots(A))
+	{
+		EXPECT_LT(std::abs(root), 1.0);
+	}
+}
+
+TEST_F(DspTest, ExpressionTemplates)
+{
+	auto a = dsp::signals::sin<double>(100, 0.1, 8000);
+	auto b = dsp::signals::cos<double>(100, 0.1, 8000);
+	auto c = dsp::signals::sin<double>(300, 0.1, 8000);
+	auto d = dsp::signals::cos<double>(300, 0.1, 8000);
+	auto e = dsp::signals::sin<double>(700, 0.1, 8000);
+
+	auto eager = a * b + c * d - e;
+	dsp::Signal<double> lazy = dsp::expr::lazy(a) * b + dsp::expr::lazy(c) * d - e;
+	EXPECT_EQ(lazy, eager);
+
+	// Assigning to an existing signal of the right size evaluates in place without any allocation
+	dsp::Signal<double> y(8000, std::vector<double>(a.size()));
+	const auto before = allocations::count.load();
+	y = dsp::expr::lazy(a) * b + dsp::expr::lazy(c) * d - e;
+	EXPECT_EQ(allocations::count.load(), before);
+	EXPECT_EQ(y, eager);
+
+	// Scalars, vectors, negation and the signal itself as operand
+	y = 2.0 * -dsp::expr::lazy(y) / 4.0 + b.getSamples();
+	for (size_t i = 0; i < y.size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(y[i], -eager[i] / 2.0 + b[i]);
+	}
+	auto v = dsp::expr::evaluate(dsp::expr::lazy(a.getSamples()) - 1.0);
+	EXPECT_DOUBLE_EQ(v[5], a[5] - 1.0);
+
+	EXPECT_THROW(dsp::expr::lazy(a) + dsp::signals::sin<double>(100, 0.2, 8000), std::logic_error);
+	EXPECT_THROW(dsp::expr::lazy(a) + dsp::signals::sin<double>(100, 0.1, 16000), std::logic_error);
+}
+
+TEST_F(DspTest, CompoundAssignmentKernels)
+{
+	// Odd lengths exercise both the vectorized body and the scalar tail of the kernels
+	for (size_t n : { 0, 1, 7, 33, 1001 })
+	{
+		std::vector<double> a(n), b(n);
+		std::vector<float> af(n), bf(n);
+		std::vector<int> ai(n), bi(n);
+		std::vector<std::complex<double>> az(n), bz(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			a[i] = std::sin(0.1 * i);
+			b[i] = 2.0 + std::cos(0.3 * i);
+			af[i] = static_cast<float>(a[i]);
+			bf[i] = static_cast<float>(b[i]);
+			ai[i] = static_cast<int>(i) - 17;
+			bi[i] = static_cast<int>(i % 5) + 1;
+			az[i] = { a[i], b[i] };
+			bz[i] = { b[i], -a[i] };
+		}
+
+		dsp::Signal<double> x(8000, a);
+		x += dsp::Signal<double>(8000, b);
+		x *= b;
+		x -= 0.5;
+		x /= dsp::Signal<double>(8000, b);
+		x *= 3.0;
+		x += x;
+		dsp::Signal<float> xf(8000, af);
+		xf -= bf;
+		xf /= 2.0f;
+		dsp::Signal<int> xi(8000, ai);
+		xi *= bi;
+		xi /= 3;
+		dsp::Signal<std::complex<double>> xz(8000, az);
+		xz *= bz;
+		xz -= std::complex<double>(1.0, 1.0);
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_DOUBLE_EQ(x[i], 2.0 * (3.0 * (((a[i] + b[i]) * b[i] - 0.5) / b[i])));
+			EXPECT_FLOAT_EQ(xf[i], (af[i] - bf[i]) / 2.0f);
+			EXPECT_EQ(xi[i], ai[i] * bi[i] / 3);
+			EXPECT_EQ(xz[i], az[i] * bz[i] - std::complex<double>(1.0, 1.0));
+		}
+	}
+
+	// A scalar operand may refer to an element of the signal itself (e.g., normalization by the first sample)
+	for (size_t n : { 7, 33 })
+	{
+		dsp::Signal<double> s(8000, std::vector<double>(n, 4.0));
+		dsp::Signal<float> sf(8000, std::vector<float>(n, 4.0f));
+		dsp::Signal<int> si(8000, std::vector<int>(n, 4));
+		s *= s[0];
+		sf /= sf[0];
+		si += si[0];
+		std::vector<double> y(n, 2.0);
+		const std::vector<double> ones(n, 1.0);
+		dsp::kernels::multiplyAdd(y.data(), ones.data(), y[0], n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_EQ(s[i], 16.0);
+			EXPECT_EQ(sf[i], 1.0f);
+			EXPECT_EQ(si[i], 8);
+			EXPECT_EQ(y[i], 4.0);
+		}
+	}
+
+	dsp::Signal<double> x(8000, std::vector<double>(10));
+	EXPECT_THROW(x += dsp::Signal<double>(16000, std::vector<double>(10)), std::logic_error);
+	EXPECT_THROW(x -= dsp::Signal<double>(8000, std::vector<double>(9)), std::logic_error);
+	EXPECT_THROW(x *= std::vector<double>(11), std::logic_error);
+}
+
+TEST_F(DspTest, CalibratedSignal)
+{
+	static_assert(!std::is_polymorphic_v<dsp::Signal<double>>, "Signal must not carry a vtable");
+
+	auto x = dsp::signals::sin<double>(100, 0.01, 8000);
+
+	// Concrete functor: inlined
+	auto pascal = dsp::calibrate(x, dsp::LinearCalibration<double>{ 2.0, 0.5 });
+	ASSERT_EQ(pascal.size(), x.size());
+	EXPECT_EQ(pascal.getSamplingRate_Hz(), 8000);
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(pascal[i], 2.0 * x[i] + 0.5);
+	}
+	EXPECT_THROW(pascal.at(x.size()), std::out_of_range);
+
+	// Type-erased calibration and materialization
+	dsp::CalibratedSignal<double> squared(x, [](const double& s) { return s * s; });
+	auto y = squared.calibrated();
+	EXPECT_EQ(y.getSamplingRate_Hz(), 8000);
+	EXPECT_DOUBLE_EQ(y[7], x[7] * x[7]);
+	EXPECT_DOUBLE_EQ(squared.getValue(7), x[7] * x[7]);
+
+	// The adaptor refers to the signal, so it sees later changes
+	x[3] = 1.0;
+	EXPECT_DOUBLE_EQ(pascal[3], 2.5);
+}
+
+TEST_F(DspTest, Allocators)
+{
+	auto x = dsp::signals::sin<double>(100, 0.01, 8000);
+	auto y = dsp::signals::cos<double>(300, 0.01, 8000);
+
+	// Aligned storage, constructed from default-allocated samples
+	dsp::AlignedSignal<double> xa(8000, x.getSamples());
+	dsp::AlignedSignal<double> ya(8000, y.getSamples());
+	EXPECT_TRUE(dsp::isAligned(xa.data(), dsp::simdAlignment));
+	auto za = xa * ya + 2.0 * xa - ya / 3.0;
+	EXPECT_TRUE(dsp::isAligned(za.data(), dsp::simdAlignment));
+	auto z = x * y + 2.0 * x - y / 3.0;
+	ASSERT_EQ(za.size(), z.size());
+	for (size_t i = 0; i < z.size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(za[i], z[i]);
+	}
+	auto magnitude = dsp::abs(za);
+	EXPECT_TRUE(dsp::isAligned(magnitude.data(), dsp::simdAlignment));
+
+	// Misaligned views of the same data take the unaligned path and give the same result
+	std::vector<double> a(x.begin(), x.end()), b(y.begin(), y.end());
+	a.insert(a.begin(), 0.0);
+	b.insert(b.begin(), 0.0);
+	dsp::kernels::multiplies(a.data() + 1, b.data() + 1, x.size());
+	dsp::kernels::multiplyAdd(a.data() + 1, x.data(), 2.0, x.size());
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(a[i + 1], x[i] * y[i] + 2.0 * x[i]);
+	}
+
+	// Pooled storage is recycled once it has been returned
+	auto& pool = dsp::MemoryPool::instance();
+	pool.release();
+	{
+		dsp::PoolSignal<float> frame(8000, std::vector<float>(1000, 1.0f));
+	}
+	EXPECT_EQ(pool.cachedBlocks(), 1);
+	const auto before = allocations::count.load();
+	{
+		dsp::PoolSignal<float> frame(8000, std::vector<float>(900, 1.0f));
+		EXPECT_EQ(pool.cachedBlocks(), 0);
+		EXPECT_TRUE(dsp::isAligned(frame.data(), dsp::simdAlignment));
+	}
+	// The only allocation is the temporary std::vector
+	EXPECT_EQ(allocations::count.load() - before, 1);
+	EXPECT_EQ(pool.cachedBlocks(), 1);
+
+	// std::pmr support
+	dsp::Signal<double, std::pmr::polymorphic_allocator<double>> xp(8000, dsp::poolResource());
+	xp.assign(x.begin(), x.end());
+	xp *= xp;
+	EXPECT_DOUBLE_EQ(xp[10], x[10] * x[10]);
+	EXPECT_EQ(xp.getSamples().get_allocator().resource(), dsp::poolResource());
+}
+
+TEST_F(DspTest, ScratchArena)
+{
+	auto x = dsp::signals::sin<double>(100, 0.1, 8000);
+
+	// The spectrogram matches the frame-by-frame calculation with separately allocated frames
+	const unsigned frameLength = 200;
+	auto S = dsp::fft::spectrogram(x.getSamples(), frameLength, 0.5, 8000, 0.5);
+	auto frames = dsp::signalToFrames(x.getSamples(), frameLength, frameLength / 2);
+	auto window = dsp::window::get_window<double>(dsp::window::type::hamming, frameLength);
+	ASSERT_EQ(S.size(), frames.size());
+	for (size_t i = 0; i < frames.size(); ++i)
+	{
+		std::transform(frames[i].begin(), frames[i].end(), window.begin(), frames[i].begin(), std::multiplies<>());
+		auto expected = dsp::fft::logSquaredMagnitudeSpectrum(frames[i], 256, 0.5);
+		ASSERT_EQ(S[i].size(), expected.size());
+		for (size_t k = 0; k < expected.size(); ++k)
+		{
+			EXPECT_NEAR(S[i][k], expected[k], 1e-9);
+		}
+	}
+
+	// Once the arena has grown, processing further frames does not touch the heap
+	dsp::ScratchArena arena;
+	std::vector<double> spectrum(128);
+	EXPECT_EQ(dsp::fft::logSquaredMagnitudeSpectrum(frames[0].data(), frameLength, 256, 0.5, spectrum.data(), arena), 128);
+	const auto before = allocations::count.load();
+	for (size_t i = 1; i < frames.size(); ++i)
+	{
+		dsp::fft::logSquaredMagnitudeSpectrum(frames[i].data(), frameLength, 256, 0.5, spectrum.data(), arena);
+	}
+	EXPECT_EQ(allocations::count.load(), before);
+	EXPECT_EQ(arena.used(), 0);
+
+	// Rewinding frees everything allocated after the marker; chunks are merged once the arena is empty
+	arena.reset();
+	const auto capacity = arena.capacity();
+	auto* a = arena.allocate<float>(10);
+	EXPECT_TRUE(dsp::isAligned(a, dsp::simdAlignment));
+	const auto marker = arena.marker();
+	const auto used = arena.used();
+	arena.allocate<double>(capacity);  // Needs a new chunk
+	EXPECT_GT(arena.capacity(), capacity);
+	arena.rewind(marker);
+	EXPECT_EQ(arena.used(), used);
+	{
+		dsp::ScratchScope scope(arena);
+		arena.allocate<char>(100);
+		EXPECT_GT(arena.used(), used);
+	}
+	EXPECT_EQ(arena.used(), used);
+	arena.reset();
+	EXPECT_EQ(arena.used(), 0);
+	arena.allocate<double>(capacity);
+	EXPECT_EQ(arena.used(), capacity * sizeof(double));
+}
+
+TEST_F(DspTest, SignalView)
+{
+	auto left = dsp::signals::sin<double>(100, 0.05, 8000);
+	auto right = dsp::signals::cos<double>(300, 0.05, 8000);
+
+	// Interleaved stereo samples, e.g., from a memory-mapped file
+	std::vector<double> interleaved;
+	for (size_t i = 0; i < left.size(); ++i)
+	{
+		interleaved.push_back(left[i]);
+		interleaved.push_back(right[i]);
+	}
+	dsp::SignalView<double> l(interleaved.data(), left.size(), 2, 8000);
+	dsp::SignalView<double> r(interleaved.data() + 1, right.size(), 2, 8000);
+	ASSERT_EQ(l.size(), left.size());
+	EXPECT_FALSE(l.isContiguous());
+	EXPECT_EQ(std::distance(l.begin(), l.end()), static_cast<std::ptrdiff_t>(left.size()));
+	EXPECT_EQ(r.toVector(), right.getSamples());
+
+	// Views of signals and vectors
+	dsp::SignalView<double> v = left;
+	EXPECT_EQ(v.getSamplingRate_Hz(), 8000);
+	EXPECT_TRUE(v.isContiguous());
+	EXPECT_EQ(v.data(), left.data());
+	auto part = v.subview(10, 20);
+	EXPECT_EQ(part.size(), 20);
+	EXPECT_DOUBLE_EQ(part[0], left[10]);
+	auto decimated = v.strided(4);
+	EXPECT_EQ(decimated.size(), (left.size() + 3) / 4);
+	EXPECT_DOUBLE_EQ(decimated[3], left[12]);
+	EXPECT_EQ(decimated.getSamplingRate_Hz(), 2000);
+	EXPECT_THROW(v.subview(left.size() + 1), std::out_of_range);
+
+	// Strided and contiguous views give the same results as copies
+	const auto& x = left.getSamples();
+	const auto& y = right.getSamples();
+	auto X = dsp::fft::rfft(l, 512);
+	auto Xref = dsp::fft::rfft(x, 512);
+	ASSERT_EQ(X.size(), Xref.size());
+	for (size_t k = 0; k < X.size(); ++k)
+	{
+		EXPECT_NEAR(std::abs(X[k] - Xref[k]), 0.0, 1e-9);
+	}
+	auto X2 = dsp::fft::fft(v.subview(0, 256));
+	auto X2ref = dsp::fft::fft(std::vector<double>(x.begin(), x.begin() + 256));
+	for (size_t k = 0; k < X2.size(); ++k)
+	{
+		EXPECT_NEAR(std::abs(X2[k] - X2ref[k]), 0.0, 1e-9);
+	}
+
+	std::vector<double> kernel{ 0.25, 0.5, 0.25 };
+	for (auto method : { dsp::convolution_method::direct, dsp::convolution_method::fft })
+	{
+		auto c = dsp::convolve(l, r, dsp::convolution_mode::same, method);
+		auto cref = dsp::convolve(x, y, dsp::convolution_mode::same, method);
+		ASSERT_EQ(c.size(), cref.size());
+		for (size_t i = 0; i < c.size(); ++i)
+		{
+			EXPECT_NEAR(c[i], cref[i], 1e-9);
+		}
+	}
+	EXPECT_EQ(dsp::filter::filter<double>(kernel, { 1.0 }, l), dsp::filter::filter<double>(kernel, { 1.0 }, x));
+	EXPECT_EQ(dsp::filter::filter<double>(kernel, { 1.0, -0.5 }, r), dsp::filter::filter<double>(kernel, { 1.0, -0.5 }, y));
+
+	EXPECT_DOUBLE_EQ(dsp::mean(r), dsp::mean(y));
+	EXPECT_DOUBLE_EQ(dsp::var(r), dsp::var(y));
+	EXPECT_DOUBLE_EQ(dsp::std(l, dsp::weight::population), dsp::std(x, dsp::weight::population));
+	EXPECT_DOUBLE_EQ(dsp::median(l), dsp::median(x));
+	EXPECT_EQ(dsp::zscore(r), dsp::zscore(y));
+
+	auto window = dsp::window::hann<double>(static_cast<unsigned>(l.size()));
+	auto windowed = dsp::window::apply(dsp::window::type::hann, l);
+	for (size_t i = 0; i < windowed.size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(windowed[i], x[i] * window[i]);
+	}
+	EXPECT_THROW(dsp::window::apply(l.subview(1), window), std::invalid_argument);
+}
+
+TEST_F(DspTest, MultiSignal)
+{
+	std::vector<std::vector<double>> channels{
+		dsp::signals::sin<double>(100, 0.0125, 8000).getSamples(),
+		dsp::signals::cos<double>(300, 0.0125, 8000).getSamples(),
+		dsp::signals::sin<double>(700, 0.0125, 8000).getSamples() };
+	const auto numFrames = channels[0].size();
+
+	dsp::MultiSignal<double> x(8000, channels);
+	ASSERT_EQ(x.numChannels(), 3);
+	ASSERT_EQ(x.numFrames(), numFrames);
+	EXPECT_TRUE(x.channel(1).isContiguous());
+	EXPECT_EQ(x.channel(1).toVector(), channels[1]);
+	EXPECT_EQ(x.channel(1).getSamplingRate_Hz(), 8000);
+	EXPECT_EQ(x.frame(5).toVector(), (std::vector<double>{ channels[0][5], channels[1][5], channels[2][5] }));
+
+	// Layout conversions keep every sample in place
+	x.setLayout(dsp::ChannelLayout::interleaved);
+	EXPECT_TRUE(x.frame(5).isContiguous());
+	EXPECT_DOUBLE_EQ(x.data()[3 * 7 + 2], channels[2][7]);
+	EXPECT_DOUBLE_EQ(x(2, 7), channels[2][7]);
+	EXPECT_EQ(x.channel(2).toVector(), channels[2]);
+	EXPECT_EQ(x.getChannel(0).getSamples(), channels[0]);
+	x.setLayout(dsp::ChannelLayout::planar);
+	EXPECT_EQ(x.channel(0).toVector(), channels[0]);
+	EXPECT_THROW(x.setChannel(0, std::vector<double>(3)), std::invalid_argument);
+
+	// Vectorized stereo conversions, including the scalar tail
+	for (size_t n : { 1, 7, 64, 101 })
+	{
+		std::vector<float> interleaved(2 * n);
+		std::iota(interleaved.begin(), interleaved.end(), 0.0f);
+		dsp::MultiSignal<float> stereo(48000, 2, n);
+		stereo.assign(interleaved.data(), dsp::ChannelLayout::interleaved);
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_EQ(stereo(0, i), static_cast<float>(2 * i));
+			EXPECT_EQ(stereo(1, i), static_cast<float>(2 * i + 1));
+		}
+		stereo.setLayout(dsp::ChannelLayout::interleaved);
+		EXPECT_TRUE(std::equal(interleaved.begin(), interleaved.end(), stereo.data()));
+	}
+
+	// Channel-parallel FFT, filter, and statistics match the results of the single channels
+	x.setLayout(dsp::ChannelLayout::interleaved);
+	auto spectra = dsp::fft::rfft(x, 128);
+	auto filtered = dsp::filter::filter<double>({ 0.5, 0.5 }, { 1.0, -0.2 }, x);
+	auto means = dsp::mean(x);
+	auto stds = dsp::std(x);
+	ASSERT_EQ(spectra.size(), 3);
+	EXPECT_EQ(filtered.layout(), dsp::ChannelLayout::interleaved);
+	for (unsigned c = 0; c < 3; ++c)
+	{
+		auto X = dsp::fft::rfft(channels[c], 128);
+		ASSERT_EQ(spectra[c].size(), X.size());
+		for (size_t k = 0; k < X.size(); ++k)
+		{
+			EXPECT_NEAR(std::abs(spectra[c][k] - X[k]), 0.0, 1e-9);
+		}
+		EXPECT_EQ(filtered.channel(c).toVector(), dsp::filter::filter<double>({ 0.5, 0.5 }, { 1.0, -0.2 }, channels[c]));
+		EXPECT_DOUBLE_EQ(means[c], dsp::mean(channels[c]));
+		EXPECT_DOUBLE_EQ(stds[c], dsp::std(channels[c]));
+	}
+}
+
+TEST_F(DspTest, Pcm)
+{
+	// Packed 24-bit samples keep their sign
+	EXPECT_EQ(sizeof(dsp::pcm::int24), 3);
+	for (std::int32_t v : { 0, 1, -1, 8388607, -8388608, -123456 })
+	{
+		EXPECT_EQ(static_cast<std::int32_t>(dsp::pcm::int24(v)), v);
+	}
+
+	// Vectorized conversions, including the scalar tail, match the per-sample conversion and round-trip exactly
+	for (size_t n : { 1, 7, 8, 37, 256 })
+	{
+		std::vector<dsp::pcm::int16> pcm16(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			pcm16[i] = static_cast<dsp::pcm::int16>((i * 2749) % 65536 - 32768);
+		}
+		auto xf = dsp::pcm::decode<float>(pcm16);
+		auto xd = dsp::pcm::decode<double>(pcm16);
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_EQ(xf[i], dsp::pcm::toFloat<float>(pcm16[i]));
+			EXPECT_EQ(xd[i], pcm16[i] / 32768.0);
+		}
+		EXPECT_EQ(dsp::pcm::encode<dsp::pcm::int16>(xf), pcm16);
+		EXPECT_EQ(dsp::pcm::encode<dsp::pcm::int16>(xd), pcm16);
+
+		std::vector<dsp::pcm::int32> pcm32(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			pcm32[i] = static_cast<dsp::pcm::int32>(pcm16[i]) * 65536 + static_cast<dsp::pcm::int32>(i);
+		}
+		EXPECT_EQ(dsp::pcm::encode<dsp::pcm::int32>(dsp::pcm::decode<double>(pcm32)), pcm32);
+	}
+
+	// Out-of-range samples saturate and are counted
+	std::vector<float> loud{ 0.5f, 1.0f, -1.0f, 2.0f, -3.0f, 0.0f, 0.25f, 1.5f, 0.999f };
+	std::vector<dsp::pcm::int16> pcm(loud.size());
+	EXPECT_EQ(dsp::pcm::encode(loud.data(), pcm.data(), loud.size()), 4);
+	EXPECT_EQ(pcm, (std::vector<dsp::pcm::int16>{ 16384, 32767, -32768, 32767, -32768, 0, 8192, 32767, 32735 }));
+	std::vector<dsp::pcm::int24> pcm24(loud.size());
+	EXPECT_EQ(dsp::pcm::encode(loud.data(), pcm24.data(), loud.size()), 4);
+	EXPECT_EQ(static_cast<std::int32_t>(pcm24[3]), 8388607);
+	std::vector<dsp::pcm::int32> pcm32(loud.size());
+	EXPECT_EQ(dsp::pcm::encode(loud.data(), pcm32.data(), loud.size()), 4);
+	EXPECT_EQ(pcm32, (std::vector<dsp::pcm::int32>{ 1073741824, 2147483647, -2147483647 - 1, 2147483647, -2147483647 - 1, 0, 536870912,
+		2147483647, static_cast<dsp::pcm::int32>(std::lrint(static_cast<double>(0.999f) * 2147483648.0)) }));
+
+	// Dither is reproducible for the same seed and stays within the triangular range
+	auto ramp = dsp::signals::sin<double>(440, 0.01, 48000).getSamples();
+	dsp::pcm::Dither d1(dsp::pcm::dither_type::triangular, 42), d2(dsp::pcm::dither_type::triangular, 42);
+	auto dithered = dsp::pcm::encode<dsp::pcm::int16>(ramp, &d1);
+	EXPECT_EQ(dithered, dsp::pcm::encode<dsp::pcm::int16>(ramp, &d2));
+	EXPECT_NE(dithered, dsp::pcm::encode<dsp::pcm::int16>(ramp));
+	for (size_t i = 0; i < ramp.size(); ++i)
+	{
+		EXPECT_LE(std::abs(dithered[i] - ramp[i] * 32768.0), 1.5);
+	}
+
+	// Fused conversion while loading the FFT and filter buffers matches converting first
+	auto frame = dsp::pcm::encode<dsp::pcm::int16>(ramp);
+	auto decoded = dsp::pcm::decode<float>(frame);
+	std::vector<float> fused(256), reference(256);
+	ASSERT_EQ(dsp::fft::logSquaredMagnitudeSpectrum(frame.data(), frame.size(), 512, 0.5, fused.data()), 256);
+	dsp::fft::logSquaredMagnitudeSpectrum(decoded.data(), decoded.size(), 512, 0.5, reference.data());
+	EXPECT_EQ(fused, reference);
+
+	auto sos = dsp::filter::butter<float>(4, { 1000.0f }, dsp::filter::filter_type::lowpass, 48000.0f);
+	dsp::filter::SosFilter<float> fusedFilter(sos), referenceFilter(sos);
+	std::vector<float> y(frame.size());
+	fusedFilter.process(frame.data(), y.data(), frame.size());
+	EXPECT_EQ(y, referenceFilter.process(decoded));
+
+	auto sosLong = dsp::filter::butter<long double>(4, { 1000.0L }, dsp::filter::filter_type::lowpass, 48000.0L);
+	dsp::filter::SosFilter<long double> fusedLong(sosLong), referenceLong(sosLong);
+	std::vector<long double> yLong(frame.size());
+	fusedLong.process(frame.data(), yLong.data(), frame.size());
+	EXPECT_EQ(yLong, referenceLong.process(dsp::pcm::decode<long double>(frame)));
+}
+
+TEST_F(DspTest, AudioIo)
+{
+	const auto directory = std::filesystem::temp_directory_path();
+	const auto wavPath = (directory / "dsp_io_test.wav").string();
+	const auto rf64Path = (directory / "dsp_io_test_rf64.wav").string();
+	const auto rawPath = (directory / "dsp_io_test.raw").string();
+
+	std::vector<std::vector<float>> channels{
+		dsp::signals::sin<float>(100, 0.05f, 8000).getSamples(),
+		dsp::signals::cos<float>(300, 0.05f, 8000).getSamples(),
+		dsp::signals::sin<float>(700, 0.05f, 8000).getSamples() };
+	for (auto& channel : channels)
+	{
+		for (auto& sample : channel) sample *= 0.5f;
+	}
+	const dsp::MultiSignal<float> x(8000, channels);
+	const auto numFrames = x.numFrames();
+
+	// 16-bit PCM written in odd-sized chunks from a planar signal and read back in chunks into a planar block
+	{
+		dsp::io::AudioWriter writer(wavPath, { 8000, 3, dsp::io::sample_format::pcm16 });
+		EXPECT_EQ(writer.write(x), 0);
+	}
+	{
+		dsp::io::AudioReader reader(wavPath);
+		EXPECT_EQ(reader.format().samplingRate_Hz, 8000);
+		EXPECT_EQ(reader.format().numChannels, 3);
+		EXPECT_EQ(reader.format().format, dsp::io::sample_format::pcm16);
+		ASSERT_EQ(reader.numFrames(), numFrames);
+
+		dsp::MultiSignal<float> block(8000, 3, 37);
+		size_t frame = 0;
+		while (const auto n = reader.read(block))
+		{
+			for (unsigned c = 0; c < 3; ++c)
+			{
+				for (size_t i = 0; i < n; ++i)
+				{
+					EXPECT_NEAR(block(c, i), channels[c][frame + i], 1.0 / 32768);
+				}
+			}
+			frame += n;
+		}
+		EXPECT_EQ(frame, numFrames);
+		EXPECT_EQ(block(2, 36), 0.0f);
+
+		reader.seek(10);
+		auto rest = reader.readAll<double>(dsp::ChannelLayout::interleaved);
+		ASSERT_EQ(rest.numFrames(), numFrames - 10);
+		EXPECT_NEAR(rest(1, 0), channels[1][10], 1.0 / 32768);
+	}
+
+	// 32-bit float in RF64, mapped without copying
+	{
+		dsp::io::AudioWriter writer(rf64Path, { 8000, 3, dsp::io::sample_format::float32 }, dsp::io::container::rf64);
+		auto interleaved = x;
+		interleaved.setLayout(dsp::ChannelLayout::interleaved);
+		writer.write(interleaved.data(), numFrames);
+		writer.close();
+	}
+	{
+		dsp::io::MappedAudioFile file(rf64Path);
+		ASSERT_EQ(file.numFrames(), numFrames);
+		EXPECT_EQ(file.channel<float>(1).toVector(), channels[1]);
+		EXPECT_EQ(file.channel<float>(2).getSamplingRate_Hz(), 8000);
+		EXPECT_THROW(file.channel<dsp::pcm::int16>(0), std::invalid_argument);
+		EXPECT_THROW(file.channel<float>(3), std::out_of_range);
+
+		auto moved = std::move(file);
+		EXPECT_EQ(moved.samples<float>().size(), 3 * numFrames);
+	}
+
+	// Headerless 24-bit PCM
+	{
+		dsp::io::AudioWriter writer(rawPath, { 8000, 1, dsp::io::sample_format::pcm24 }, dsp::io::container::raw);
+		writer.write(channels[0].data(), numFrames);
+	}
+	EXPECT_EQ(std::filesystem::file_size(rawPath), 3 * numFrames);
+	{
+		dsp::io::AudioReader reader(rawPath, { 8000, 1, dsp::io::sample_format::pcm24 });
+		auto y = reader.readAll<float>();
+		ASSERT_EQ(y.numFrames(), numFrames);
+		for (size_t i = 0; i < numFrames; ++i)
+		{
+			EXPECT_NEAR(y(0, i), channels[0][i], 1.0 / 8388608);
+		}
+
+		dsp::io::MappedAudioFile file(rawPath, { 8000, 1, dsp::io::sample_format::pcm24 });
+		auto pcm = file.channel<dsp::pcm::int24>(0);
+		EXPECT_EQ(dsp::pcm::toFloat<float>(pcm[5]), y(0, 5));
+	}
+
+	EXPECT_THROW(dsp::io::AudioReader{ rawPath }, std::runtime_error);
+	std::filesystem::remove(wavPath);
+	std::filesystem::remove(rf64Path);
+	std::filesystem::remove(rawPath);
+}
+
+TEST_F(DspTest, SignalMoves)
+{
+	// Counts the heap allocations of f
+	auto countAllocations = [](auto f)
+	{
+		const auto before = allocations::count.load();
+		f();
+		return allocations::count.load() - before;
+	};
+
+	// Samples are taken over instead of copied
+	std::vector<double> samples(1000, 1.0);
+	const auto* data = samples.data();
+	dsp::Signal<double> x;
+	EXPECT_EQ(countAllocations([&] { x = dsp::Signal<double>(8000, std::move(samples)); }), 0);
+	EXPECT_EQ(x.data(), data);
+	std::vector<double> other(500, 2.0);
+	data = other.data();
+	EXPECT_EQ(countAllocations([&] { x.setSamples(std::move(other)); }), 0);
+	EXPECT_EQ(x.data(), data);
+	EXPECT_EQ(countAllocations([&] { auto moved = std::move(x).getSamples(); EXPECT_EQ(moved.data(), data); }), 0);
+
+	// Library functions returning a Signal allocate only their result
+	std::vector<double> v;
+	EXPECT_EQ(countAllocations([&] { v = dsp::signals::sin<double>(100, 0.1, 8000).getSamples(); }), 1);
+	auto s = dsp::Signal<double>(8000, v);
+	EXPECT_EQ(countAllocations([&] { dsp::pad(s, { 10, 20 }); }), 1);
+	EXPECT_EQ(countAllocations([&] { dsp::zscore(s); }), 1);
+	data = s.data();
+	dsp::Signal<double> z;
+	EXPECT_EQ(countAllocations([&] { z = dsp::zscore(std::move(s)); }), 0);
+	EXPECT_EQ(z.data(), data);
+	EXPECT_EQ(z.getSamples(), dsp::zscore(v));
+	EXPECT_EQ(countAllocations([&] { dsp::filter::medianfilter(z, 5); }), countAllocations([&] { dsp::filter::medianfilter(z.getSamples(), 5); }));
+	dsp::resample::resample_poly(z, 2, 1);  // Fills the filter design cache
+	EXPECT_EQ(countAllocations([&] { dsp::resample::resample_poly(z, 2, 1); }), countAllocations([&] { dsp::resample::resample_poly(z.getSamples(), 2, 1); }));
+
+	dsp::MultiSignal<double> array(8000, 4, 256);
+	EXPECT_EQ(countAllocations([&] { array.getChannel(2); }), 1);
+}
+
+TEST_F(DspTest, Moments)
+{
+	const std::vector<double> x{ 1, 2, 3, 4, 10 };
+	const auto m = dsp::moments(x);
+	EXPECT_EQ(m.count(), 5);
+	EXPECT_DOUBLE_EQ(m.mean(), 4.0);
+	EXPECT_DOUBLE_EQ(m.var(), 12.5);
+	EXPECT_DOUBLE_EQ(m.var(dsp::weight::population), 10.0);
+	EXPECT_NEAR(m.skewness(), 1.1384199576606167, 1e-12);
+	EXPECT_NEAR(m.kurtosis(), -0.212, 1e-12);
+
+	// Welford updates, chunked, and parallel computation agree, also far away from zero
+	std::mt19937 generator(7);
+	std::normal_distribution<double> distribution(1e6, 2.0);
+	for (size_t n : { 10, 5000, 200001 })
+	{
+		std::vector<double> y(n);
+		std::generate(y.begin(), y.end(), [&] { return distribution(generator); });
+		const auto mu = std::accumulate(y.begin(), y.end(), 0.0) / n;
+		double m2 = 0, m3 = 0, m4 = 0;
+		for (auto v : y)
+		{
+			m2 += (v - mu) * (v - mu);
+			m3 += (v - mu) * (v - mu) * (v - mu);
+			m4 += (v - mu) * (v - mu) * (v - mu) * (v - mu);
+		}
+
+		dsp::Moments<double> welford;
+		for (auto v : y) welford.push(v);
+		const auto chunked = dsp::moments(y);
+		for (const auto& result : { welford, chunked })
+		{
+			EXPECT_NEAR(result.mean(), mu, 1e-7);
+			EXPECT_NEAR(result.var(), m2 / (n - 1), 1e-9 * m2 / n);
+			EXPECT_NEAR(result.skewness(), std::sqrt(n) * m3 / std::pow(m2, 1.5), 1e-6);
+			EXPECT_NEAR(result.kurtosis(), n * m4 / (m2 * m2) - 3, 1e-6);
+		}
+		EXPECT_NEAR(dsp::std(y), std::sqrt(m2 / (n - 1)), 1e-9);
+
+		const auto z = dsp::zscore(y);
+		EXPECT_NEAR(dsp::mean(z), 0.0, 1e-9);
+		EXPECT_NEAR(dsp::std(z), 1.0, 1e-9);
+	}
+
+	// Merging partial results equals processing everything at once
+	dsp::Moments<float, 2> a, b;
+	for (int i = 0; i < 10; ++i) a.push(static_cast<float>(i));
+	for (int i = 10; i < 25; ++i) b.push(static_cast<float>(i));
+	a.merge(b);
+	EXPECT_EQ(a.count(), 25);
+	EXPECT_FLOAT_EQ(a.mean(), 12.0f);
+	EXPECT_FLOAT_EQ(a.var(), 54.166668f);
+
+	// The variance is undefined without enough samples
+	dsp::Moments<double> few;
+	EXPECT_TRUE(std::isnan(few.var(dsp::weight::population)));
+	few.push(3.0);
+	EXPECT_TRUE(std::isnan(few.var()));
+	EXPECT_TRUE(std::isnan(few.std()));
+	EXPECT_EQ(few.var(dsp::weight::population), 0.0);
+}
+
+TEST_F(DspTest, StreamingStats)
+{
+	std::mt19937 generator(3);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<double> x(10000);
+	std::generate(x.begin(), x.end(), [&] { return 1000.0 + distribution(generator); });
+
+	// Accumulators of separate parts merge into the statistics of the whole
+	dsp::stats::Accumulator<double> all, first, second;
+	all.push(x.begin(), x.end());
+	first.push(x.begin(), x.begin() + 3000);
+	second.push(x.begin() + 3000, x.end());
+	first.merge(second);
+	for (const auto& acc : { all, first })
+	{
+		EXPECT_EQ(acc.count(), x.size());
+		EXPECT_NEAR(acc.mean(), dsp::mean(x), 1e-9);
+		EXPECT_NEAR(acc.var(), dsp::var(x), 1e-9);
+		EXPECT_EQ(acc.min(), *std::min_element(x.begin(), x.end()));
+		EXPECT_EQ(acc.max(), *std::max_element(x.begin(), x.end()));
+		EXPECT_NEAR(acc.rms(), std::sqrt(std::inner_product(x.begin(), x.end(), x.begin(), 0.0) / x.size()), 1e-9);
+	}
+
+	// Compensated sums do not drift over many small increments
+	dsp::stats::Accumulator<float> tiny;
+	for (int i = 0; i < 1000000; ++i) tiny.push(0.1f);
+	EXPECT_NEAR(tiny.sum(), 100000.0f, 0.01f);
+
+	// Sliding windows match the statistics of the window contents, also after many updates
+	const size_t length = 64;
+	dsp::stats::SlidingWindowStats<double> window(length);
+	EXPECT_THROW(window.pop(), std::logic_error);
+	EXPECT_THROW(window.min(), std::logic_error);
+	EXPECT_THROW(window.max(), std::logic_error);
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		window.push(x[i]);
+		if (i % 997 == 0 || i == x.size() - 1)
+		{
+			const auto begin = x.begin() + (i + 1 >= length ? i + 1 - length : 0);
+			const auto end = x.begin() + i + 1;
+			ASSERT_EQ(window.size(), static_cast<size_t>(end - begin));
+			EXPECT_NEAR(window.mean(), dsp::mean<double>(begin, end), 1e-9);
+			if (window.size() > 1)
+			{
+				EXPECT_NEAR(window.var(), dsp::var<double>(begin, end), 1e-9);
+			}
+			EXPECT_EQ(window.min(), *std::min_element(begin, end));
+			EXPECT_EQ(window.max(), *std::max_element(begin, end));
+			EXPECT_NEAR(window.energy(), std::inner_product(begin, end, begin, 0.0), 1e-6);
+		}
+	}
+	EXPECT_TRUE(window.full());
+
+	// Explicit pops shrink the window from the oldest sample
+	window.pop();
+	window.pop();
+	EXPECT_EQ(window.size(), length - 2);
+	EXPECT_NEAR(window.mean(), dsp::mean<double>(x.end() - length + 2, x.end()), 1e-9);
+	EXPECT_EQ(window.max(), *std::max_element(x.end() - length + 2, x.end()));
+
+	// Reset empties the window, so that stale extrema are not returned
+	window.reset();
+	EXPECT_THROW(window.min(), std::logic_error);
+	window.push(-1.0);
+	EXPECT_EQ(window.min(), -1.0);
+	EXPECT_EQ(window.max(), -1.0);
+}
+
+TEST_F(DspTest, Quantiles)
+{
+	// Short ranges
+	EXPECT_EQ(dsp::median(std::vector<double>{ 4.0 }), 4.0);
+	EXPECT_EQ(dsp::median(std::vector<double>{ 4.0, 1.0 }), 2.5);
+	EXPECT_THROW(dsp::median(std::vector<double>{}), std::invalid_argument);
+
+	// Linear interpolation between the closest ranks, as numpy.quantile()
+	const std::vector<double> x{ 7, 1, 9, 3, 5, 2, 8 };
+	EXPECT_DOUBLE_EQ(dsp::quantile(x, 0.0), 1.0);
+	EXPECT_DOUBLE_EQ(dsp::quantile(x, 1.0), 9.0);
+	EXPECT_DOUBLE_EQ(dsp::quantile(x, 0.5), 5.0);
+	EXPECT_DOUBLE_EQ(dsp::quantile(x, 0.25), 2.5);
+	EXPECT_DOUBLE_EQ(dsp::percentile(x, 90), 8.4);
+	EXPECT_EQ(dsp::quantiles(x, { 0.9, 0.25, 0.5 }), (std::vector<double>{ dsp::percentile(x, 90), 2.5, 5.0 }));
+	EXPECT_THROW(dsp::quantile(x, 1.5), std::invalid_argument);
+
+	// Many quantiles from one partitioning match a full sort, also for views of strided samples
+	std::mt19937 generator(11);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::vector<float> y(100001);
+	std::generate(y.begin(), y.end(), [&] { return distribution(generator); });
+	auto sorted = y;
+	std::sort(sorted.begin(), sorted.end());
+	std::vector<double> q;
+	for (int i = 0; i <= 100; ++i) q.push_back(i / 100.0);
+	const auto result = dsp::quantiles(y, q);
+	for (size_t i = 0; i < q.size(); ++i)
+	{
+		EXPECT_EQ(result[i], sorted[i * 1000]);
+	}
+	EXPECT_EQ(dsp::median(y), sorted[50000]);
+
+	dsp::SignalView<float> odd(y.data() + 1, 50000, 2);
+	auto oddSorted = odd.toVector();
+	std::sort(oddSorted.begin(), oddSorted.end());
+	EXPECT_FLOAT_EQ(dsp::median(odd), (oddSorted[24999] + oddSorted[25000]) / 2);
+
+	// Partitions on a pool of several threads select the same samples, also with few distinct values
+	dsp::ThreadPool pool(4);
+	auto parallel = dsp::ExecutionContext::parallel(1 << 12);
+	parallel.pool = &pool;
+	std::vector<float> large(1 << 18);
+	std::generate(large.begin(), large.end(), [&] { return distribution(generator); });
+	auto largeSorted = large;
+	std::sort(largeSorted.begin(), largeSorted.end());
+	const auto largeQuantiles = dsp::quantiles(large, q, parallel);
+	EXPECT_EQ(largeQuantiles, dsp::quantiles(large, q));
+	EXPECT_EQ(largeQuantiles.front(), largeSorted.front());
+	EXPECT_EQ(largeQuantiles.back(), largeSorted.back());
+	EXPECT_EQ(dsp::median(large, parallel), (largeSorted[large.size() / 2 - 1] + largeSorted[large.size() / 2]) / 2);
+	std::vector<int> steps(large.size());
+	for (size_t i = 0; i < steps.size(); ++i) steps[i] = static_cast<int>((i * 7919) % 5);
+	EXPECT_EQ(dsp::quantiles(steps, q, parallel), dsp::quantiles(steps, q));
+	EXPECT_EQ(dsp::median(std::vector<double>(large.size(), 3.0), parallel), 3.0);
+}
+
+TEST_F(DspTest, QuantileSketches)
+{
+	std::mt19937 generator(5);
+	std::exponential_distribution<double> distribution(1.0);
+	std::vector<double> x(200000);
+	std::generate(x.begin(), x.end(), [&] { return distribution(generator); });
+	const std::vector<double> q{ 0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999 };
+	const auto exact = dsp::quantiles(x, q);
+
+	// The error in rank is small, and smallest at the tails
+	auto rankError = [&](double value, double quantile)
+	{
+		const auto rank = std::count_if(x.begin(), x.end(), [&](double v) { return v < value; });
+		return std::abs(static_cast<double>(rank) / x.size() - quantile);
+	};
+	dsp::stats::TDigest<double> digest;
+	digest.push(x.begin(), x.end());
+	EXPECT_EQ(digest.count(), x.size());
+	EXPECT_LE(digest.size(), 100u);
+	EXPECT_EQ(digest.quantile(0.0), *std::min_element(x.begin(), x.end()));
+	EXPECT_EQ(digest.quantile(1.0), *std::max_element(x.begin(), x.end()));
+	for (size_t i = 0; i < q.size(); ++i)
+	{
+		EXPECT_LT(rankError(digest.quantile(q[i]), q[i]), std::max(1e-3, 0.02 * q[i] * (1 - q[i]))) << q[i];
+	}
+
+	// Digests of parts of the stream, e.g., one per thread, merge into a digest of the whole stream
+	const auto half = x.begin() + x.size() / 2;
+	dsp::stats::TDigest<double> first, second;
+	first.push(x.begin(), half);
+	second.push(half, x.end());
+	first.merge(second);
+	EXPECT_EQ(first.count(), x.size());
+	for (size_t i = 0; i < q.size(); ++i)
+	{
+		EXPECT_LT(rankError(first.quantile(q[i]), q[i]), std::max(1e-3, 0.02 * q[i] * (1 - q[i]))) << q[i];
+	}
+
+	// Merging a digest into itself doubles the weights but keeps the quantiles
+	dsp::stats::TDigest<double> doubled = digest;
+	doubled.merge(doubled);
+	EXPECT_EQ(doubled.count(), 2.0 * x.size());
+	EXPECT_EQ(doubled.quantile(0.0), digest.quantile(0.0));
+	EXPECT_EQ(doubled.quantile(1.0), digest.quantile(1.0));
+	for (size_t i = 0; i < q.size(); ++i)
+	{
+		EXPECT_LT(rankError(doubled.quantile(q[i]), q[i]), std::max(1e-3, 0.02 * q[i] * (1 - q[i]))) << q[i];
+	}
+
+	// Serialization restores the same quantiles and rejects invalid data
+	const auto bytes = digest.serialize();
+	const auto restored = dsp::stats::TDigest<double>::deserialize(bytes);
+	EXPECT_EQ(restored.count(), digest.count());
+	for (const auto p : q)
+	{
+		EXPECT_EQ(restored.quantile(p), digest.quantile(p));
+	}
+	EXPECT_THROW(dsp::stats::TDigest<float>::deserialize(bytes), std::invalid_argument);
+	EXPECT_THROW(dsp::stats::TDigest<double>::deserialize(std::vector<char>(bytes.begin(), bytes.end() - 1)), std::invalid_argument);
+	auto corrupted = dsp::stats::TDigest<double>().serialize();
+	const std::uint64_t wrapping = std::uint64_t(1) << 60;  // 2^60 centroids of 16 bytes wrap around to 0 bytes
+	std::memcpy(corrupted.data() + corrupted.size() - sizeof(wrapping), &wrapping, sizeof(wrapping));
+	EXPECT_THROW(dsp::stats::TDigest<double>::deserialize(corrupted), std::invalid_argument);
+	EXPECT_THROW(dsp::stats::TDigest<double>().quantile(0.5), std::logic_error);
+
+	// P² tracks a single quantile with five markers
+	dsp::stats::P2Quantile<double> p95(0.95);
+	EXPECT_THROW(p95.value(), std::logic_error);
+	p95.push(x.begin(), x.begin() + 3);
+	EXPECT_DOUBLE_EQ(p95.value(), dsp::quantile(std::vector<double>(x.begin(), x.begin() + 3), 0.95));
+	p95.push(x.begin() + 3, x.end());
+	EXPECT_NEAR(p95.value(), dsp::quantile(x, 0.95), 0.01 * dsp::quantile(x, 0.95));
+	dsp::stats::P2Quantile<double> p50(0.5);
+	p50.push(x.begin(), x.end());
+	EXPECT_NEAR(p50.value(), exact[3], 0.01 * exact[3]);
+}
+
+TEST_F(DspTest, CountingMethods)
+{
+	// All methods agree, return the unique values in the order of their first occurrence, and break ties in the mode by value
+	const std::vector<int> v{ 3, 4, 2, 2, 1, 7, 4 };
+	for (const auto method : { dsp::counting_method::automatic, dsp::counting_method::histogram, dsp::counting_method::sort, dsp::counting_method::hash })
+	{
+		EXPECT_EQ(dsp::unique(v, method), (std::vector<int>{ 3, 4, 2, 1, 7 }));
+		EXPECT_EQ(dsp::mode(v, method), 2);
+	}
+	EXPECT_THROW(dsp::mode(std::vector<int>{}), std::invalid_argument);
+	EXPECT_TRUE(dsp::unique(std::vector<int>{}).empty());
+
+	// Quantized PCM samples are histogrammed; wide integer ranges and floating-point samples are hashed
+	std::mt19937 generator(3);
+	std::normal_distribution<double> distribution(0.0, 1000.0);
+	std::vector<dsp::pcm::int16> pcm(100000);
+	std::generate(pcm.begin(), pcm.end(), [&] { return static_cast<dsp::pcm::int16>(std::lround(distribution(generator))); });
+	std::vector<float> samples(pcm.size());
+	dsp::pcm::decode(pcm.data(), samples.data(), pcm.size());
+	std::vector<long long> wide(pcm.begin(), pcm.end());
+	for (auto& x : wide) x *= 1000000007LL;
+
+	const auto expectedUnique = dsp::unique(pcm, dsp::counting_method::sort);
+	const auto expectedMode = dsp::mode(pcm, dsp::counting_method::sort);
+	EXPECT_EQ(dsp::unique(pcm), expectedUnique);
+	EXPECT_EQ(dsp::mode(pcm), expectedMode);
+	EXPECT_EQ(dsp::unique(wide).size(), expectedUnique.size());
+	EXPECT_EQ(dsp::mode(wide), expectedMode * 1000000007LL);
+	EXPECT_EQ(dsp::unique(samples).size(), expectedUnique.size());
+	EXPECT_EQ(dsp::mode(samples), dsp::pcm::toFloat<float>(expectedMode));
+	EXPECT_EQ(dsp::unique(samples, dsp::counting_method::sort), dsp::unique(samples, dsp::counting_method::hash));
+	EXPECT_THROW(dsp::mode(samples, dsp::counting_method::histogram), std::invalid_argument);
+	EXPECT_EQ(dsp::unique(std::vector<double>{ 0.0, -0.0, 1.0 }).size(), 2u);
+}
+
+TEST_F(DspTest, ExecutionContexts)
+{
+	std::mt19937 generator(17);
+	std::normal_distribution<double> distribution(0.5, 2.0);
+	std::vector<double> x(1 << 20);
+	std::generate(x.begin(), x.end(), [&] { return distribution(generator); });
+	const auto sequential = dsp::ExecutionContext::sequential();
+	const auto parallel = dsp::ExecutionContext::parallel(10000);
+	EXPECT_FALSE(sequential.runsInParallel(x.size()));
+	EXPECT_TRUE(parallel.runsInParallel(x.size()));
+	EXPECT_FALSE(parallel.runsInParallel(10000));
+	EXPECT_FALSE(dsp::ExecutionContext().runsInParallel(x.size()));
+	EXPECT_FALSE(dsp::ExecutionContext::automatic().runsInParallel(1000));
+	EXPECT_TRUE(dsp::ExecutionContext::automatic().runsInParallel(x.size()));
+
+	// Parallel reductions add the chunk sums in order, so they match a sequential sum over the same chunks on every run
+	double chunked = 0.0;
+	for (size_t lo = 0; lo < x.size(); lo += parallel.grainSize)
+	{
+		chunked += std::accumulate(x.begin() + lo, x.begin() + std::min(x.size(), lo + parallel.grainSize), 0.0);
+	}
+	const auto parallelMean = dsp::mean(x, parallel);
+	EXPECT_EQ(parallelMean, chunked / x.size());
+	EXPECT_NEAR(parallelMean, dsp::mean(x, sequential), 1e-12);
+	for (int run = 0; run < 3; ++run)
+	{
+		EXPECT_EQ(dsp::mean(x, parallel), parallelMean);
+	}
+
+	auto y = x;
+	EXPECT_NEAR(dsp::calculateEnergy<double>(y.begin(), y.end(), parallel), dsp::calculateEnergy<double>(y.begin(), y.end(), sequential), 1e-9 * y.size());
+	EXPECT_NEAR(dsp::calculateMeanPower<double>(y.begin(), y.end(), parallel), 4.25, 0.05);
+	EXPECT_EQ(dsp::var(x, dsp::weight::sample, parallel), dsp::var(x, dsp::weight::sample, sequential));
+
+	// Elementwise functions give the same samples in any context
+	const dsp::Signal<double> s(48000, x);
+	EXPECT_EQ(dsp::abs(s, parallel), dsp::abs(s, sequential));
+	EXPECT_EQ(dsp::pow(x, 2, parallel), dsp::pow(x, 2, sequential));
+	std::vector<std::complex<double>> z(x.size());
+	std::transform(x.begin(), x.end(), x.rbegin(), z.begin(), [](double re, double im) { return std::complex<double>(re, im); });
+	const dsp::Signal<std::complex<double>> zs(48000, z);
+	EXPECT_EQ(dsp::real(z, parallel), x);
+	EXPECT_EQ(dsp::imag(zs, parallel).getSamples(), std::vector<double>(x.rbegin(), x.rend()));
+	EXPECT_EQ(dsp::norm(zs, parallel), dsp::norm(zs, sequential));
+	EXPECT_EQ(dsp::real(zs, parallel).getSamplingRate_Hz(), 48000u);
+}
+
+TEST_F(DspTest, ThreadPool)
+{
+	dsp::ThreadPool pool(4);
+	EXPECT_EQ(pool.numThreads(), 4u);
+	EXPECT_FALSE(dsp::ThreadPool::inParallelRegion());
+
+	// Every index is visited exactly once
+	std::vector<std::atomic<int>> visits(10000);
+	pool.parallelFor(visits.size(), [&](size_t i) { ++visits[i]; });
+	EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v == 1; }));
+
+	// Nested loops run on the calling thread instead of waiting for busy workers
+	std::atomic<int> nestedSequential{ 0 };
+	pool.parallelFor(16, [&](size_t)
+		{
+			EXPECT_TRUE(dsp::ThreadPool::inParallelRegion());
+			const auto id = std::this_thread::get_id();
+			pool.parallelFor(8, [&](size_t) { nestedSequential += std::this_thread::get_id() == id; });
+		});
+	EXPECT_EQ(nestedSequential, 16 * 8);
+
+	// Exceptions are rethrown on the calling thread after the loop
+	EXPECT_THROW(pool.parallelFor(100, [](size_t i) { if (i == 42) throw std::runtime_error("Failed!"); }), std::runtime_error);
+	EXPECT_EQ(pool.submit([] { return 6 * 7; }).get(), 42);
+
+	// Pinned pools and the pool of an ExecutionContext give the same results as the global pool
+	dsp::ThreadPool pinned(2, { 0 });
+	std::vector<float> x(1 << 18);
+	std::iota(x.begin(), x.end(), 0.0f);
+	auto context = dsp::ExecutionContext::parallel(1000);
+	const auto expected = dsp::mean(x, context);
+	context.pool = &pinned;
+	EXPECT_EQ(dsp::mean(x, context), expected);
+	context.pool = &pool;
+	EXPECT_EQ(dsp::mean(x, context), expected);
+
+	// Channels of a MultiSignal are processed on the given pool
+	dsp::MultiSignal<float> channels(48000, 3, 1000);
+	const auto inParallel = channels.mapChannels([](dsp::SignalView<float>) { return static_cast<int>(dsp::ThreadPool::inParallelRegion()); }, pinned);
+	EXPECT_EQ(inParallel, std::vector<int>(3, 1));
+}
+
+TEST_F(DspTest, ReproducibleReductions)
+{
+	std::mt19937 generator(23);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::vector<float> x(3000001);
+	std::generate(x.begin(), x.end(), [&] { return distribution(generator); });
+
+	// Sequential and parallel runs with any chunk size and any number of threads agree to the last bit
+	dsp::ThreadPool twoThreads(2);
+	std::vector<dsp::ExecutionContext> contexts{ dsp::ExecutionContext::sequential(), dsp::ExecutionContext::parallel(),
+		dsp::ExecutionContext::parallel(100000), dsp::ExecutionContext::parallel(5000) };
+	contexts.back().pool = &twoThreads;
+	for (auto& context : contexts)
+	{
+		context.reproducible = true;
+	}
+
+	const auto expectedMean = dsp::mean(x, contexts[0]);
+	const auto expectedEnergy = dsp::calculateEnergy<float>(x.begin(), x.end(), contexts[0]);
+	const auto expectedVar = dsp::var(x, dsp::weight::sample, contexts[0]);
+	for (const auto& context : contexts)
+	{
+		EXPECT_EQ(dsp::mean(x, context), expectedMean);
+		EXPECT_EQ(dsp::calculateEnergy<float>(x.begin(), x.end(), context), expectedEnergy);
+		EXPECT_EQ(dsp::calculateMeanPower<float>(x.begin(), x.end(), context), expectedEnergy / x.size());
+		EXPECT_EQ(dsp::var(x, dsp::weight::sample, context), expectedVar);
+	}
+
+	// The pairwise tree of block sums is also more accurate than a running sum
+	const auto exactEnergy = std::accumulate(x.begin(), x.end(), 0.0, [](double sum, float v) { return sum + double(v) * v; });
+	EXPECT_LT(std::abs(expectedEnergy - exactEnergy), std::abs(dsp::calculateEnergy<float>(x.begin(), x.end(), dsp::ExecutionContext::sequential()) - exactEnergy));
+	EXPECT_NEAR(expectedEnergy, exactEnergy, 1e-5 * exactEnergy);
+
+	// Direct convolutions accumulate every output sample in the same order in any context
+	const std::vector<float> kernel(x.begin(), x.begin() + 257);
+	const std::vector<float> signal(x.begin(), x.begin() + 200000);
+	const auto expected = dsp::convolve(signal, kernel, dsp::convolution_mode::full, dsp::convolution_method::direct, dsp::ExecutionContext::sequential());
+	for (const auto& context : contexts)
+	{
+		EXPECT_EQ(dsp::convolve(signal, kernel, dsp::convolution_mode::full, dsp::convolution_method::direct, context), expected);
+	}
+}
+
+TEST_F(DspTest, SummationMethods)
+{
+	using dsp::kernels::summation_method;
+	std::mt19937 generator(29);
+	std::uniform_real_distribution<float> distribution(0.5f, 1.5f);
+	std::vector<float> x(10000003);
+	std::generate(x.begin(), x.end(), [&] { return distribution(generator); });
+	const auto exactSum = std::accumulate(x.begin(), x.end(), 0.0L, [](long double sum, float v) { return sum + v; });
+	const auto exactEnergy = std::accumulate(x.begin(), x.end(), 0.0L, [](long double sum, float v) { return sum + static_cast<long double>(v) * v; });
+	const auto relativeError = [](long double value, long double exact) { return std::abs(value - exact) / exact; };
+
+	// Running float sums lose digits over ten million samples, the other methods do not
+	const auto sequential = dsp::ExecutionContext::sequential();
+	const auto naiveError = relativeError(dsp::calculateEnergy<float>(x.begin(), x.end(), summation_method::naive, sequential), exactEnergy);
+	for (const auto method : { summation_method::pairwise, summation_method::kahan, summation_method::widened })
+	{
+		const auto error = relativeError(dsp::calculateEnergy<float>(x.begin(), x.end(), method, sequential), exactEnergy);
+		EXPECT_LT(error, 1e-6);
+		EXPECT_LT(error, naiveError);
+		EXPECT_LT(relativeError(dsp::kernels::sumOfSquares(x.data(), x.size(), method), exactEnergy), 1e-6);
+		EXPECT_LT(relativeError(dsp::kernels::sum(x.data(), x.size(), method), exactSum), 1e-6);
+		EXPECT_NEAR(dsp::mean(x, method), exactSum / x.size(), 1e-6);
+		EXPECT_NEAR(dsp::calculateMeanPower<float>(x.begin(), x.end(), method), exactEnergy / x.size(), 1e-6);
+	}
+
+	// Widened float sums are accumulated in double
+	EXPECT_LT(relativeError(dsp::kernels::sumOfSquares(x.data(), x.size(), summation_method::widened), exactEnergy), 1e-12);
+
+	// Short and empty ranges, and double samples
+	EXPECT_EQ(dsp::kernels::sum(x.data(), 0, summation_method::kahan), 0.0);
+	EXPECT_FLOAT_EQ(dsp::kernels::sum(x.data(), 3, summation_method::pairwise), x[0] + x[1] + x[2]);
+	std::vector<double> y(1000, 1e-16);
+	y[0] = 1.0;
+	EXPECT_DOUBLE_EQ(dsp::kernels::sum(y.data(), y.size(), summation_method::kahan), 1.0 + 999e-16);
+	EXPECT_LT(dsp::kernels::sum(y.data(), y.size(), summation_method::naive), 1.0 + 998e-16);
+
+	// The methods combine with parallel and reproducible execution
+	auto reproducible = dsp::ExecutionContext::parallel(100000);
+	reproducible.reproducible = true;
+	auto reproducibleSequential = sequential;
+	reproducibleSequential.reproducible = true;
+	EXPECT_EQ(dsp::mean(x, summation_method::kahan, reproducible), dsp::mean(x, summation_method::kahan, reproducibleSequential));
+	EXPECT_NEAR(dsp::calculateEnergy<float>(x.begin(), x.end(), summation_method::pairwise, dsp::ExecutionContext::parallel()), exactEnergy, 1e-6 * exactEnergy);
+	const dsp::SignalView<float> odd(x.data() + 1, x.size() / 2, 2);
+	EXPECT_NEAR(dsp::mean(odd, summation_method::pairwise), dsp::mean<float>(odd.begin(), odd.end(), dsp::ExecutionContext::parallel()), 1e-5);
+}
+
+TEST_F(DspTest, GenericRanges)
+{
+	using dsp::kernels::summation_method;
+	std::vector<double> samples(1001);
+	std::iota(samples.begin(), samples.end(), -500.0);
+	const auto& x = samples;
+	const auto expected = std::inner_product(x.begin(), x.end(), x.begin(), 0.0);
+	ASSERT_EQ(expected, 2.0 * 500 * 501 * 1001 / 6);
+
+	// Const iterators, pointers, const signals, and views are accepted without copying
+	const dsp::Signal<double> signal(48000, samples);
+	const dsp::AlignedSignal<double> aligned(48000, samples);
+	const dsp::SignalView<double> view(signal);
+	EXPECT_EQ(dsp::calculateEnergy<double>(x.begin(), x.end()), expected);
+	EXPECT_EQ(dsp::calculateEnergy<double>(x.cbegin(), x.cend()), expected);
+	EXPECT_EQ(dsp::calculateEnergy<double>(x.data(), x.data() + x.size()), expected);
+	EXPECT_EQ(dsp::calculateEnergy<double>(signal.begin(), signal.end()), expected);
+	EXPECT_EQ(dsp::calculateEnergy<double>(view.begin(), view.end()), expected);
+	EXPECT_EQ(dsp::calculateEnergy(x), expected);
+	EXPECT_EQ(dsp::calculateEnergy(signal), expected);
+	EXPECT_EQ(dsp::calculateEnergy(aligned), expected);
+	EXPECT_EQ(dsp::calculateEnergy(view), expected);
+	EXPECT_EQ(dsp::calculateEnergy(view, summation_method::kahan, dsp::ExecutionContext::parallel(100)), expected);
+	EXPECT_EQ(dsp::calculateMeanPower(signal), expected / x.size());
+	EXPECT_EQ(dsp::calculateMeanPower<double>(x.cbegin(), x.cend(), summation_method::pairwise), expected / x.size());
+
+	// The iterators of signals with the allocators of the library are contiguous too, so the summation methods do not copy them
+	const dsp::PoolSignal<double> pooled(48000, samples);
+	const auto allocationsBefore = allocations::count.load();
+	EXPECT_EQ(dsp::calculateEnergy<double>(aligned.begin(), aligned.end(), summation_method::pairwise), expected);
+	EXPECT_EQ(dsp::calculateEnergy<double>(pooled.begin(), pooled.end(), summation_method::kahan), expected);
+	EXPECT_EQ(allocations::count.load(), allocationsBefore);
+
+	// Strided views, lists, and arrays take the element-wise path
+	const dsp::SignalView<double> even(x.data(), 501, 2);
+	double expectedEven = 0;
+	for (size_t i = 0; i < x.size(); i += 2)
+	{
+		expectedEven += x[i] * x[i];
+	}
+	EXPECT_EQ(dsp::calculateEnergy(even), expectedEven);
+	EXPECT_EQ(dsp::calculateEnergy(even, summation_method::pairwise), expectedEven);
+	EXPECT_EQ(dsp::calculateEnergy(even, dsp::ExecutionContext::parallel(64)), expectedEven);
+	const std::list<double> list(x.begin(), x.end());
+	EXPECT_EQ(dsp::calculateEnergy(list), expected);
+	EXPECT_EQ(dsp::calculateMeanPower<double>(list.begin(), list.end()), expected / x.size());
+	const std::array<float, 4> array{ 1.0f, -2.0f, 3.0f, -4.0f };
+	EXPECT_EQ(dsp::calculateEnergy(array), 30.0f);
+	EXPECT_EQ(dsp::calculateEnergy<float>(std::begin(array), std::end(array)), 30.0f);
+	const std::vector<int> integers{ 1, 2, 3 };
+	EXPECT_EQ(dsp::calculateEnergy(integers), 14);
+
+	// Empty ranges
+	const std::vector<double> empty;
+	EXPECT_EQ(dsp::calculateEnergy(empty), 0.0);
+	EXPECT_EQ(dsp::calculateEnergy(empty, summation_method::kahan), 0.0);
+
+	// mean() with a summation method reads contiguous views in place
+	EXPECT_EQ(dsp::mean(view, summation_method::kahan), 0.0);
+	EXPECT_EQ(dsp::mean(even, summation_method::kahan), 0.0);
+
+	// The other utilities take views, e.g., of every other sample, and match their vector versions
+	const auto evenSamples = even.toVector();
+	const std::vector<double> kernel{ 0.5, -1.0, 2.0 };
+	EXPECT_EQ(dsp::centered(even, 101), dsp::centered(evenSamples, 101));
+	EXPECT_EQ(dsp::correlate(even, dsp::SignalView<double>(kernel), dsp::correlation_mode::same, dsp::correlation_method::direct),
+		dsp::correlate(evenSamples, kernel, dsp::correlation_mode::same, dsp::correlation_method::direct));
+	EXPECT_EQ(dsp::autocorrelate(even.subview(0, 20)), dsp::autocorrelate(std::vector<double>(evenSamples.begin(), evenSamples.begin() + 20)));
+	EXPECT_EQ(dsp::signalToFrames(even, 64, 16), dsp::signalToFrames(evenSamples, 64, 16));
+	const auto positive = [](double v) { return v > 0.0; };
+	EXPECT_EQ(dsp::extract(positive, even), dsp::extract(positive, evenSamples));
+	EXPECT_EQ(dsp::pad(even, { 2, 3 }, { 1.0, -1.0 }), dsp::pad(evenSamples, { 2, 3 }, { 1.0, -1.0 }));
+}
+
 TEST_F(DspTest, UnitConversions)
 {
 	auto f = 880.0;
@@ -545,6 +2062,77 @@ TEST_F(DspTest, Benchmarking)
 		outFile << "magspec\tdsp\t" << duration_dsp.count() << std::endl;
 	}
 
+	std::cout << "*********************************************************" << std::endl;
+	std::cout << "********   a * b + c * d - e (temporaries)     ***********" << std::endl;
+	std::cout << "*********************************************************" << std::endl;
+	auto b = dsp::signals::cos<double>(100, 1, 48000);
+	auto c = dsp::signals::sin<double>(300, 1, 48000);
+	auto d = dsp::signals::cos<double>(300, 1, 48000);
+	auto e = dsp::signals::sin<double>(700, 1, 48000);
+	dsp::Signal<double> y(48000, std::vector<double>(x.size()));
+	for (int j = 0; j < 100; ++j)
+	{
+		// Eager operators: every intermediate result is a full-length signal
+		auto count = allocations::count.load();
+		auto bytes = allocations::bytes.load();
+		auto start = std::chrono::high_resolution_clock::now();
+		y = x * b + c * d - e;
+		auto stop = std::chrono::high_resolution_clock::now();
+
+		auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+		std::cout << "Eager operators: " << "		" << duration.count() << " µs, " << allocations::count.load() - count
+			<< " allocations, " << allocations::bytes.load() - bytes << " bytes" << std::endl;
+		outFile << "expression	eager	" << duration.count() << std::endl;
+
+		// Expression templates: one fused loop into the existing storage
+		count = allocations::count.load();
+		bytes = allocations::bytes.load();
+		auto start_dsp = std::chrono::high_resolution_clock::now();
+		y = dsp::expr::lazy(x) * b + dsp::expr::lazy(c) * d - e;
+		auto stop_dsp = std::chrono::high_resolution_clock::now();
+
+		auto duration_dsp = std::chrono::duration_cast<std::chrono::microseconds>(stop_dsp - start_dsp);
+		std::cout << "Expression templates: " << "		" << duration_dsp.count() << " µs, " << allocations::count.load() - count
+			<< " allocations, " << allocations::bytes.load() - bytes << " bytes" << std::endl;
+		outFile << "expression	lazy	" << duration_dsp.count() << std::endl;
+	}
+
+	std::cout << "*********************************************************" << std::endl;
+	std::cout << "********   compound assignment (+=, *=)       ***********" << std::endl;
+	std::cout << "*********************************************************" << std::endl;
+	std::cout << "Instruction set: " << dsp::kernels::instructionSet() << std::endl;
+	for (int j = 0; j < 100; ++j)
+	{
+		// Previous implementation: bounds-checked at() per sample
+		auto start = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < y.size(); ++i)
+		{
+			y.at(i) += b[i];
+		}
+		for (size_t i = 0; i < y.size(); ++i)
+		{
+			y.at(i) *= c[i];
+		}
+		auto stop = std::chrono::high_resolution_clock::now();
+
+		auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+		std::cout << "at() and operator[]: " << "\t\t" << duration.count() << " µs" << std::endl;
+		outFile << "compound\tnaive\t" << duration.count() << std::endl;
+
+		// DSP lib implementation
+		auto start_dsp = std::chrono::high_resolution_clock::now();
+		y += b;
+		y *= c;
+		auto stop_dsp = std::chrono::high_resolution_clock::now();
+
+		auto duration_dsp = std::chrono::duration_cast<std::chrono::microseconds>(stop_dsp - start_dsp);
+		std::cout << "Modern DSP implementation: " << "\t" << duration_dsp.count() << " µs" << std::endl;
+		outFile << "compound\tdsp\t" << duration_dsp.count() << std::endl;
+
+		// Keep the values bounded over the repetitions
+		y = x;
+	}
+
 }
 
 